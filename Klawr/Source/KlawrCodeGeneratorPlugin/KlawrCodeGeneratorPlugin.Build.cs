@@ -34,7 +34,8 @@ namespace UnrealBuildTool.Rules
             PrivateDependencyModuleNames.AddRange(
                 new string[]
                 {
-                    "Projects"
+                    "Projects",
+                    "Json"
                     // ... add private dependencies that you statically link with here ...
                 }
             );
@@ -66,11 +66,17 @@ namespace Klawr {
 
 		if (bShouldGenerateManagedWrapper)
 		{
+			// The fields are placed at the offsets recorded in the reflection data rather than 
+			// relying on the C# compiler to lay them out the same way as the C++ compiler, the 
+			// reflection data may still be out of date by the time the struct is used so the 
+			// layout is checked again at runtime (see StructLayoutVerifier in Klawr.ClrHost.Managed).
 			const FString packageName = Struct->GetOutermost()->GetName();
 			GeneratedGlue
 				<< FString::Printf(TEXT("// Package: %s"), *packageName)
 				// declare struct
-				<< TEXT("[StructLayout(LayoutKind.Sequential)]")
+				<< FString::Printf(
+					TEXT("[StructLayout(LayoutKind.Explicit, Size = %d)]"), Struct->GetStructureSize()
+				)
 				<< FString::Printf(TEXT("public struct %s"), *NativeStructName)
 				<< FCodeFormatter::OpenBrace();
 		}
@@ -108,15 +114,18 @@ namespace Klawr {
 		const bool bIsBoolProperty = Property->IsA<UBoolProperty>();
 		const FString interopTypeName = GetPropertyInteropType(Property);
 		FString managedTypeName = GetPropertyManagedType(Property);
+		const FString fieldOffsetAttribute = GetFieldOffsetAttribute(Property->GetOffset_ForInternal());
 		if (Property->IsA<UClassProperty>())
 		{
 			// TODO: Handle this properly!
 			GeneratedGlue
+				<< fieldOffsetAttribute
 				<< FString::Printf(TEXT("public IntPtr %s; // UClass*"), *Property->GetName());
 		}
 		else if (Property->IsA<UObjectProperty>())
 		{
 			GeneratedGlue
+				<< fieldOffsetAttribute
 				<< FString::Printf(TEXT("private IntPtr _%s;"), *Property->GetName())
 				<< FString::Printf(TEXT("public %s %s"), *managedTypeName, *Property->GetName())
 				<< FCodeFormatter::OpenBrace()
@@ -137,9 +146,38 @@ namespace Klawr {
 		}
 		else if (Property->IsA<UBoolProperty>())
 		{
-			GeneratedGlue
-				<< MarshalBoolParameterAsUint8Attribute
-				<< FString::Printf(TEXT("public %s %s;"), *interopTypeName, *Property->GetName());
+			const UBoolProperty* boolProperty = CastChecked<UBoolProperty>(Property);
+			if (boolProperty->IsNativeBool())
+			{
+				GeneratedGlue
+					<< fieldOffsetAttribute
+					<< MarshalBoolParameterAsUint8Attribute
+					<< FString::Printf(TEXT("public %s %s;"), *interopTypeName, *Property->GetName());
+			}
+			else
+			{
+				// A bitfield shares its byte with other bitfields, so the byte is wrapped instead.
+				// NOTE: The mask is only known for certain once the engine is compiled, it's 
+				//       checked along with the offsets at runtime.
+				const FString fieldName = GetManagedFieldName(Property);
+				GeneratedGlue
+					<< GetFieldOffsetAttribute(
+						Property->GetOffset_ForInternal() + boolProperty->GetByteOffset()
+					)
+					<< FString::Printf(TEXT("private byte %s;"), *fieldName)
+					<< FString::Printf(
+						TEXT("private const byte %s_Mask = 0x%02x;"), *fieldName, 
+						boolProperty->GetFieldMask()
+					)
+					<< FString::Printf(TEXT("public bool %s"), *Property->GetName())
+					<< FCodeFormatter::OpenBrace()
+					<< FString::Printf(TEXT("get { return (%s & %s_Mask) != 0; }"), *fieldName, *fieldName)
+					<< FString::Printf(
+						TEXT("set { %s = value ? (byte)(%s | %s_Mask) : (byte)(%s & ~%s_Mask); }"),
+						*fieldName, *fieldName, *fieldName, *fieldName, *fieldName
+					)
+					<< FCodeFormatter::CloseBrace();
+			}
 		}
 		else if (Property->IsA<UWeakObjectProperty>())
 		{
@@ -147,6 +185,7 @@ namespace Klawr {
 			typeName.RemoveFromStart(L"TWeakObjectPtr<");
 			typeName.RemoveFromEnd(L">");
 			GeneratedGlue
+				<< fieldOffsetAttribute
 				<< FString::Printf(TEXT("private IntPtr _%s;"), *Property->GetName())
 				<< FString::Printf(TEXT("public %s %s // UWeakObjectPtr"), *typeName, *Property->GetName())
 				<< FCodeFormatter::OpenBrace()
@@ -168,21 +207,51 @@ namespace Klawr {
 		else
 		{
 			GeneratedGlue
+				<< fieldOffsetAttribute
 				<< FString::Printf(TEXT("public %s %s;"), *interopTypeName, *Property->GetName());
 		}
 	}
 
 	void FCSharpStructWrapperGenerator::GenerateArrayPropertyWrapper(const UArrayProperty* arrayProp)
 	{
-		// It's a TArray<T>, for now assume an int32 and a pointer (THIS IS PROBABLY WRONG)
+		// It's a TArray<T>, which is laid out like FScriptArray (a pointer to the elements followed 
+		// by the number of elements and the number of allocated elements)
+		const int32 offset = arrayProp->GetOffset_ForInternal();
 		GeneratedGlue
+			<< GetFieldOffsetAttribute(offset)
+			<< FString::Printf(TEXT("private IntPtr %s;"), *GetManagedFieldName(arrayProp))
+			<< GetFieldOffsetAttribute(offset + sizeof(void*))
 			<< FString::Printf(TEXT("private int _%s_len;"), *arrayProp->GetName())
-			<< FCodeFormatter::LineTerminator()
-			<< FString::Printf(TEXT("private IntPtr _%s_data;"), *arrayProp->GetName())
 			<< FCodeFormatter::LineTerminator();
 		// TODO: Getter/setter for this
 	}
 
+	FString FCSharpStructWrapperGenerator::GetManagedFieldName(const UProperty* Property)
+	{
+		if (Property->IsA<UArrayProperty>())
+		{
+			return FString::Printf(TEXT("_%s_data"), *Property->GetName());
+		}
+		else if (Property->IsA<UClassProperty>())
+		{
+			return Property->GetName();
+		}
+		else if (Property->IsA<UObjectProperty>() || Property->IsA<UWeakObjectProperty>())
+		{
+			return FString(TEXT("_")) + Property->GetName();
+		}
+		else if (Property->IsA<UBoolProperty>() && !CastChecked<UBoolProperty>(Property)->IsNativeBool())
+		{
+			return FString(TEXT("_")) + Property->GetName();
+		}
+		return Property->GetName();
+	}
+
+	FString FCSharpStructWrapperGenerator::GetFieldOffsetAttribute(int32 Offset)
+	{
+		return FString::Printf(TEXT("[FieldOffset(%d)]"), Offset);
+	}
+
 	bool FCSharpStructWrapperGenerator::ShouldGenerateManagedWrapper(const UScriptStruct* Struct)
 	{
 		return true;
@@ -344,6 +413,14 @@ namespace Klawr {
 		{
 			return TEXT("BoolArrayProperty");
 		}
+		else if (elementProperty->IsA<UStructProperty>())
+		{
+			// FCodeGenerator::IsPropertyTypeSupported() only lets through structs that
+			// can be copied to/from the native array as raw memory
+			return FString::Printf(
+				TEXT("StructArrayProperty<%s>"), *GetPropertyManagedType(elementProperty)
+			);
+		}
 		else
 		{
 			// Convert "int32" to "Int32"
@@ -40,6 +40,12 @@ namespace Klawr {
 		/** Get number of properties wrapped. */
 		int32 GetPropertyCount() const { return ExportedProperties.Num(); }
 
+		/** 
+		 * Get the name of the field that stores the value of a property in the generated C# 
+		 * struct, this is the field whose offset is checked against the native struct at runtime.
+		 */
+		static FString GetManagedFieldName(const UProperty* Property);
+
 	private:
 		struct FExportedProperty
 		{
@@ -52,6 +58,7 @@ namespace Klawr {
 		void GenerateStandardPropertyWrapper(const UProperty* Property);
 		void GenerateArrayPropertyWrapper(const UArrayProperty* Property);
 		static bool ShouldGenerateManagedWrapper(const UScriptStruct* Struct);
+		static FString GetFieldOffsetAttribute(int32 Offset);
 		
 		static FString GetPropertyInteropType(const UProperty* Property);
 		static FString GetPropertyManagedType(const UProperty* Property);
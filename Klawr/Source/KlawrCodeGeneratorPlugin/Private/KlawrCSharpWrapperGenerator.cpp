@@ -37,7 +37,11 @@ const FString FCSharpWrapperGenerator::UnmanagedFunctionPointerAttribute =
 #endif // UNICODE
 const FString FCSharpWrapperGenerator::MarshalReturnedBoolAsUint8Attribute = TEXT("[return: MarshalAs(UnmanagedType.U1)]");
 const FString FCSharpWrapperGenerator::MarshalBoolParameterAsUint8Attribute = 	TEXT("[MarshalAs(UnmanagedType.U1)]");
+const FString FCSharpWrapperGenerator::SuppressSecurityChecksAttribute = TEXT("[SuppressUnmanagedCodeSecurity]");
 const FString FCSharpWrapperGenerator::NativeThisPointer = TEXT("(UObjectHandle)this");
+const FString FCSharpWrapperGenerator::NativeThisRawPointer = TEXT("selfRef.Handle");
+const FString FCSharpWrapperGenerator::NativeThisHandleRef = 
+	FCSharpWrapperGenerator::GetHandleRefStatement(TEXT("selfRef"), TEXT("NativeObject"));
 
 FCSharpWrapperGenerator::FCSharpWrapperGenerator(const UClass* Class, const UClass* InWrapperSuperClass, FCodeFormatter& CodeFormatter) : WrapperSuperClass(InWrapperSuperClass), GeneratedGlue(CodeFormatter)
 {
@@ -79,6 +83,7 @@ void FCSharpWrapperGenerator::GenerateHeader()
 		// usings
 		<< TEXT("using System;")
 		<< TEXT("using System.Runtime.InteropServices;")
+		<< TEXT("using System.Security;")
 		<< TEXT("using System.Collections.Generic;")
 		<< TEXT("using Klawr.ClrHost.Interfaces;")
 		<< TEXT("using Klawr.ClrHost.Managed;")
@@ -131,8 +136,7 @@ void FCSharpWrapperGenerator::GenerateFooter()
 			GeneratedGlue << FCodeFormatter::LineTerminator();
 		}
 
-		// define static constructor
-		GenerateManagedStaticConstructor();
+		GenerateNativeFunctionBindings();
 		// close the class
 		GeneratedGlue
 			<< FCodeFormatter::CloseBrace()
@@ -150,51 +154,71 @@ void FCSharpWrapperGenerator::GenerateFooter()
 
 void FCSharpWrapperGenerator::GenerateFunctionWrapper(const UFunction* Function)
 {
+	bool bDirectCall = true;
+	for (TFieldIterator<UProperty> paramIt(Function); paramIt; ++paramIt)
+	{
+		bDirectCall = bDirectCall && CanPassDirectly(*paramIt);
+	}
 	FString formalInteropArgs, actualInteropArgs, formalManagedArgs, actualManagedArgs;
+	TArray<FString> handleRefs;
 	UProperty* returnValue = GetWrapperArgsAndReturnType(
-		Function, formalInteropArgs, actualInteropArgs, formalManagedArgs, actualManagedArgs
+		Function, bDirectCall, formalInteropArgs, actualInteropArgs, formalManagedArgs, 
+		actualManagedArgs, handleRefs
 	);
 	const bool bHasReturnValue = (returnValue != nullptr);
 	const bool bReturnsBool = (bHasReturnValue && returnValue->IsA(UBoolProperty::StaticClass()));
 	const FString returnValueInteropTypeName = 
-		bHasReturnValue ? GetPropertyInteropType(returnValue) : TEXT("void");
+		bHasReturnValue ? GetPropertyInteropType(returnValue, bDirectCall) : TEXT("void");
 	const FString returnValueManagedTypeName =
 		bHasReturnValue ? GetPropertyManagedType(returnValue) : TEXT("void");
 	const FString delegateTypeName = GetDelegateTypeName(Function->GetName(), bHasReturnValue);
 	const FString delegateName = GetDelegateName(Function->GetName());
 
+	// declare a managed delegate type matching the type of the native wrapper function
+	GenerateDelegateTypeAttributes(bDirectCall, bReturnsBool);
 	GeneratedGlue 
-		// declare a managed delegate type matching the type of the native wrapper function
-		<< UnmanagedFunctionPointerAttribute
-		<< (bReturnsBool ? MarshalReturnedBoolAsUint8Attribute : FString())
 		<< FString::Printf(
 			TEXT("private delegate %s %s(%s);"),
 			*returnValueInteropTypeName, *delegateTypeName, *formalInteropArgs
 		)
-		// declare a delegate instance that will be bound to the native wrapper function
-		<< FString::Printf(
-			TEXT("private static %s %s;"),
-			*delegateTypeName, *delegateName
-		)
-		// define a managed method that calls the native wrapper function through the delegate 
-		// declared above
+		// define a managed method that calls the native wrapper function through a delegate of 
+		// the type declared above (see GenerateNativeFunctionBindings())
 		<< FString::Printf(
 			TEXT("public %s %s(%s)"),
 			*returnValueManagedTypeName, *Function->GetName(), *formalManagedArgs
 		)
 		<< FCodeFormatter::OpenBrace();
 
+	// the raw pointers passed to a calli stub are only valid while the handles they were obtained
+	// from are kept alive
+	for (const FString& handleRef : handleRefs)
+	{
+		GeneratedGlue << handleRef;
+	}
+	if (handleRefs.Num() > 0)
+	{
+		GeneratedGlue << FCodeFormatter::OpenBrace();
+	}
+
 	// call the delegate bound to the native wrapper function
 	if (bHasReturnValue)
 	{
 		GeneratedGlue 
-			<< FString::Printf(TEXT("var value = %s(%s);"), *delegateName, *actualInteropArgs)
+			<< GetReturnValueDeclaration(
+				returnValue, bDirectCall, 
+				FString::Printf(TEXT("%s(%s)"), *delegateName, *actualInteropArgs)
+			)
 			<< GetReturnValueHandler(returnValue);
 	}
 	else
 	{
 		GeneratedGlue << FString::Printf(TEXT("%s(%s);"), *delegateName, *actualInteropArgs);
 	}
+
+	if (handleRefs.Num() > 0)
+	{
+		GeneratedGlue << FCodeFormatter::CloseBrace();
+	}
 		
 	GeneratedGlue
 		<< FCodeFormatter::CloseBrace()
@@ -203,6 +227,7 @@ void FCSharpWrapperGenerator::GenerateFunctionWrapper(const UFunction* Function)
 	FExportedFunction funcInfo;
 	funcInfo.DelegateName = delegateName;
 	funcInfo.DelegateTypeName = delegateTypeName;
+	funcInfo.bDirectCall = bDirectCall;
 	ExportedFunctions.Add(funcInfo);
 }
 
@@ -229,10 +254,14 @@ void FCSharpWrapperGenerator::GenerateStandardPropertyWrapper(const UProperty* P
 	propertyInfo.GetterDelegateTypeName = GetDelegateTypeName(getterName, true);
 	propertyInfo.SetterDelegateName = GetDelegateName(setterName);
 	propertyInfo.SetterDelegateTypeName = GetDelegateTypeName(setterName, false);
+	propertyInfo.bDirectCall = CanPassDirectly(Property);
 	ExportedProperties.Add(propertyInfo);
 	
+	const bool bDirectCall = propertyInfo.bDirectCall;
 	const bool bIsBoolProperty = Property->IsA<UBoolProperty>();
-	const FString interopTypeName = GetPropertyInteropType(Property);
+	const FString interopTypeName = GetPropertyInteropType(Property, bDirectCall);
+	const FString selfTypeName = bDirectCall ? TEXT("IntPtr") : TEXT("UObjectHandle");
+	const FString& nativeThis = bDirectCall ? NativeThisRawPointer : NativeThisPointer;
 	const FString managedTypeName = GetPropertyManagedType(Property);
 	FString setterParamType = interopTypeName;
 	if (bIsBoolProperty)
@@ -253,47 +282,81 @@ void FCSharpWrapperGenerator::GenerateStandardPropertyWrapper(const UProperty* P
 		{
 			getterValue = FString::Printf(TEXT("new %s(value)"), *managedTypeName);
 		}
-		setterValue = TEXT("(UObjectHandle)value");
+		setterValue = bDirectCall ? TEXT("valueRef.Handle") : TEXT("(UObjectHandle)value");
+	}
+	// the raw pointers passed to a calli stub are only valid while the handles they were obtained
+	// from are kept alive
+	TArray<FString> setterHandleRefs;
+	if (bDirectCall)
+	{
+		setterHandleRefs.Add(NativeThisHandleRef);
+		if (Property->IsA<UObjectProperty>())
+		{
+			setterHandleRefs.Add(GetHandleRefStatement(TEXT("valueRef"), TEXT("(UObjectHandle)value")));
+		}
 	}
 	
+	// declare getter delegate type
+	GenerateDelegateTypeAttributes(bDirectCall, bIsBoolProperty);
+	GeneratedGlue << FString::Printf(
+		TEXT("private delegate %s %s(%s self);"),
+		*interopTypeName, *propertyInfo.GetterDelegateTypeName, *selfTypeName
+	);
+	// declare setter delegate type
+	GenerateDelegateTypeAttributes(bDirectCall, false);
 	GeneratedGlue
-		// declare getter delegate type
-		<< UnmanagedFunctionPointerAttribute
-		<< (bIsBoolProperty ? MarshalReturnedBoolAsUint8Attribute : FString())
-		<< FString::Printf(
-			TEXT("private delegate %s %s(UObjectHandle self);"),
-			*interopTypeName, *propertyInfo.GetterDelegateTypeName
-		)
-		// declare setter delegate type
-		<< UnmanagedFunctionPointerAttribute
-		<< FString::Printf(
-			TEXT("private delegate void %s(UObjectHandle self, %s %s);"),
-			*propertyInfo.SetterDelegateTypeName, *setterParamType, *Property->GetName()
-		)
-		// declare delegate instances that will be bound to the native wrapper functions
 		<< FString::Printf(
-			TEXT("private static %s %s;"),
-			*propertyInfo.GetterDelegateTypeName, *propertyInfo.GetterDelegateName
+			TEXT("private delegate void %s(%s self, %s %s);"),
+			*propertyInfo.SetterDelegateTypeName, *selfTypeName, *setterParamType, 
+			*Property->GetName()
 		)
-		<< FString::Printf(
-			TEXT("private static %s %s;"),
-			*propertyInfo.SetterDelegateTypeName, *propertyInfo.SetterDelegateName
-		)
-		// define a property that calls the native wrapper functions through the delegates 
-		// declared above
+		// define a property that calls the native wrapper functions through delegates of the 
+		// types declared above (see GenerateNativeFunctionBindings())
 		<< FString::Printf(TEXT("public %s %s"), *managedTypeName, *Property->GetName())
 		<< FCodeFormatter::OpenBrace()
 			<< TEXT("get")
-			<< FCodeFormatter::OpenBrace()
-				<< FString::Printf(TEXT("var value = %s(%s);"), 
-					*propertyInfo.GetterDelegateName, *NativeThisPointer
-				)
-				<< GetReturnValueHandler(Property)
+			<< FCodeFormatter::OpenBrace();
+
+	if (bDirectCall)
+	{
+		GeneratedGlue 
+			<< NativeThisHandleRef
+			<< FCodeFormatter::OpenBrace();
+	}
+	GeneratedGlue
+		<< GetReturnValueDeclaration(
+			Property, bDirectCall, 
+			FString::Printf(TEXT("%s(%s)"), *propertyInfo.GetterDelegateName, *nativeThis)
+		)
+		<< GetReturnValueHandler(Property);
+	if (bDirectCall)
+	{
+		GeneratedGlue << FCodeFormatter::CloseBrace();
+	}
+
+	GeneratedGlue
+			<< FCodeFormatter::CloseBrace()
+			<< TEXT("set")
+			<< FCodeFormatter::OpenBrace();
+
+	for (const FString& handleRef : setterHandleRefs)
+	{
+		GeneratedGlue << handleRef;
+	}
+	if (setterHandleRefs.Num() > 0)
+	{
+		GeneratedGlue << FCodeFormatter::OpenBrace();
+	}
+	GeneratedGlue << FString::Printf(
+		TEXT("%s(%s, %s);"), *propertyInfo.SetterDelegateName, *nativeThis, *setterValue
+	);
+	if (setterHandleRefs.Num() > 0)
+	{
+		GeneratedGlue << FCodeFormatter::CloseBrace();
+	}
+
+	GeneratedGlue
 			<< FCodeFormatter::CloseBrace()
-			<< FString::Printf(
-				TEXT("set { %s(%s, %s); }"), 
-				*propertyInfo.SetterDelegateName, *NativeThisPointer, *setterValue
-			)
 		<< FCodeFormatter::CloseBrace()
 		<< FCodeFormatter::LineTerminator();
 }
@@ -307,6 +370,7 @@ void FCSharpWrapperGenerator::GenerateArrayPropertyWrapper(const UArrayProperty*
 	propertyInfo.GetterDelegateTypeName = GetDelegateTypeName(getterName, true);
 	propertyInfo.SetterDelegateName.Empty();
 	propertyInfo.SetterDelegateTypeName.Empty();
+	propertyInfo.bDirectCall = false;
 	ExportedProperties.Add(propertyInfo);
 	
 	const FString managedTypeName = GetPropertyManagedType(arrayProp->Inner);
@@ -315,18 +379,13 @@ void FCSharpWrapperGenerator::GenerateArrayPropertyWrapper(const UArrayProperty*
 	
 	DisposableMembers.Add(backingFieldName);
 
+	// declare getter delegate type
+	GenerateDelegateTypeAttributes(false, false);
 	GeneratedGlue
-		// declare getter delegate type
-		<< UnmanagedFunctionPointerAttribute
 		<< FString::Printf(
 			TEXT("private delegate ArrayHandle %s(UObjectHandle self);"),
 			*propertyInfo.GetterDelegateTypeName
 		)
-		// declare delegate instance that will be bound to the native wrapper function
-		<< FString::Printf(
-			TEXT("private static %s %s;"),
-			*propertyInfo.GetterDelegateTypeName, *propertyInfo.GetterDelegateName
-		)
 		// declare the backing field for the property
 		<< FString::Printf(TEXT("private ArrayList<%s> %s;"), *managedTypeName, *backingFieldName)
 		<< FCodeFormatter::LineTerminator()
@@ -353,6 +412,105 @@ void FCSharpWrapperGenerator::GenerateArrayPropertyWrapper(const UArrayProperty*
 		<< FCodeFormatter::LineTerminator();
 }
 
+void FCSharpWrapperGenerator::GenerateEventWrapper(const UMulticastDelegateProperty* Property)
+{
+	const FString backingFieldName = FString::Printf(TEXT("_%s"), *Property->GetName());
+	const FString dispatcherName = FString::Printf(TEXT("Dispatch_%s"), *Property->GetName());
+
+	FString handlerArgTypes;
+	FString handlerArgs;
+	int32 argIndex = 0;
+	for (TFieldIterator<UProperty> paramIt(Property->SignatureFunction); paramIt; ++paramIt)
+	{
+		const UProperty* param = *paramIt;
+		if (!param->HasAnyPropertyFlags(CPF_Parm))
+		{
+			continue;
+		}
+		if (argIndex > 0)
+		{
+			handlerArgTypes += TEXT(", ");
+			handlerArgs += TEXT(", ");
+		}
+		handlerArgTypes += GetPropertyManagedType(param);
+		handlerArgs += GetEventArgValue(param, argIndex);
+		++argIndex;
+	}
+	const FString handlerTypeName = handlerArgTypes.IsEmpty() 
+		? FString(TEXT("Action")) : FString::Printf(TEXT("Action<%s>"), *handlerArgTypes);
+
+	DisposableMembers.Add(backingFieldName);
+
+	GeneratedGlue
+		// declare the backing field for the event, it's created when the first handler is added
+		<< FString::Printf(
+			TEXT("private NativeEvent<%s> %s;"), *handlerTypeName, *backingFieldName
+		)
+		<< FCodeFormatter::LineTerminator()
+		// unpack the arguments passed in by the event trampoline and invoke the handlers
+		<< FString::Printf(
+			TEXT("private static void %s(%s handlers, IntPtr args)"), 
+			*dispatcherName, *handlerTypeName
+		)
+		<< FCodeFormatter::OpenBrace()
+			<< FString::Printf(TEXT("handlers(%s);"), *handlerArgs)
+		<< FCodeFormatter::CloseBrace()
+		<< FCodeFormatter::LineTerminator()
+		<< FString::Printf(TEXT("public event %s %s"), *handlerTypeName, *Property->GetName())
+		<< FCodeFormatter::OpenBrace()
+			<< TEXT("add")
+			<< FCodeFormatter::OpenBrace()
+				<< FString::Printf(TEXT("if (%s == null)"), *backingFieldName)
+				<< FCodeFormatter::OpenBrace()
+					<< FString::Printf(
+						TEXT("%s = new NativeEvent<%s>((UObjectHandle)this, \"%s\", %s);"),
+						*backingFieldName, *handlerTypeName, *Property->GetName(), *dispatcherName
+					)
+				<< FCodeFormatter::CloseBrace()
+				<< FString::Printf(TEXT("%s.Add(value);"), *backingFieldName)
+			<< FCodeFormatter::CloseBrace()
+			<< TEXT("remove")
+			<< FCodeFormatter::OpenBrace()
+				<< FString::Printf(TEXT("if (%s != null)"), *backingFieldName)
+				<< FCodeFormatter::OpenBrace()
+					<< FString::Printf(TEXT("%s.Remove(value);"), *backingFieldName)
+				<< FCodeFormatter::CloseBrace()
+			<< FCodeFormatter::CloseBrace()
+		<< FCodeFormatter::CloseBrace()
+		<< FCodeFormatter::LineTerminator();
+}
+
+FString FCSharpWrapperGenerator::GetEventArgValue(const UProperty* Param, int32 ArgIndex)
+{
+	if (Param->IsA<UObjectProperty>())
+	{
+		return FString::Printf(
+			TEXT("new %s(NativeEventArgs.GetObject(args, %d))"), 
+			*GetPropertyManagedType(Param), ArgIndex
+		);
+	}
+	else if (Param->IsA<UStructProperty>())
+	{
+		return FString::Printf(
+			TEXT("NativeEventArgs.GetStruct<%s>(args, %d)"), 
+			*GetPropertyManagedType(Param), ArgIndex
+		);
+	}
+	else if (Param->IsA<UBoolProperty>())
+	{
+		return FString::Printf(TEXT("NativeEventArgs.GetBool(args, %d)"), ArgIndex);
+	}
+	else if (Param->IsA<UFloatProperty>())
+	{
+		return FString::Printf(TEXT("NativeEventArgs.GetFloat(args, %d)"), ArgIndex);
+	}
+	else if (Param->IsA<UStrProperty>())
+	{
+		return FString::Printf(TEXT("NativeEventArgs.GetString(args, %d)"), ArgIndex);
+	}
+	return FString::Printf(TEXT("NativeEventArgs.GetInt(args, %d)"), ArgIndex);
+}
+
 bool FCSharpWrapperGenerator::ShouldGenerateManagedWrapper(const UClass* Class)
 {
 	return (Class != UObject::StaticClass())
@@ -397,41 +555,40 @@ void FCSharpWrapperGenerator::GenerateDisposeMethod()
 		<< FCodeFormatter::CloseBrace();
 }
 
-void FCSharpWrapperGenerator::GenerateManagedStaticConstructor()
+void FCSharpWrapperGenerator::GenerateNativeFunctionBindings()
 {
 	if ((ExportedFunctions.Num() == 0) && (ExportedProperties.Num() == 0))
 	{
 		return;
 	}
 
-	GeneratedGlue << FString::Printf(TEXT("static %s()"), *NativeClassName);
-	GeneratedGlue << FCodeFormatter::OpenBrace();
-	
-	// bind managed delegates to pointers to native wrapper functions
+	// Binding a delegate to a native wrapper function isn't free, and most classes have far more
+	// functions than any script will ever call, so each delegate is only bound the first time it's
+	// used. Binding isn't synchronized, if two threads race to bind the same delegate one of the
+	// two (equivalent) delegates will simply be discarded.
 	GeneratedGlue 
-		<< TEXT("var manager = AppDomain.CurrentDomain.DomainManager as IEngineAppDomainManager;")
 		<< FString::Printf(
-			TEXT("var nativeFuncPtrs = manager.GetNativeFunctionPointers(\"%s\");"), *NativeClassName
-		);
+			TEXT("private static readonly int _nativeFunctionTableOffset = NativeFunctionTable.GetClassOffset(\"%s\");"),
+			*NativeClassName
+		)
+		<< FCodeFormatter::LineTerminator();
 	
 	int32 functionIdx = 0;
 	for (const FExportedProperty& propInfo : ExportedProperties)
 	{
 		if (!propInfo.GetterDelegateName.IsEmpty())
 		{
-			GeneratedGlue << FString::Printf(
-				TEXT("%s = Marshal.GetDelegateForFunctionPointer(nativeFuncPtrs[%d], typeof(%s)) as %s;"),
-				*propInfo.GetterDelegateName, functionIdx, *propInfo.GetterDelegateTypeName,
-				*propInfo.GetterDelegateTypeName
+			GenerateLazyDelegate(
+				propInfo.GetterDelegateName, propInfo.GetterDelegateTypeName, functionIdx, 
+				propInfo.bDirectCall
 			);
 			++functionIdx;
 		}
 		if (!propInfo.SetterDelegateName.IsEmpty())
 		{
-			GeneratedGlue << FString::Printf(
-				TEXT("%s = Marshal.GetDelegateForFunctionPointer(nativeFuncPtrs[%d], typeof(%s)) as %s;"),
-				*propInfo.SetterDelegateName, functionIdx, *propInfo.SetterDelegateTypeName,
-				*propInfo.SetterDelegateTypeName
+			GenerateLazyDelegate(
+				propInfo.SetterDelegateName, propInfo.SetterDelegateTypeName, functionIdx, 
+				propInfo.bDirectCall
 			);
 			++functionIdx;
 		}
@@ -439,16 +596,27 @@ void FCSharpWrapperGenerator::GenerateManagedStaticConstructor()
 		
 	for (const FExportedFunction& funcInfo : ExportedFunctions)
 	{
-		// FIXME: don't generate the delegate type and name again, get it from FExportedFunction
-		GeneratedGlue << FString::Printf(
-			TEXT("%s = Marshal.GetDelegateForFunctionPointer(nativeFuncPtrs[%d], typeof(%s)) as %s;"),
-			*funcInfo.DelegateName,	functionIdx, *funcInfo.DelegateTypeName, 
-			*funcInfo.DelegateTypeName
+		GenerateLazyDelegate(
+			funcInfo.DelegateName, funcInfo.DelegateTypeName, functionIdx, funcInfo.bDirectCall
 		);
 		++functionIdx;
 	}
-		
-	GeneratedGlue << FCodeFormatter::CloseBrace();
+}
+
+void FCSharpWrapperGenerator::GenerateLazyDelegate(
+	const FString& DelegateName, const FString& DelegateTypeName, int32 FunctionIndex, 
+	bool bDirectCall
+)
+{
+	// the wrappers call the delegate through a property that binds it on first use
+	const FString fieldName = DelegateName + TEXT("Delegate");
+	GeneratedGlue
+		<< FString::Printf(TEXT("private static %s %s;"), *DelegateTypeName, *fieldName)
+		<< FString::Printf(
+			TEXT("private static %s %s => %s ?? (%s = NativeFunctionBinder.%s<%s>(NativeFunctionTable.GetFunction(_nativeFunctionTableOffset + %d)));"),
+			*DelegateTypeName, *DelegateName, *fieldName, *fieldName, 
+			bDirectCall ? TEXT("BindDirect") : TEXT("Bind"), *DelegateTypeName, FunctionIndex
+		);
 }
 
 void FCSharpWrapperGenerator::GenerateManagedScriptObjectClass()
@@ -489,14 +657,20 @@ void FCSharpWrapperGenerator::GenerateManagedScriptObjectClass()
 }
 
 UProperty* FCSharpWrapperGenerator::GetWrapperArgsAndReturnType(
-	const UFunction* Function, FString& OutFormalInteropArgs, FString& OutActualInteropArgs,
-	FString& OutFormalManagedArgs, FString& OutActualManagedArgs
+	const UFunction* Function, bool bDirectCall, FString& OutFormalInteropArgs, 
+	FString& OutActualInteropArgs, FString& OutFormalManagedArgs, FString& OutActualManagedArgs,
+	TArray<FString>& OutHandleRefs
 )
 {
-	OutFormalInteropArgs = TEXT("UObjectHandle self");
-	OutActualInteropArgs = NativeThisPointer;
+	OutFormalInteropArgs = bDirectCall ? TEXT("IntPtr self") : TEXT("UObjectHandle self");
+	OutActualInteropArgs = bDirectCall ? NativeThisRawPointer : NativeThisPointer;
 	OutFormalManagedArgs.Empty();
 	OutActualManagedArgs.Empty();
+	OutHandleRefs.Empty();
+	if (bDirectCall)
+	{
+		OutHandleRefs.Add(NativeThisHandleRef);
+	}
 	UProperty* returnValue = nullptr;
 
 	for (TFieldIterator<UProperty> paramIt(Function); paramIt; ++paramIt)
@@ -509,7 +683,7 @@ UProperty* FCSharpWrapperGenerator::GetWrapperArgsAndReturnType(
 		else
 		{
 			FString argName = param->GetName();
-			FString argInteropType = GetPropertyInteropType(param);
+			FString argInteropType = GetPropertyInteropType(param, bDirectCall);
 			FString argAttrs = GetPropertyInteropTypeAttributes(param);
 			FString argMods = GetPropertyInteropTypeModifiers(param);
 			
@@ -535,11 +709,23 @@ UProperty* FCSharpWrapperGenerator::GetWrapperArgsAndReturnType(
 				OutActualInteropArgs += argMods;
 			}
 			OutActualInteropArgs += TEXT(" ");
-			if (param->IsA<UObjectProperty>())
+			if (param->IsA<UObjectProperty>() && bDirectCall)
 			{
-				OutActualInteropArgs += TEXT("(UObjectHandle)");
+				// a null object is passed as IntPtr.Zero (see UObjectHandleRef)
+				const FString refName = argName + TEXT("Ref");
+				OutHandleRefs.Add(
+					GetHandleRefStatement(refName, FString(TEXT("(UObjectHandle)")) + argName)
+				);
+				OutActualInteropArgs += refName + TEXT(".Handle");
+			}
+			else if (param->IsA<UObjectProperty>())
+			{
+				OutActualInteropArgs += FString(TEXT("(UObjectHandle)")) + argName;
+			}
+			else
+			{
+				OutActualInteropArgs += argName;
 			}
-			OutActualInteropArgs += argName;
 									
 			if (!OutFormalManagedArgs.IsEmpty())
 			{
@@ -563,6 +749,11 @@ UProperty* FCSharpWrapperGenerator::GetWrapperArgsAndReturnType(
 	return returnValue;
 }
 
+FString FCSharpWrapperGenerator::GetHandleRefStatement(const FString& RefName, const FString& Handle)
+{
+	return FString::Printf(TEXT("using (var %s = new UObjectHandleRef(%s))"), *RefName, *Handle);
+}
+
 FString FCSharpWrapperGenerator::GetReturnValueHandler(const UProperty* ReturnValue)
 {
 	if (ReturnValue)
@@ -587,11 +778,51 @@ FString FCSharpWrapperGenerator::GetReturnValueHandler(const UProperty* ReturnVa
 	return FString();
 }
 
-FString FCSharpWrapperGenerator::GetPropertyInteropType(const UProperty* Property)
+FString FCSharpWrapperGenerator::GetReturnValueDeclaration(
+	const UProperty* ReturnValue, bool bDirectCall, const FString& NativeCall
+)
+{
+	if (bDirectCall && ReturnValue->IsA<UObjectProperty>())
+	{
+		// the marshaler would've wrapped the returned pointer in a handle that owns it
+		return FString::Printf(TEXT("var value = new UObjectHandle(%s, true);"), *NativeCall);
+	}
+	return FString::Printf(TEXT("var value = %s;"), *NativeCall);
+}
+
+void FCSharpWrapperGenerator::GenerateDelegateTypeAttributes(bool bDirectCall, bool bReturnsBool)
+{
+	// The stack walk the CLR performs on every call into native code to check the caller has the 
+	// UnmanagedCode permission is unnecessary, the wrapper assembly is always fully trusted.
+	GeneratedGlue << SuppressSecurityChecksAttribute;
+	if (!bDirectCall)
+	{
+		GeneratedGlue
+			<< UnmanagedFunctionPointerAttribute
+			<< (bReturnsBool ? MarshalReturnedBoolAsUint8Attribute : FString());
+	}
+}
+
+bool FCSharpWrapperGenerator::CanPassDirectly(const UProperty* Property)
+{
+	// Only types that have the same representation in native and managed code can be passed 
+	// without marshaling. Reference parameters are excluded because they may point into the 
+	// managed heap and the calli stubs don't pin anything.
+	if (!GetPropertyInteropTypeModifiers(Property).IsEmpty())
+	{
+		return false;
+	}
+	return Property->IsA<UIntProperty>()
+		|| Property->IsA<UFloatProperty>()
+		|| Property->IsA<UDoubleProperty>()
+		|| Property->IsA<UObjectPropertyBase>();
+}
+
+FString FCSharpWrapperGenerator::GetPropertyInteropType(const UProperty* Property, bool bDirectCall)
 {
 	if (Property->IsA<UObjectProperty>())
 	{
-		return TEXT("UObjectHandle");
+		return bDirectCall ? TEXT("IntPtr") : TEXT("UObjectHandle");
 	}
 	else if (Property->IsA<UObjectPropertyBase>())
 	{
@@ -636,7 +867,7 @@ FString FCSharpWrapperGenerator::GetPropertyManagedType(const UProperty* Propert
 		typeName.RemoveFromEnd(pointer);
 		return typeName;
 	}
-	return GetPropertyInteropType(Property);
+	return GetPropertyInteropType(Property, false);
 }
 
 FString FCSharpWrapperGenerator::GetPropertyInteropTypeAttributes(const UProperty* Property)
@@ -728,6 +959,14 @@ FString FCSharpWrapperGenerator::GetArrayPropertyWrapperType(const UArrayPropert
 	{
 		return TEXT("BoolArrayProperty");
 	}
+	else if (elementProperty->IsA<UStructProperty>())
+	{
+		// FCodeGenerator::IsPropertyTypeSupported() only lets through structs that
+		// can be copied to/from the native array as raw memory
+		return FString::Printf(
+			TEXT("StructArrayProperty<%s>"), *GetPropertyManagedType(elementProperty)
+		);
+	}
 	else
 	{
 		// Convert "int32" to "Int32"
@@ -36,6 +36,8 @@ public:
 	void GenerateHeader();
 	void GenerateFunctionWrapper(const UFunction* Function);
 	void GeneratePropertyWrapper(const UProperty* Property);
+	/** Generate a C# event for a dynamic multicast delegate (see NativeEvent in Klawr.ClrHost.Managed). */
+	void GenerateEventWrapper(const UMulticastDelegateProperty* Property);
 	void GenerateFooter();
 
 	/** Get number of properties wrapped. */
@@ -54,12 +56,16 @@ private:
 		FString GetterDelegateTypeName;
 		FString SetterDelegateName;
 		FString SetterDelegateTypeName;
+		/** True if the delegates should be bound to calli stubs rather than marshaling stubs. */
+		bool bDirectCall;
 	};
 
 	struct FExportedFunction
 	{
 		FString DelegateName;
 		FString DelegateTypeName;
+		/** True if the delegate should be bound to a calli stub rather than a marshaling stub. */
+		bool bDirectCall;
 	};
 
 private:
@@ -68,20 +74,51 @@ private:
 	static bool ShouldGenerateManagedWrapper(const UClass* Class);
 	static bool ShouldGenerateScriptObjectClass(const UClass* Class);
 	void GenerateDisposeMethod();
-	void GenerateManagedStaticConstructor();
+	/** Generate the members that bind delegates to the native wrapper functions. */
+	void GenerateNativeFunctionBindings();
+	void GenerateLazyDelegate(
+		const FString& DelegateName, const FString& DelegateTypeName, int32 FunctionIndex, 
+		bool bDirectCall
+	);
 	void GenerateManagedScriptObjectClass();
+	/** 
+	 * @param OutHandleRefs Set to the using statements that must enclose the native call, only
+	 *                      needed for direct calls (see GetHandleRefStatement()).
+	 */
 	static UProperty* GetWrapperArgsAndReturnType(
-		const UFunction* Function, FString& OutFormalInteropArgs, FString& OutActualInteropArgs,
-		FString& OutFormalManagedArgs, FString& OutActualManagedArgs
+		const UFunction* Function, bool bDirectCall, FString& OutFormalInteropArgs, 
+		FString& OutActualInteropArgs, FString& OutFormalManagedArgs, FString& OutActualManagedArgs,
+		TArray<FString>& OutHandleRefs
+	);
+	/** 
+	 * Get a using statement that keeps a UObjectHandle alive while its raw pointer is passed to
+	 * a calli stub, the pointer can be accessed via RefName.Handle within the statement.
+	 */
+	static FString GetHandleRefStatement(const FString& RefName, const FString& Handle);
+	/** Declare a local variable named "value" that is initialized by the given native call. */
+	static FString GetReturnValueDeclaration(
+		const UProperty* ReturnValue, bool bDirectCall, const FString& NativeCall
 	);
 	static FString GetReturnValueHandler(const UProperty* ReturnValue);
-	static FString GetPropertyInteropType(const UProperty* Property);
+	void GenerateDelegateTypeAttributes(bool bDirectCall, bool bReturnsBool);
+	/** 
+	 * Check if a parameter or property can be passed to a native wrapper function through a calli 
+	 * stub (see NativeCalli in Klawr.ClrHost.Managed) without any marshaling.
+	 */
+	static bool CanPassDirectly(const UProperty* Property);
+	/** 
+	 * Get the type of a parameter or property in a delegate bound to a native wrapper function.
+	 * @param bDirectCall true if the delegate will be bound to a calli stub
+	 */
+	static FString GetPropertyInteropType(const UProperty* Property, bool bDirectCall);
 	static FString GetPropertyManagedType(const UProperty* Property);
 	static FString GetPropertyInteropTypeAttributes(const UProperty* Property);
 	static FString GetPropertyInteropTypeModifiers(const UProperty* Property);
 	static FString GetDelegateTypeName(const FString& FunctionName, bool bHasReturnValue);
 	static FString GetDelegateName(const FString& FunctionName);
 	static FString GetArrayPropertyWrapperType(const UArrayProperty* ArrayProperty);
+	/** Get an expression that reads an event handler argument from the native argument array. */
+	static FString GetEventArgValue(const UProperty* Param, int32 ArgIndex);
 
 private:
 	const UClass* WrapperSuperClass;
@@ -98,7 +135,10 @@ private:
 	static const FString UnmanagedFunctionPointerAttribute;
 	static const FString MarshalReturnedBoolAsUint8Attribute;
 	static const FString MarshalBoolParameterAsUint8Attribute;
+	static const FString SuppressSecurityChecksAttribute;
 	static const FString NativeThisPointer;
+	static const FString NativeThisRawPointer;
+	static const FString NativeThisHandleRef;
 };
 
 } // namespace Klawr
@@ -0,0 +1,158 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+
+#include "KlawrCodeGeneratorPluginPrivatePCH.h"
+#include "KlawrCodeFormatter.h"
+
+namespace Klawr {
+
+void FCodeFormatter::Append(const TCHAR* Text, int32 TextLength)
+{
+	Length += TextLength;
+	while (TextLength > 0)
+	{
+		if ((Chunks.Num() == 0) || (Chunks.Last().Num() == ChunkSize))
+		{
+			Chunks.AddDefaulted();
+			Chunks.Last().Reserve(ChunkSize);
+		}
+		TArray<TCHAR>& chunk = Chunks.Last();
+		const int32 numChars = FMath::Min(TextLength, ChunkSize - chunk.Num());
+		chunk.Append(Text, numChars);
+		Text += numChars;
+		TextLength -= numChars;
+	}
+}
+
+void FCodeFormatter::Append(int32 Value)
+{
+	TCHAR digits[16];
+	int32 numDigits = 0;
+	// work with the negated value so INT32_MIN doesn't overflow
+	int32 remainder = (Value < 0) ? Value : -Value;
+	do
+	{
+		digits[numDigits++] = TEXT('0') - (remainder % 10);
+		remainder /= 10;
+	} while (remainder != 0);
+
+	if (Value < 0)
+	{
+		Append(TEXT('-'));
+	}
+	while (numDigits > 0)
+	{
+		Append(digits[--numDigits]);
+	}
+}
+
+bool FCodeFormatter::Equals(const FString& Other) const
+{
+	if (Other.Len() != Length)
+	{
+		return false;
+	}
+	const TCHAR* otherText = *Other;
+	for (const TArray<TCHAR>& chunk : Chunks)
+	{
+		if (FMemory::Memcmp(chunk.GetData(), otherText, chunk.Num() * sizeof(TCHAR)) != 0)
+		{
+			return false;
+		}
+		otherText += chunk.Num();
+	}
+	return true;
+}
+
+FString FCodeFormatter::ToString() const
+{
+	FString result;
+	result.Reserve(Length);
+	for (const TArray<TCHAR>& chunk : Chunks)
+	{
+		result.AppendChars(chunk.GetData(), chunk.Num());
+	}
+	return result;
+}
+
+bool FCodeFormatter::SaveToFile(const FString& Filename) const
+{
+	bool bIsPureAnsi = true;
+	for (const TArray<TCHAR>& chunk : Chunks)
+	{
+		for (TCHAR character : chunk)
+		{
+			if (character > 0x7f)
+			{
+				bIsPureAnsi = false;
+				break;
+			}
+		}
+		if (!bIsPureAnsi)
+		{
+			break;
+		}
+	}
+
+	TUniquePtr<FArchive> writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!writer)
+	{
+		return false;
+	}
+
+	if (bIsPureAnsi)
+	{
+		TArray<ANSICHAR> buffer;
+		buffer.Reserve(ChunkSize);
+		for (const TArray<TCHAR>& chunk : Chunks)
+		{
+			buffer.Reset();
+			for (TCHAR character : chunk)
+			{
+				buffer.Add(static_cast<ANSICHAR>(character));
+			}
+			writer->Serialize(buffer.GetData(), buffer.Num() * sizeof(ANSICHAR));
+		}
+	}
+	else
+	{
+		UTF16CHAR bom = UNICODE_BOM;
+		writer->Serialize(&bom, sizeof(bom));
+
+		TArray<UTF16CHAR> buffer;
+		buffer.Reserve(ChunkSize);
+		for (const TArray<TCHAR>& chunk : Chunks)
+		{
+			buffer.Reset();
+			for (TCHAR character : chunk)
+			{
+				buffer.Add(static_cast<UTF16CHAR>(character));
+			}
+			writer->Serialize(buffer.GetData(), buffer.Num() * sizeof(UTF16CHAR));
+		}
+	}
+	return writer->Close();
+}
+
+} // namespace Klawr
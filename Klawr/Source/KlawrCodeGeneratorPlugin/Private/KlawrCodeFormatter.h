@@ -25,7 +25,13 @@
 
 namespace Klawr {
 
-/** Automatically indents and terminates lines of code. */
+/** 
+ * Automatically indents and terminates lines of code.
+ *
+ * Generated code is accumulated in a list of fixed size chunks rather than one big string, so
+ * appending never has to copy the text that was already generated, the chunks are written out
+ * one at a time by SaveToFile().
+ */
 class FCodeFormatter
 {
 public:
@@ -33,21 +39,28 @@ public:
 	class FIndent
 	{
 	public:
-		/** String that should be prefixed to a line of text to ensure it is indented properly. */
-		FString Text;
-
 		FIndent(TCHAR InSpace, int32 InTabSize)
 			: Level(0)
 			, Space(InSpace)
 			, TabSize(InTabSize)
 		{
+			LevelText.Add(FString());
+		}
+
+		/** String that should be prefixed to a line of text to ensure it is indented properly. */
+		const FString& GetText() const
+		{
+			return LevelText[Level];
 		}
 
 		/** Increment the indent by one level. */
 		FIndent& operator++() // prefix increment
 		{
 			++Level;
-			Text = FString::ChrN(Level * TabSize, Space);
+			if (Level == LevelText.Num())
+			{
+				LevelText.Add(FString::ChrN(Level * TabSize, Space));
+			}
 			return *this;
 		}
 
@@ -56,7 +69,6 @@ public:
 		{
 			check(Level > 0);
 			--Level;
-			Text = FString::ChrN(Level * TabSize, Space);
 			return *this;
 		}
 	private:
@@ -65,6 +77,8 @@ public:
 		TCHAR Space;
 		// number of characters that make up a single tab
 		int32 TabSize;
+		// indent string for each level that has been used so far
+		TArray<FString> LevelText;
 	};
 
 	struct OpenBrace {};
@@ -73,11 +87,10 @@ public:
 
 	/** Current indent. */
 	FIndent Indent;
-	/** The formatted code. */
-	FString Content;
 
 	FCodeFormatter(TCHAR InSpace, int32 InTabSize)
 		: Indent(InSpace, InTabSize)
+		, Length(0)
 	{
 	}
 
@@ -89,7 +102,7 @@ public:
 	{
 		if (!Text.IsEmpty())
 		{
-			Content += Indent.Text + Text + LINE_TERMINATOR;
+			Line(Text);
 		}
 		return *this;
 	}
@@ -100,8 +113,7 @@ public:
 	 */
 	FCodeFormatter& operator<<(const TCHAR* Text)
 	{
-		Content += Indent.Text + Text + LINE_TERMINATOR;
-		return *this;
+		return Line(Text);
 	}
 
 	/** 
@@ -111,7 +123,7 @@ public:
 	 */
 	FCodeFormatter& operator<<(const OpenBrace&)
 	{
-		Content += Indent.Text + TEXT("{") LINE_TERMINATOR;
+		Line(TEXT("{"));
 		++Indent;
 		return *this;
 	}
@@ -124,16 +136,90 @@ public:
 	FCodeFormatter& operator<<(const CloseBrace&)
 	{
 		--Indent;
-		Content += Indent.Text + TEXT("}") LINE_TERMINATOR;
-		return *this;
+		return Line(TEXT("}"));
 	}
 
 	/** Append a line terminator. */
 	FCodeFormatter& operator<<(const LineTerminator&)
 	{
-		Content += LINE_TERMINATOR;
+		Append(LINE_TERMINATOR);
+		return *this;
+	}
+
+	/**
+	 * Append a line of code made up of the given pieces.
+	 * This is equivalent to operator<<(FString::Printf(...)), but the pieces are copied straight 
+	 * into the output so no temporary strings need to be built. Each piece may be a string, 
+	 * a character, or an integer.
+	 */
+	template <typename... ArgTypes>
+	FCodeFormatter& Line(const ArgTypes&... Args)
+	{
+		Append(Indent.GetText());
+		AppendPieces(Args...);
+		Append(LINE_TERMINATOR);
 		return *this;
 	}
+
+	/** Append text without indenting or line terminating it. */
+	void Append(const TCHAR* Text, int32 TextLength);
+
+	void Append(const TCHAR* Text)
+	{
+		Append(Text, FCString::Strlen(Text));
+	}
+
+	void Append(const FString& Text)
+	{
+		Append(*Text, Text.Len());
+	}
+
+	void Append(TCHAR Character)
+	{
+		Append(&Character, 1);
+	}
+
+	void Append(int32 Value);
+
+	/** Get the total number of characters appended so far. */
+	int32 Len() const
+	{
+		return Length;
+	}
+
+	/** Check if the formatted code matches the given string exactly. */
+	bool Equals(const FString& Other) const;
+
+	/** Copy the formatted code into a single string. */
+	FString ToString() const;
+
+	/**
+	 * Write the formatted code to the given file, one chunk at a time.
+	 * The encoding matches that used by FFileHelper::SaveStringToFile() with the default arguments,
+	 * i.e. ANSI if possible, UTF-16 otherwise.
+	 * @return true if the file was written successfully, false otherwise.
+	 */
+	bool SaveToFile(const FString& Filename) const;
+
+private:
+	/** Number of characters in each chunk. */
+	static const int32 ChunkSize = 16 * 1024;
+
+	/** The formatted code, every chunk except the last one is full. */
+	TArray<TArray<TCHAR>> Chunks;
+	/** Total number of characters in all the chunks. */
+	int32 Length;
+
+	void AppendPieces()
+	{
+	}
+
+	template <typename FirstArgType, typename... ArgTypes>
+	void AppendPieces(const FirstArgType& First, const ArgTypes&... Rest)
+	{
+		Append(First);
+		AppendPieces(Rest...);
+	}
 };
 
 } // namespace
@@ -26,6 +26,7 @@
 #include "KlawrCodeGenerator.h"
 #include "KlawrCodeFormatter.h"
 #include "pugixml.hpp"
+#include "Async/ParallelFor.h"
 #include "KlawrNativeWrapperGenerator.h"
 #include "KlawrCSharpWrapperGenerator.h"
 #include "KlawrCSharpStructWrapperGenerator.h"
@@ -47,11 +48,55 @@ namespace Klawr {
 	};
 
 const FString FCodeGenerator::ClrHostManagedAssemblyName = TEXT("Klawr.ClrHost.Managed");
+const FString FCodeGenerator::NativeGlueFilename = TEXT("KlawrGeneratedNativeWrappers.inl");
+const FString FCodeGenerator::ManagedWrapperProjectFilename = TEXT("Klawr.UnrealEngine.csproj");
+const FString FCodeGenerator::ManifestFilename = TEXT("KlawrGeneratedCode.manifest");
+const FString FCodeGenerator::ReportFilename = TEXT("KlawrCodeGeneratorReport.json");
+const int32 FCodeGenerator::MaxNativeGlueShards = 8;
+
+void FCodeGenerator::FConfig::LoadUsedBindings()
+{
+	FString usageContent;
+	if (!FFileHelper::LoadFileToString(usageContent, *BindingUsageFilePath))
+	{
+		// The game scripts have to be built against a complete set of bindings at least once 
+		// before they can be trimmed, so not finding the file isn't an error.
+		UE_LOG(
+			LogKlawrCodeGenerator, Warning, 
+			TEXT("Binding usage file %s not found, bindings will not be trimmed."), *BindingUsageFilePath
+		);
+		bTrimUnusedBindings = false;
+		return;
+	}
+
+	TArray<FString> usageLines;
+	usageContent.ParseIntoArrayLines(usageLines);
+	for (const FString& usageLine : usageLines)
+	{
+		const FString usedBinding = usageLine.Trim().TrimTrailing();
+		if (!usedBinding.IsEmpty())
+		{
+			UsedBindings.Add(usedBinding);
+		}
+	}
+	const int32 numUsedBindings = UsedBindings.Num();
+	UsedBindings.Append(KeepBindings);
+
+	UE_LOG(
+		LogKlawrCodeGenerator, Log, 
+		TEXT("Trimming bindings to the %d members referenced in %s and %d kept members, ")
+		TEXT("add any other members the game scripts need to KeepBindings in %s."),
+		numUsedBindings, *BindingUsageFilePath, KeepBindings.Num(), *GetConfigFilePath()
+	);
+}
 
 FCodeGenerator::FCodeGenerator(const FString& InRootLocalPath, const FString& InRootBuildPath, const FString& InOutputDirectory, const FString& InIncludeBase)
 	: GeneratedCodePath(InOutputDirectory), RootLocalPath(InRootLocalPath), RootBuildPath(InRootBuildPath), IncludeBase(InIncludeBase)
+	, Manifest(InOutputDirectory / ManifestFilename)
+	, NumGeneratedTypes(0)
+	, NumUpToDateTypes(0)
 {
-	 
+	Manifest.Load();
 }
 
 FString FCodeGenerator::GetPropertyCPPType(const UProperty* Property)
@@ -94,47 +139,61 @@ FString FCodeGenerator::GetPropertyCPPType(const UProperty* Property)
 
 bool FCodeGenerator::CanExportClass(const UClass* Class)
 {
-	bool bCanExport = 
-		// skip classes that don't export DLL symbols
-		Class->HasAnyClassFlags(CLASS_RequiredAPI | CLASS_MinimalAPI)
-		// these have a custom wrappers, so no need to generate code for them
-		&& (Class != UObject::StaticClass())
-		&& (Class != UClass::StaticClass());
+	return GetClassSkipReason(Class) == nullptr;
+}
 
-	if (bCanExport)
+const TCHAR* FCodeGenerator::GetClassSkipReason(const UClass* Class)
+{
+	// skip classes that don't export DLL symbols
+	if (!Class->HasAnyClassFlags(CLASS_RequiredAPI | CLASS_MinimalAPI))
 	{
-		// check for exportable functions
-		bool bHasMembersToExport = false;
-		TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper);
-		for ( ; funcIt; ++funcIt)
+		return TEXT("NotDllExported");
+	}
+
+	// these have a custom wrappers, so no need to generate code for them
+	if ((Class == UObject::StaticClass()) || (Class == UClass::StaticClass()))
+	{
+		return TEXT("CustomWrapper");
+	}
+
+	// check for exportable functions
+	TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper);
+	for ( ; funcIt; ++funcIt)
+	{
+		if (CanExportFunction(Class, *funcIt))
 		{
-			if (CanExportFunction(Class, *funcIt))
-			{
-				bHasMembersToExport = true;
-				break;
-			}
+			return nullptr;
 		}
-		// check for exportable properties
-		if (!bHasMembersToExport)
+	}
+	// check for exportable properties
+	TFieldIterator<UProperty> propertyIt(Class, EFieldIteratorFlags::ExcludeSuper);
+	for ( ; propertyIt; ++propertyIt)
+	{
+		if (CanExportProperty(Class, *propertyIt))
 		{
-			TFieldIterator<UProperty> propertyIt(Class, EFieldIteratorFlags::ExcludeSuper);
-			for ( ; propertyIt; ++propertyIt)
-			{
-				if (CanExportProperty(Class, *propertyIt))
-				{
-					bHasMembersToExport = true;
-					break;
-				}
-			}
+			return nullptr;
+		}
+	}
+	// check for exportable events
+	TFieldIterator<UMulticastDelegateProperty> eventIt(Class, EFieldIteratorFlags::ExcludeSuper);
+	for ( ; eventIt; ++eventIt)
+	{
+		if (CanExportEvent(Class, *eventIt))
+		{
+			return nullptr;
 		}
-		bCanExport = bHasMembersToExport;
 	}
-	return bCanExport;
+	return TEXT("NoExportableMembers");
 }
 
 bool FCodeGenerator::CanExportStruct(const UScriptStruct* Struct)
 {
-	if (SpecialStructs.Contains(Struct->GetFName())) return false;
+	return GetStructSkipReason(Struct) == nullptr;
+}
+
+const TCHAR* FCodeGenerator::GetStructSkipReason(const UScriptStruct* Struct)
+{
+	if (SpecialStructs.Contains(Struct->GetFName())) return TEXT("CustomWrapper");
 
 	if (Struct->GetName() == L"HitResult")
 	{
@@ -148,10 +207,10 @@ bool FCodeGenerator::CanExportStruct(const UScriptStruct* Struct)
 		UProperty* property = *propertyIt;
 		if (!CanExportProperty(Struct, property))
 		{
-			return false;
+			return TEXT("UnsupportedPropertyType");
 		}
 	}
-	return true;
+	return nullptr;
 }
 
 bool FCodeGenerator::CanExportEnum(const UEnum* Enum)
@@ -160,36 +219,142 @@ bool FCodeGenerator::CanExportEnum(const UEnum* Enum)
 }
 
 bool FCodeGenerator::CanExportFunction(const UClass* Class, const UFunction* Function)
+{
+	return GetFunctionSkipReason(Class, Function) == nullptr;
+}
+
+const TCHAR* FCodeGenerator::GetFunctionSkipReason(const UClass* Class, const UFunction* Function)
 {
 	// functions from base classes should only be exported when those classes are processed
 	if (Function->GetOwnerClass() != Class)
 	{
-		return false;
+		return TEXT("Inherited");
 	}
 
 	// delegates and non-public functions are not supported yet
-	if (Function->HasAnyFunctionFlags(FUNC_Delegate | FUNC_Private | FUNC_Protected))
+	if (Function->HasAnyFunctionFlags(FUNC_Delegate))
 	{
-		return false;
+		return TEXT("Delegate");
+	}
+	if (Function->HasAnyFunctionFlags(FUNC_Private | FUNC_Protected))
+	{
+		return TEXT("NotPublic");
 	}
 
 	// don't expose functions that aren't directly accessible in a Blueprint graph
 	if (Function->GetBoolMetaData(TEXT("BlueprintInternalUseOnly")))
 	{
-		return false;
+		return TEXT("BlueprintInternalUseOnly");
+	}
+
+	if (!IsBindingUsed(Class, Function->GetName()))
+	{
+		return TEXT("Trimmed");
 	}
 
 	// check all parameter types for this function are supported
 	for (TFieldIterator<UProperty> ParamIt(Function); ParamIt; ++ParamIt)
 	{
 		// arrays that are class members are supported, but arrays that are parameters are not
-		if (ParamIt->IsA<UArrayProperty>() || !IsPropertyTypeSupported(*ParamIt))
+		if (ParamIt->IsA<UArrayProperty>())
 		{
-			return false;
+			return TEXT("ArrayParameter");
+		}
+		if (!IsPropertyTypeSupported(*ParamIt))
+		{
+			return TEXT("UnsupportedParameterType");
 		}
 	}
 
-	return true;
+	return nullptr;
+}
+
+bool FCodeGenerator::CanExportEvent(const UClass* Class, const UMulticastDelegateProperty* Property)
+{
+	return GetEventSkipReason(Class, Property) == nullptr;
+}
+
+const TCHAR* FCodeGenerator::GetEventSkipReason(const UClass* Class, const UMulticastDelegateProperty* Property)
+{
+	// events from base classes should only be exported when those classes are processed
+	if (Property->GetOwnerClass() != Class)
+	{
+		return TEXT("Inherited");
+	}
+
+	// the native side looks the delegate up by name at runtime, but the wrapper class is only 
+	// generated for DLL exported classes anyway
+	if (!(Class->ClassFlags & CLASS_RequiredAPI))
+	{
+		return TEXT("NotDllExported");
+	}
+
+	if (!Property->HasAnyFlags(RF_Public) ||
+		(Property->GetPropertyFlags() & CPF_Protected))
+	{
+		return TEXT("NotPublic");
+	}
+	// only delegates that can be bound in a Blueprint graph are meant to be bound by other objects
+	if (!(Property->GetPropertyFlags() & CPF_BlueprintAssignable))
+	{
+		return TEXT("NotAssignable");
+	}
+
+	if (!IsBindingUsed(Class, Property->GetName()))
+	{
+		return TEXT("Trimmed");
+	}
+
+	if (!Property->SignatureFunction)
+	{
+		return TEXT("UnsupportedParameterType");
+	}
+	for (TFieldIterator<UProperty> paramIt(Property->SignatureFunction); paramIt; ++paramIt)
+	{
+		if (paramIt->HasAnyPropertyFlags(CPF_Parm) && !IsEventParamTypeSupported(*paramIt))
+		{
+			return TEXT("UnsupportedParameterType");
+		}
+	}
+
+	return nullptr;
+}
+
+bool FCodeGenerator::IsEventParamTypeSupported(const UProperty* Param)
+{
+	// the handlers can't pass anything back to the caller
+	if (Param->HasAnyPropertyFlags(CPF_ReturnParm) ||
+		(Param->HasAnyPropertyFlags(CPF_OutParm) && !Param->HasAnyPropertyFlags(CPF_ConstParm)))
+	{
+		return false;
+	}
+	if (Param->ArrayDim > 1)
+	{
+		return false;
+	}
+	if (Param->IsA<UStructProperty>())
+	{
+		return IsStructPropertyTypeSupported(CastChecked<UStructProperty>(Param));
+	}
+	return Param->IsA<UIntProperty>()
+		|| Param->IsA<UFloatProperty>()
+		|| Param->IsA<UBoolProperty>()
+		|| Param->IsA<UStrProperty>()
+		|| (Param->IsA<UObjectProperty>() && !Param->IsA<UClassProperty>());
+}
+
+bool FCodeGenerator::IsBindingUsed(const UClass* Class, const FString& MemberName)
+{
+	const FConfig& config = GetConig();
+	if (!config.bTrimUnusedBindings)
+	{
+		return true;
+	}
+
+	// the names used here are the names of the C# wrapper classes and their members
+	const FString className = FString(Class->GetPrefixCPP()) + Class->GetName();
+	return config.UsedBindings.Contains(className)
+		|| config.UsedBindings.Contains(className + TEXT(".") + MemberName);
 }
 
 bool FCodeGenerator::IsPropertyTypeSupported(const UProperty* Property)
@@ -213,15 +378,16 @@ bool FCodeGenerator::IsPropertyTypeSupported(const UProperty* Property)
 			// TArray<TSubclassOf<UWhatever>> is not currently supported
 			bSupported = false;
 		}
+		else if (auto innerStructProp = Cast<UStructProperty>(arrayProp->Inner))
+		{
+			// elements of struct arrays are copied in and out of the native array as raw memory,
+			// so only structs that don't own any memory can be wrapped
+			bSupported = IsPropertyTypeSupported(innerStructProp)
+				&& IsStructArrayElementSupported(innerStructProp->Struct);
+		}
 		else
 		{
 			bSupported = IsPropertyTypeSupported(arrayProp->Inner);
-
-			// For now, we don't support arrays of structs
-			if (arrayProp->Inner->IsA<UStructProperty>())
-			{
-				bSupported = false;
-			}
 		}
 	}
 	else if (Property->IsA<UStructProperty>())
@@ -268,6 +434,9 @@ bool FCodeGenerator::IsPropertyTypeSupported(const UProperty* Property)
 		FString typeName = FCodeGenerator::GetPropertyCPPType(Property);
 		typeName.RemoveFromEnd(pointer);
 
+		// NOTE: This may be called from the worker threads that generate the wrappers, the UObject
+		//       hash tables FindObject() looks in are guarded by a lock so that's fine as long as
+		//       no new objects are created during generation.
 		UClass* cl = FindObject<UClass>(nullptr, *typeName);
 		if (cl)
 		{
@@ -297,6 +466,44 @@ bool FCodeGenerator::IsStructPropertyTypeSupported(const UStructProperty* Proper
 	return SpecialStructs.Contains(typeName) || CanExportStruct(Property->Struct);
 }
 
+bool FCodeGenerator::IsStructArrayElementSupported(const UScriptStruct* Struct)
+{
+	// NOTE: The fields are checked directly because STRUCT_IsPlainOldData is derived from the
+	//       native struct ops, which aren't available while UHT is running.
+	for (TFieldIterator<UProperty> propIt(Struct); propIt; ++propIt)
+	{
+		const UProperty* field = *propIt;
+		if (field->ArrayDim > 1)
+		{
+			return false;
+		}
+		if (auto structField = Cast<UStructProperty>(field))
+		{
+			if (!IsStructArrayElementSupported(structField->Struct))
+			{
+				return false;
+			}
+		}
+		else if (auto boolField = Cast<UBoolProperty>(field))
+		{
+			// native bools are marshaled as U1, which makes the C# struct non-blittable
+			if (boolField->IsNativeBool())
+			{
+				return false;
+			}
+		}
+		else if (!field->IsA<UNumericProperty>() &&
+			!field->IsA<UNameProperty>() &&
+			!field->IsA<UObjectProperty>() &&
+			!field->IsA<UWeakObjectProperty>())
+		{
+			// strings, arrays, maps, asset pointers etc. own memory
+			return false;
+		}
+	}
+	return true;
+}
+
 bool FCodeGenerator::CanExportProperty(const UScriptStruct* Struct, const UProperty* Property)
 {
 	// only public, editable properties can be exported
@@ -313,39 +520,94 @@ bool FCodeGenerator::CanExportProperty(const UScriptStruct* Struct, const UPrope
 }
 
 bool FCodeGenerator::CanExportProperty(const UClass* Class, const UProperty* Property)
+{
+	return GetPropertySkipReason(Class, Property) == nullptr;
+}
+
+const TCHAR* FCodeGenerator::GetPropertySkipReason(const UClass* Class, const UProperty* Property)
 {
 	// properties from base classes should only be exported when those classes are processed
 	if (Property->GetOwnerClass() != Class)
 	{
-		return false;
+		return TEXT("Inherited");
 	}
 
 	// property must be DLL exported (well, not really, will remove this later)
 	if (!(Class->ClassFlags & CLASS_RequiredAPI))
 	{
-		return false;
+		return TEXT("NotDllExported");
 	}
 
 	// only public, editable properties can be exported
 	if (!Property->HasAnyFlags(RF_Public) ||
-		(Property->GetPropertyFlags() & CPF_Protected) ||
-		!(Property->GetPropertyFlags() & CPF_Edit))
+		(Property->GetPropertyFlags() & CPF_Protected))
 	{
-		return false;
+		return TEXT("NotPublic");
+	}
+	if (!(Property->GetPropertyFlags() & CPF_Edit))
+	{
+		return TEXT("NotEditable");
 	}
 
-	return IsPropertyTypeSupported(Property);
+	if (!IsBindingUsed(Class, Property->GetName()))
+	{
+		return TEXT("Trimmed");
+	}
+
+	return IsPropertyTypeSupported(Property) ? nullptr : TEXT("UnsupportedType");
+}
+
+void FCodeGenerator::ReportClassMembers(const UClass* Class, bool bCanExport)
+{
+	const FString moduleName = FCodeGeneratorReport::GetModuleName(Class);
+	for (TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper); funcIt; ++funcIt)
+	{
+		const TCHAR* skipReason = bCanExport 
+			? GetFunctionSkipReason(Class, *funcIt) : TEXT("ClassNotExported");
+		if (skipReason)
+		{
+			Report.AddSkipped(moduleName, TEXT("Function"), skipReason);
+		}
+		else
+		{
+			Report.AddExported(moduleName, TEXT("Function"));
+		}
+	}
+	for (TFieldIterator<UProperty> propertyIt(Class, EFieldIteratorFlags::ExcludeSuper); propertyIt; ++propertyIt)
+	{
+		// dynamic multicast delegates are exported as events rather than properties
+		auto eventProperty = Cast<UMulticastDelegateProperty>(*propertyIt);
+		const TCHAR* category = eventProperty ? TEXT("Event") : TEXT("Property");
+		const TCHAR* skipReason = TEXT("ClassNotExported");
+		if (bCanExport)
+		{
+			skipReason = eventProperty 
+				? GetEventSkipReason(Class, eventProperty) : GetPropertySkipReason(Class, *propertyIt);
+		}
+		if (skipReason)
+		{
+			Report.AddSkipped(moduleName, category, skipReason);
+		}
+		else
+		{
+			Report.AddExported(moduleName, category);
+		}
+	}
 }
 
 void FCodeGenerator::ExportClass(UClass* Class, const FString& SourceHeaderFilename, const FString& GeneratedHeaderFilename, bool bHasChanged){
+	FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("Queue"));
+
 	if (Class->HasAnyClassFlags(CLASS_Deprecated))
     {
+		Report.AddSkipped(FCodeGeneratorReport::GetModuleName(Class), TEXT("Class"), TEXT("Deprecated"));
 		return;
 	}
 
-    auto config = GetConig();
+    const auto& config = GetConig();
 
     if(config.Excluded.Contains(FPaths::GetCleanFilename(SourceHeaderFilename))) {
+        Report.AddSkipped(FCodeGeneratorReport::GetModuleName(Class), TEXT("Class"), TEXT("ExcludedHeader"));
         return;
     }
 
@@ -366,21 +628,21 @@ void FCodeGenerator::ExportClass(UClass* Class, const FString& SourceHeaderFilen
 	// still be used as a function parameter in a function that is exported by another class
 	AllExportedClasses.Add(Class);
 	
-	FCodeFormatter nativeGlueCode(TEXT('\t'), 1);
-	FCodeFormatter managedGlueCode(TEXT(' '), 4);
-	FNativeWrapperGenerator nativeWrapperGenerator(Class, nativeGlueCode);
-	FCSharpWrapperGenerator csharpWrapperGenerator(
-		Class, 
-		FCSharpWrapperGenerator::GetWrapperSuperClass(Class, AllExportedClasses), 
-		managedGlueCode
-	);
-
-	bool bCanExport = CanExportClass(Class);
+	const UClass* wrapperSuperClass = FCSharpWrapperGenerator::GetWrapperSuperClass(Class, AllExportedClasses);
+	const TCHAR* skipReason = GetClassSkipReason(Class);
+	const bool bCanExport = (skipReason == nullptr);
+	const FString moduleName = FCodeGeneratorReport::GetModuleName(Class);
 	if (bCanExport)
 	{
 		ClassesWithNativeWrappers.Add(Class);
-		nativeWrapperGenerator.GenerateHeader();
+		Report.AddExported(moduleName, TEXT("Class"));
+	}
+	else
+	{
+		// the class still gets a C# wrapper, but no native wrapper functions
+		Report.AddSkipped(moduleName, TEXT("Class"), skipReason);
 	}
+	ReportClassMembers(Class, bCanExport);
 
 	// some internal classes like UObjectProperty don't have an associated source header file,
 	// no native wrapper functions are generated for those types, and perhaps we shouldn't generate
@@ -393,13 +655,137 @@ void FCodeGenerator::ExportClass(UClass* Class, const FString& SourceHeaderFilen
 		//       will fail. The compilation error is usually a cryptic error C2664, and occurs while 
 		//       attempting to upcast a pointer to the class into a UObject*, this fails because the
 		//       class is only forward declared at that point and as such the compiler is unaware that
-		//       the class is derived from UObject.
+		//       the class is derived from UObject. GetNativeWrapperSourceHeaders() works out
+		//       which headers each native glue shard needs.
 		AllSourceClassHeaders.Add(SourceHeaderFilename);
+		ClassSourceHeaders.Add(Class, SourceHeaderFilename);
+		const FString modulePathKey = GetModulePathKey(Class);
+		if (!modulePathKey.IsEmpty())
+		{
+			SourceHeadersByModulePath.Add(modulePathKey, SourceHeaderFilename);
+		}
+	}
+
+	const FString nativeGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".klawr.h"));
+	const FString managedGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".cs"));
+
+	// NOTE: bHasChanged only indicates whether the header the class was declared in changed, but
+	//       the generated wrappers also depend on other types (e.g. whether a struct used by a
+	//       function can be exported), so the manifest is used to figure out if anything changed.
+	const FString typeKey = FString(TEXT("Class:")) + Class->GetName();
+	const FString inputHash = FCodeGeneratorManifest::HashInputs(
+		GetClassInputs(Class, SourceHeaderFilename, wrapperSuperClass, bCanExport)
+	);
+	FPendingExport& pendingExport = PendingExports[PendingExports.AddDefaulted()];
+	pendingExport.Kind = EPendingExportKind::Class;
+	pendingExport.Type = Class;
+	pendingExport.WrapperSuperClass = wrapperSuperClass;
+	pendingExport.bCanExport = bCanExport;
+	pendingExport.NativeGlueFilename = nativeGlueFilename;
+	pendingExport.ManagedGlueFilename = managedGlueFilename;
+	pendingExport.TypeKey = typeKey;
+	pendingExport.InputHash = inputHash;
+	pendingExport.bIsUpToDate = Manifest.IsUpToDate(typeKey, inputHash)
+		&& FPaths::FileExists(managedGlueFilename)
+		&& (!bCanExport || FPaths::FileExists(nativeGlueFilename));
+}
+
+void FCodeGenerator::ExportStruct(UScriptStruct* Struct) {
+	FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("Queue"));
+	const auto& config = GetConig();
+
+
+	if (AllExportedStructs.Contains(Struct))
+	{
+		// already processed
+		return;
+	}
+
+	if (!Struct) {
+		return;
+	}
+
+	const FString moduleName = FCodeGeneratorReport::GetModuleName(Struct);
+	if (const TCHAR* skipReason = GetStructSkipReason(Struct))
+	{
+		Report.AddSkipped(moduleName, TEXT("Struct"), skipReason);
+		return;
+	}
+	Report.AddExported(moduleName, TEXT("Struct"));
+
+	UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Exporting struct %s"), *Struct->GetName());
+
+	// even if a class can't be properly exported generate a C# wrapper for it, because it may 
+	// still be used as a function parameter in a function that is exported by another class
+	AllExportedStructs.Add(Struct);
+
+	const FString managedGlueFilename = GeneratedCodePath / (Struct->GetName() + TEXT(".cs"));
+	const FString typeKey = FString(TEXT("Struct:")) + Struct->GetName();
+	const FString inputHash = FCodeGeneratorManifest::HashInputs(GetStructInputs(Struct));
+	FPendingExport& pendingExport = PendingExports[PendingExports.AddDefaulted()];
+	pendingExport.Kind = EPendingExportKind::Struct;
+	pendingExport.Type = Struct;
+	pendingExport.ManagedGlueFilename = managedGlueFilename;
+	pendingExport.TypeKey = typeKey;
+	pendingExport.InputHash = inputHash;
+	pendingExport.bIsUpToDate = 
+		Manifest.IsUpToDate(typeKey, inputHash) && FPaths::FileExists(managedGlueFilename);
+}
+
+void FCodeGenerator::ExportEnum(UEnum* Enum) {
+	FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("Queue"));
+	const auto& config = GetConig();
+
+
+	if (AllExportedEnums.Contains(Enum) || !CanExportEnum(Enum))
+	{
+		// already processed
+		return;
+	}
+
+	if (!Enum) {
+		return;
+	}
+
+	UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Exporting enum %s"), *Enum->GetName());
+	Report.AddExported(FCodeGeneratorReport::GetModuleName(Enum), TEXT("Enum"));
+
+	// even if a class can't be properly exported generate a C# wrapper for it, because it may 
+	// still be used as a function parameter in a function that is exported by another class
+	AllExportedEnums.Add(Enum);
+
+	const FString managedGlueFilename = GeneratedCodePath / (Enum->GetName() + TEXT(".cs"));
+	const FString typeKey = FString(TEXT("Enum:")) + Enum->GetName();
+	const FString inputHash = FCodeGeneratorManifest::HashInputs(GetEnumInputs(Enum));
+	FPendingExport& pendingExport = PendingExports[PendingExports.AddDefaulted()];
+	pendingExport.Kind = EPendingExportKind::Enum;
+	pendingExport.Type = Enum;
+	pendingExport.ManagedGlueFilename = managedGlueFilename;
+	pendingExport.TypeKey = typeKey;
+	pendingExport.InputHash = inputHash;
+	pendingExport.bIsUpToDate = 
+		Manifest.IsUpToDate(typeKey, inputHash) && FPaths::FileExists(managedGlueFilename);
+}
+
+bool FCodeGenerator::GenerateClassWrappers(const FPendingExport& Export)
+{
+	const UClass* Class = CastChecked<UClass>(Export.Type);
+
+	FCodeFormatter nativeGlueCode(TEXT('\t'), 1);
+	FCodeFormatter managedGlueCode(TEXT(' '), 4);
+	FNativeWrapperGenerator nativeWrapperGenerator(Class, nativeGlueCode);
+	FCSharpWrapperGenerator csharpWrapperGenerator(
+		Class, Export.WrapperSuperClass, managedGlueCode
+	);
+
+	if (Export.bCanExport)
+	{
+		nativeWrapperGenerator.GenerateHeader();
 	}
 	
 	csharpWrapperGenerator.GenerateHeader();
 		
-	if (bCanExport)
+	if (Export.bCanExport)
 	{
 		// export functions
 		TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper);
@@ -442,51 +828,43 @@ void FCodeGenerator::ExportClass(UClass* Class, const FString& SourceHeaderFilen
 			}
 		}
 
+		// export events, these are bound through the event trampoline in the runtime plugin 
+		// so they don't need any native wrapper functions
+		TFieldIterator<UMulticastDelegateProperty> eventIt(Class, EFieldIteratorFlags::ExcludeSuper);
+		for ( ; eventIt; ++eventIt)
+		{
+			if (CanExportEvent(Class, *eventIt))
+			{
+				csharpWrapperGenerator.GenerateEventWrapper(*eventIt);
+			}
+		}
+
 		if (nativeWrapperGenerator.GetPropertyCount() != csharpWrapperGenerator.GetPropertyCount())
 		{
-            UE_LOG(LogKlawrCodeGenerator, Log, TEXT("ERROR: Native and C# property wrapper count doesn't match!"));
-            return;
+            UE_LOG(LogKlawrCodeGenerator, Log, TEXT("ERROR: Native and C# property wrapper count doesn't match for %s!"), *Class->GetName());
+            return false;
 		}
 
 		if (nativeWrapperGenerator.GetFunctionCount() != csharpWrapperGenerator.GetFunctionCount())
 		{
-            UE_LOG(LogKlawrCodeGenerator, Log, TEXT("ERROR: Native and C# function wrapper count doesn't match!"));
-            return;
+            UE_LOG(LogKlawrCodeGenerator, Log, TEXT("ERROR: Native and C# function wrapper count doesn't match for %s!"), *Class->GetName());
+            return false;
         }
 
 		nativeWrapperGenerator.GenerateFooter();
 				
-		const FString nativeGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".klawr.h"));
-		AllScriptHeaders.Add(nativeGlueFilename);
-		WriteToFile(nativeGlueFilename, nativeGlueCode.Content);
+		WriteToFile(Export.NativeGlueFilename, nativeGlueCode);
 	}
     
     csharpWrapperGenerator.GenerateFooter();
 
-	const FString managedGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".cs"));
-	AllManagedWrapperFiles.Add(managedGlueFilename);
-	WriteToFile(managedGlueFilename, managedGlueCode.Content);
+	WriteToFile(Export.ManagedGlueFilename, managedGlueCode);
+	return true;
 }
 
-void FCodeGenerator::ExportStruct(UScriptStruct* Struct) {
-	auto config = GetConig();
-
-
-	if (AllExportedStructs.Contains(Struct) || !CanExportStruct(Struct))
-	{
-		// already processed
-		return;
-	}
-
-	if (!Struct) {
-		return;
-	}
-
-	UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Exporting struct %s"), *Struct->GetName());
-
-	// even if a class can't be properly exported generate a C# wrapper for it, because it may 
-	// still be used as a function parameter in a function that is exported by another class
-	AllExportedStructs.Add(Struct);
+bool FCodeGenerator::GenerateStructWrappers(const FPendingExport& Export)
+{
+	const UScriptStruct* Struct = CastChecked<UScriptStruct>(Export.Type);
 
 	// FCodeFormatter nativeGlueCode(TEXT('\t'), 1);
 	FCodeFormatter managedGlueCode(TEXT(' '), 4);
@@ -516,34 +894,17 @@ void FCodeGenerator::ExportStruct(UScriptStruct* Struct) {
 
 	// const FString nativeGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".klawr.h"));
 	// AllScriptHeaders.Add(nativeGlueFilename);
-	// WriteToFile(nativeGlueFilename, nativeGlueCode.Content);
+	// WriteToFile(nativeGlueFilename, nativeGlueCode);
 
 	csharpWrapperGenerator.GenerateFooter();
 
-	const FString managedGlueFilename = GeneratedCodePath / (Struct->GetName() + TEXT(".cs"));
-	AllManagedWrapperFiles.Add(managedGlueFilename);
-	WriteToFile(managedGlueFilename, managedGlueCode.Content);
+	WriteToFile(Export.ManagedGlueFilename, managedGlueCode);
+	return true;
 }
 
-void FCodeGenerator::ExportEnum(UEnum* Enum) {
-	auto config = GetConig();
-
-
-	if (AllExportedEnums.Contains(Enum) || !CanExportEnum(Enum))
-	{
-		// already processed
-		return;
-	}
-
-	if (!Enum) {
-		return;
-	}
-
-	UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Exporting enum %s"), *Enum->GetName());
-
-	// even if a class can't be properly exported generate a C# wrapper for it, because it may 
-	// still be used as a function parameter in a function that is exported by another class
-	AllExportedEnums.Add(Enum);
+bool FCodeGenerator::GenerateEnumWrappers(const FPendingExport& Export)
+{
+	const UEnum* Enum = CastChecked<UEnum>(Export.Type);
 
 	// FCodeFormatter nativeGlueCode(TEXT('\t'), 1);
 	FCodeFormatter managedGlueCode(TEXT(' '), 4);
@@ -569,17 +930,86 @@ void FCodeGenerator::ExportEnum(UEnum* Enum) {
 
 	// const FString nativeGlueFilename = GeneratedCodePath / (Class->GetName() + TEXT(".klawr.h"));
 	// AllScriptHeaders.Add(nativeGlueFilename);
-	// WriteToFile(nativeGlueFilename, nativeGlueCode.Content);
+	// WriteToFile(nativeGlueFilename, nativeGlueCode);
 
 	csharpWrapperGenerator.GenerateFooter();
 
-	const FString managedGlueFilename = GeneratedCodePath / (Enum->GetName() + TEXT(".cs"));
-	AllManagedWrapperFiles.Add(managedGlueFilename);
-	WriteToFile(managedGlueFilename, managedGlueCode.Content);
+	WriteToFile(Export.ManagedGlueFilename, managedGlueCode);
+	return true;
+}
+
+void FCodeGenerator::GeneratePendingExports()
+{
+	// Generating the wrappers only involves reading reflection data and building strings, and
+	// each type is written to its own files, so types can be processed in parallel. The results
+	// are then gathered in the order the types were exported in, so the aggregate files are the
+	// same regardless of which jobs finished first.
+	const bool bSingleThreaded = !GetConig().bParallelGeneration
+		|| !FTaskGraphInterface::IsRunning() || !FPlatformProcess::SupportsMultithreading();
+
+	const double startTime = FPlatformTime::Seconds();
+
+	ParallelFor(PendingExports.Num(), [this](int32 exportIndex)
+	{
+		FPendingExport& pendingExport = PendingExports[exportIndex];
+		if (pendingExport.bIsUpToDate)
+		{
+			return;
+		}
+		switch (pendingExport.Kind)
+		{
+			case EPendingExportKind::Class:
+				pendingExport.bGenerated = GenerateClassWrappers(pendingExport);
+				break;
+			case EPendingExportKind::Struct:
+				pendingExport.bGenerated = GenerateStructWrappers(pendingExport);
+				break;
+			case EPendingExportKind::Enum:
+				pendingExport.bGenerated = GenerateEnumWrappers(pendingExport);
+				break;
+		}
+	}, bSingleThreaded);
+
+	// log enough to compare the cost of generation between changes to the generators
+	const FPlatformMemoryStats memoryStats = FPlatformMemory::GetStats();
+	UE_LOG(
+		LogKlawrCodeGenerator, Log, 
+		TEXT("Generating wrappers took %.2f seconds (%s), peak memory usage is %.1f MB."),
+		FPlatformTime::Seconds() - startTime, 
+		bSingleThreaded ? TEXT("single-threaded") : TEXT("parallel"),
+		memoryStats.PeakUsedPhysical / (1024.0 * 1024.0)
+	);
+
+	for (const FPendingExport& pendingExport : PendingExports)
+	{
+		if (pendingExport.bIsUpToDate)
+		{
+			++NumUpToDateTypes;
+		}
+		else if (pendingExport.bGenerated)
+		{
+			++NumGeneratedTypes;
+		}
+		else
+		{
+			// the manifest isn't updated so generation will be attempted again next time
+			continue;
+		}
+		const FString moduleName = FCodeGeneratorReport::GetModuleName(pendingExport.Type);
+		if ((pendingExport.Kind == EPendingExportKind::Class) && pendingExport.bCanExport)
+		{
+			AllScriptHeaders.Add(pendingExport.NativeGlueFilename);
+			Report.AddGeneratedFile(moduleName, pendingExport.NativeGlueFilename, false);
+		}
+		AllManagedWrapperFiles.Add(pendingExport.ManagedGlueFilename);
+		Report.AddGeneratedFile(moduleName, pendingExport.ManagedGlueFilename, true);
+		Manifest.Update(pendingExport.TypeKey, pendingExport.InputHash);
+	}
+	PendingExports.Empty();
 }
 
 bool FCodeGenerator::GenerateManagedWrapperProject(){
-    auto config = GetConig();
+    const auto& config = GetConig();
 
     const FString resourcesBasePath = config.WrapperProjectTemplatePath;
 	const FString projectBasePath = config.WrapperProjectCopyPath;
@@ -597,7 +1027,7 @@ bool FCodeGenerator::GenerateManagedWrapperProject(){
         return false;
 	}
 
-	const FString projectName("Klawr.UnrealEngine.csproj");
+	const FString projectName(ManagedWrapperProjectFilename);
 	const FString projectTemplateFilename = resourcesBasePath / projectName;
 	const FString projectOutputFilename = projectBasePath / projectName;
 
@@ -630,7 +1060,21 @@ bool FCodeGenerator::GenerateManagedWrapperProject(){
 
 		// include all the generated C# wrapper classes in the project file
 		auto sourceNode = xmlDoc.first_element_by_path(TEXT("/Project/ItemGroup/Compile")).parent();
-		if (sourceNode)
+		if (sourceNode && GetConig().bWildcardWrapperInclude)
+		{
+			// one item instead of thousands keeps the project quick for MSBuild to load, but the
+			// wildcard would also match the wrappers of types that are no longer exported
+			DeleteStaleManagedWrapperFiles();
+
+			FString includePattern = GeneratedCodePath / TEXT("*.cs");
+			FPaths::MakePathRelativeTo(includePattern, *projectOutputFilename);
+			FPaths::MakePlatformFilename(includePattern);
+
+			auto compileNode = sourceNode.append_child(TEXT("Compile"));
+			compileNode.append_attribute(TEXT("Include")) = *includePattern;
+			compileNode.append_child(TEXT("Link")).text() = TEXT("Generated\\%(Filename)%(Extension)");
+		}
+		else if (sourceNode)
 		{
 			FString linkFilename;
 			for (FString managedGlueFilename : AllManagedWrapperFiles)
@@ -674,10 +1118,30 @@ bool FCodeGenerator::GenerateManagedWrapperProject(){
     return true;
 }
 
+void FCodeGenerator::DeleteStaleManagedWrapperFiles() const
+{
+	TSet<FString> currentFilenames;
+	for (const FString& managedFilename : AllManagedWrapperFiles)
+	{
+		currentFilenames.Add(FPaths::GetCleanFilename(managedFilename));
+	}
+
+	TArray<FString> foundFilenames;
+	IFileManager::Get().FindFiles(foundFilenames, *(GeneratedCodePath / TEXT("*.cs")), true, false);
+	for (const FString& foundFilename : foundFilenames)
+	{
+		if (!currentFilenames.Contains(foundFilename))
+		{
+			UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Deleting stale wrapper %s"), *foundFilename);
+			IFileManager::Get().Delete(*(GeneratedCodePath / foundFilename));
+		}
+	}
+}
+
 void FCodeGenerator::BuildManagedWrapperProject()
 {
     UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Start building wrapper project"));
-    auto config = GetConig();
+    const auto& config = GetConig();
 
     FString buildFilename = config.WrapperProjectCopyPath / TEXT("Build.bat");
 	FPaths::CollapseRelativeDirectories(buildFilename);
@@ -698,61 +1162,437 @@ void FCodeGenerator::BuildManagedWrapperProject()
 
 void FCodeGenerator::FinishExport()
 {
-    GlueAllNativeWrapperFiles();
-    if(!GenerateManagedWrapperProject()){
-        return;
-    };
-	BuildManagedWrapperProject();
+	{
+		FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("Generate"));
+		GeneratePendingExports();
+	}
+	Report.SetTypeCounts(NumGeneratedTypes, NumUpToDateTypes);
+
+	UE_LOG(
+		LogKlawrCodeGenerator, Log, TEXT("Generated wrappers for %d types, %d types were up to date."),
+		NumGeneratedTypes, NumUpToDateTypes
+	);
+
+	// the aggregate files only need to be regenerated when the set of exported types changes
+	const FString exportSetHash = FCodeGeneratorManifest::HashInputs(GetExportSetInputs());
+	const FString glueFilename = GeneratedCodePath / NativeGlueFilename;
+	const FString projectFilename = GetConig().WrapperProjectCopyPath / ManagedWrapperProjectFilename;
+	bool bGlueFilesExist = FPaths::FileExists(glueFilename);
+	for (int32 shardIndex = 0; bGlueFilesExist && (shardIndex < MaxNativeGlueShards); ++shardIndex)
+	{
+		bGlueFilesExist = FPaths::FileExists(GetNativeGlueShardFilename(shardIndex));
+	}
+	if (Manifest.IsExportSetUpToDate(exportSetHash) 
+		&& bGlueFilesExist && FPaths::FileExists(projectFilename))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Set of exported types is unchanged, skipping %s and %s."), *glueFilename, *projectFilename);
+		Manifest.UpdateExportSet(exportSetHash);
+	}
+	else
+	{
+		{
+			FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("NativeGlue"));
+			GlueAllNativeWrapperFiles();
+		}
+		bool bGeneratedProject;
+		{
+			FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("ManagedProject"));
+			bGeneratedProject = GenerateManagedWrapperProject();
+		}
+		if (!bGeneratedProject)
+		{
+			// don't record the export set so the aggregate files will be regenerated next time
+			Manifest.Save();
+			SaveReport();
+			return;
+		}
+		Manifest.UpdateExportSet(exportSetHash);
+	}
+	Manifest.Save();
+	{
+		FCodeGeneratorReport::FScopedPhaseTimer phaseTimer(Report, TEXT("Build"));
+		BuildManagedWrapperProject();
+	}
+	SaveReport();
+}
+
+void FCodeGenerator::SaveReport()
+{
+	Report.AddAggregateFile(GeneratedCodePath / NativeGlueFilename);
+	for (int32 shardIndex = 0; shardIndex < MaxNativeGlueShards; ++shardIndex)
+	{
+		Report.AddAggregateFile(GetNativeGlueShardFilename(shardIndex));
+	}
+	Report.AddAggregateFile(GetConig().WrapperProjectCopyPath / ManagedWrapperProjectFilename);
+
+	const FString reportFilename = GeneratedCodePath / ReportFilename;
+	if (Report.Save(reportFilename))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Saved code generation report to %s"), *reportFilename);
+	}
+}
+
+FString FCodeGenerator::GetExportSetInputs() const
+{
+	FString inputs = FString::Printf(TEXT("NativeGlueShards %d\n"), GetNumNativeGlueShards());
+	inputs += FString::Printf(TEXT("WildcardWrapperInclude %d\n"), GetConig().bWildcardWrapperInclude ? 1 : 0);
+	for (const UClass* wrappedClass : ClassesWithNativeWrappers)
+	{
+		inputs += FString::Printf(TEXT("NativeWrapper %s%s\n"), wrappedClass->GetPrefixCPP(), *wrappedClass->GetName());
+		// the shard the class is in includes these, so they have to be kept up to date too
+		TSet<FString> wrapperHeaders;
+		GetNativeWrapperSourceHeaders(wrappedClass, wrapperHeaders);
+		for (const FString& headerFilename : AllSourceClassHeaders)
+		{
+			if (wrapperHeaders.Contains(headerFilename))
+			{
+				inputs += FString::Printf(TEXT("  Includes %s\n"), *headerFilename);
+			}
+		}
+	}
+	for (const FString& headerFilename : AllSourceClassHeaders)
+	{
+		inputs += FString::Printf(TEXT("SourceHeader %s\n"), *headerFilename);
+	}
+	for (const FString& headerFilename : AllScriptHeaders)
+	{
+		inputs += FString::Printf(TEXT("ScriptHeader %s\n"), *headerFilename);
+	}
+	for (const FString& managedFilename : AllManagedWrapperFiles)
+	{
+		inputs += FString::Printf(TEXT("ManagedWrapper %s\n"), *managedFilename);
+	}
+	// the struct layouts are registered by the native glue
+	for (const UScriptStruct* exportedStruct : AllExportedStructs)
+	{
+		inputs += FString::Printf(TEXT("StructLayout %s\n"), *exportedStruct->GetName());
+		for (TFieldIterator<UProperty> propertyIt(exportedStruct); propertyIt; ++propertyIt)
+		{
+			inputs += FString::Printf(
+				TEXT("  %s %s\n"), *propertyIt->GetName(), 
+				*FCSharpStructWrapperGenerator::GetManagedFieldName(*propertyIt)
+			);
+		}
+	}
+	return inputs;
+}
+
+namespace 
+{
+	/** Append a description of a property that affects the generated wrappers to Inputs. */
+	void AppendPropertyInputs(const UProperty* Property, FString& Inputs)
+	{
+		Inputs += FString::Printf(
+			TEXT("  %s %s %s %llu"), 
+			*Property->GetClass()->GetName(), *FCodeGenerator::GetPropertyCPPType(Property),
+			*Property->GetName(), static_cast<uint64>(Property->PropertyFlags)
+		);
+		if (auto arrayProperty = Cast<UArrayProperty>(Property))
+		{
+			Inputs += FString::Printf(
+				TEXT(" [%s %s]"), *arrayProperty->Inner->GetClass()->GetName(), 
+				*FCodeGenerator::GetPropertyCPPType(arrayProperty->Inner)
+			);
+		}
+		Inputs += TEXT("\n");
+	}
+} // unnamed namespace
+
+FString FCodeGenerator::GetClassInputs(
+	const UClass* Class, const FString& SourceHeaderFilename, const UClass* WrapperSuperClass, 
+	bool bCanExport
+)
+{
+	FString inputs = FString::Printf(
+		TEXT("Class %s%s %u %s\nSuper %s\nCanExport %d\n"),
+		Class->GetPrefixCPP(), *Class->GetName(), static_cast<uint32>(Class->ClassFlags), 
+		*SourceHeaderFilename, WrapperSuperClass ? *WrapperSuperClass->GetName() : TEXT(""),
+		bCanExport ? 1 : 0
+	);
+	if (!bCanExport)
+	{
+		// only the C# class declaration is generated in this case
+		return inputs;
+	}
+
+	for (TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper); funcIt; ++funcIt)
+	{
+		const UFunction* function = *funcIt;
+		if (CanExportFunction(Class, function))
+		{
+			inputs += FString::Printf(
+				TEXT("Function %s %u\n"), *function->GetName(), 
+				static_cast<uint32>(function->FunctionFlags)
+			);
+			for (TFieldIterator<UProperty> paramIt(function); paramIt; ++paramIt)
+			{
+				AppendPropertyInputs(*paramIt, inputs);
+			}
+		}
+	}
+
+	for (TFieldIterator<UProperty> propertyIt(Class, EFieldIteratorFlags::ExcludeSuper); propertyIt; ++propertyIt)
+	{
+		const UProperty* property = *propertyIt;
+		if (CanExportProperty(Class, property))
+		{
+			inputs += TEXT("Property\n");
+			AppendPropertyInputs(property, inputs);
+		}
+	}
+
+	for (TFieldIterator<UMulticastDelegateProperty> eventIt(Class, EFieldIteratorFlags::ExcludeSuper); eventIt; ++eventIt)
+	{
+		const UMulticastDelegateProperty* eventProperty = *eventIt;
+		if (CanExportEvent(Class, eventProperty))
+		{
+			inputs += FString::Printf(TEXT("Event %s\n"), *eventProperty->GetName());
+			for (TFieldIterator<UProperty> paramIt(eventProperty->SignatureFunction); paramIt; ++paramIt)
+			{
+				AppendPropertyInputs(*paramIt, inputs);
+			}
+		}
+	}
+	return inputs;
+}
+
+FString FCodeGenerator::GetStructInputs(const UScriptStruct* Struct)
+{
+	FString inputs = FString::Printf(
+		TEXT("Struct %s%s %d\n"), Struct->GetPrefixCPP(), *Struct->GetName(), 
+		Struct->GetStructureSize()
+	);
+	for (TFieldIterator<UProperty> propertyIt(Struct); propertyIt; ++propertyIt)
+	{
+		// the C# struct fields are placed at explicit offsets
+		const UProperty* property = *propertyIt;
+		inputs += FString::Printf(TEXT("  Offset %d"), property->GetOffset_ForInternal());
+		if (auto boolProperty = Cast<UBoolProperty>(property))
+		{
+			inputs += FString::Printf(
+				TEXT(" Bool %d %d %d"), boolProperty->IsNativeBool() ? 1 : 0, 
+				boolProperty->GetByteOffset(), boolProperty->GetFieldMask()
+			);
+		}
+		AppendPropertyInputs(property, inputs);
+	}
+	return inputs;
+}
+
+FString FCodeGenerator::GetEnumInputs(const UEnum* Enum)
+{
+	FString inputs = FString::Printf(TEXT("Enum %s\n"), *Enum->GetName());
+	for (int32 i = 0; i < Enum->GetMaxEnumValue(); ++i)
+	{
+		inputs += FString::Printf(TEXT("  %d %s\n"), i, *Enum->GetNameByIndex(i).ToString());
+	}
+	return inputs;
+}
+
+int32 FCodeGenerator::GetNumNativeGlueShards()
+{
+	return FMath::Clamp(GetConig().NumNativeGlueShards, 1, MaxNativeGlueShards);
+}
+
+FString FCodeGenerator::GetNativeGlueShardFilename(int32 ShardIndex) const
+{
+	return GeneratedCodePath / FString::Printf(TEXT("KlawrGeneratedNativeWrappers_%d.inl"), ShardIndex);
 }
 
 void FCodeGenerator::GlueAllNativeWrapperFiles()
 {
     UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Start GlueAllNativeWrapperFiles"));
-    
-    // generate the file that will be included by ScriptPlugin.cpp
-	FString glueFilename = GeneratedCodePath / TEXT("KlawrGeneratedNativeWrappers.inl");
+
+	// Each class is assigned to a shard based on its name rather than its position in the list, 
+	// that way adding or removing a class doesn't move other classes to a different shard and
+	// force those shards to be recompiled.
+	const int32 numShards = GetNumNativeGlueShards();
+	TArray<TArray<const UClass*>> shardClasses;
+	shardClasses.SetNum(MaxNativeGlueShards);
+	for (auto wrappedClass : ClassesWithNativeWrappers)
+	{
+		const FString className = wrappedClass->GetName();
+		// skip classes whose native wrappers couldn't be generated
+		if (AllScriptHeaders.Contains(GeneratedCodePath / (className + TEXT(".klawr.h"))))
+		{
+			const int32 shardIndex = FCrc::StrCrc32(*className) % numShards;
+			shardClasses[shardIndex].Add(wrappedClass);
+		}
+	}
+
+	// Every shard file is generated even if the configured number of shards is lower than the 
+	// maximum, because the runtime plugin always includes all of them.
+	for (int32 shardIndex = 0; shardIndex < MaxNativeGlueShards; ++shardIndex)
+	{
+		GlueNativeWrapperFileShard(shardIndex, shardClasses[shardIndex]);
+	}
+
+    // generate the file that will be included by KlawrRuntimePlugin.cpp
+	FString glueFilename = GeneratedCodePath / NativeGlueFilename;
 	FCodeFormatter generatedGlue(TEXT('\t'), 1);
 
 	generatedGlue 
 		<< TEXT("// This file is autogenerated, DON'T EDIT it, if you do your changes will be lost!")
+		<< FCodeFormatter::LineTerminator()
+		<< TEXT("namespace Klawr {")
+		<< TEXT("namespace NativeGlue {")
 		<< FCodeFormatter::LineTerminator();
 
-	// include all source header files
-	generatedGlue << TEXT("// The native classes which will be made scriptable:");
-	for (const auto& headerFilename : AllSourceClassHeaders)
+	// the native wrappers are registered by the shards, which are compiled separately
+	for (int32 shardIndex = 0; shardIndex < MaxNativeGlueShards; ++shardIndex)
 	{
-		// re-base to make sure we're including the right files on a remote machine
-		FString newFilename(RebaseToBuildPath(headerFilename));
-		generatedGlue << FString::Printf(TEXT("#include \"%s\""), *newFilename);
+		generatedGlue.Line(TEXT("void RegisterWrapperClasses_"), shardIndex, TEXT("();"));
 	}
 
-	// include all script glue headers
-	generatedGlue << TEXT("// The autogenerated native wrappers:");
-	for (const auto& headerFilename : AllScriptHeaders)
+	generatedGlue
+		<< FCodeFormatter::LineTerminator()
+		<< TEXT("void RegisterWrapperClasses()")
+		<< FCodeFormatter::OpenBrace();
+
+	for (int32 shardIndex = 0; shardIndex < MaxNativeGlueShards; ++shardIndex)
 	{
-		FString newFilename(FPaths::GetCleanFilename(headerFilename));
-		generatedGlue << FString::Printf(TEXT("#include \"%s\""), *newFilename);
+		generatedGlue.Line(TEXT("RegisterWrapperClasses_"), shardIndex, TEXT("();"));
 	}
-	
-	// generate a function that feeds all the native wrapper functions to the CLR host
+
+	generatedGlue 
+		<< FCodeFormatter::CloseBrace()
+		<< FCodeFormatter::LineTerminator();
+
+	GenerateStructLayoutRegistration(generatedGlue);
+
+	generatedGlue 
+		<< FCodeFormatter::LineTerminator()
+		<< TEXT("}} // namespace Klawr::NativeGlue");
+
+	WriteToFile(glueFilename, generatedGlue);
+
+    UE_LOG(LogKlawrCodeGenerator, Log, TEXT("finish GlueAllNativeWrapperFiles"));
+}
+
+void FCodeGenerator::GenerateStructLayoutRegistration(FCodeFormatter& GeneratedGlue) const
+{
+	// The offsets of the struct fields are looked up at runtime rather than generated here, that
+	// way they come from the compiled engine rather than from the reflection data available to 
+	// the code generator (which is what the C# structs were generated from).
+	GeneratedGlue
+		<< TEXT("void RegisterStructLayouts()")
+		<< FCodeFormatter::OpenBrace();
+
+	for (const UScriptStruct* exportedStruct : AllExportedStructs)
+	{
+		const FString structName = exportedStruct->GetName();
+		GeneratedGlue << FCodeFormatter::OpenBrace();
+
+		int32 numFields = 0;
+		for (TFieldIterator<UProperty> propertyIt(exportedStruct); propertyIt; ++propertyIt)
+		{
+			if (numFields == 0)
+			{
+				GeneratedGlue
+					<< TEXT("static const TCHAR* const fieldNames[][2] =")
+					<< FCodeFormatter::OpenBrace();
+			}
+			GeneratedGlue.Line(
+				TEXT("{ TEXT(\""), propertyIt->GetName(), TEXT("\"), TEXT(\""), 
+				FCSharpStructWrapperGenerator::GetManagedFieldName(*propertyIt), TEXT("\") },")
+			);
+			++numFields;
+		}
+
+		if (numFields > 0)
+		{
+			GeneratedGlue
+				<< FCodeFormatter::CloseBrace()
+				<< TEXT(";");
+		}
+		GeneratedGlue << FString::Printf(
+			TEXT("AddStructLayout(TEXT(\"%s\"), TEXT(\"%s%s\"), %s, %d);"),
+			*structName, exportedStruct->GetPrefixCPP(), *structName, 
+			(numFields > 0) ? TEXT("fieldNames") : TEXT("nullptr"), numFields
+		);
+		GeneratedGlue << FCodeFormatter::CloseBrace();
+	}
+
+	GeneratedGlue << FCodeFormatter::CloseBrace();
+}
+
+void FCodeGenerator::GlueNativeWrapperFileShard(int32 ShardIndex, const TArray<const UClass*>& Classes)
+{
+	// generate the file that will be included by KlawrNativeGlueShard<ShardIndex>.cpp
+	FCodeFormatter generatedGlue(TEXT('\t'), 1);
+
+	generatedGlue 
+		<< TEXT("// This file is autogenerated, DON'T EDIT it, if you do your changes will be lost!")
+		<< FCodeFormatter::LineTerminator();
+
+	if (Classes.Num() > 0)
+	{
+		// include the source headers the wrappers in this shard need (see the note in 
+		// ExportClass()), so that adding or removing an unrelated class doesn't change this shard
+		TSet<FString> shardHeaders;
+		for (const UClass* wrappedClass : Classes)
+		{
+			GetNativeWrapperSourceHeaders(wrappedClass, shardHeaders);
+		}
+		generatedGlue << TEXT("// The native classes which will be made scriptable:");
+		for (const auto& headerFilename : AllSourceClassHeaders)
+		{
+			if (shardHeaders.Contains(headerFilename))
+			{
+				// re-base to make sure we're including the right files on a remote machine
+				generatedGlue.Line(TEXT("#include \""), RebaseToBuildPath(headerFilename), TEXT('"'));
+			}
+		}
+
+		// include the script glue headers for the classes in this shard
+		generatedGlue << TEXT("// The autogenerated native wrappers:");
+		for (const UClass* wrappedClass : Classes)
+		{
+			generatedGlue.Line(TEXT("#include \""), wrappedClass->GetName(), TEXT(".klawr.h\""));
+		}
+	}
+
+	// generate a function that feeds the native wrapper functions in this shard to the CLR host,
+	// the classes are passed in a single call so the CLR host can append all their functions to
+	// its native function table in one go
 	generatedGlue
 		<< FCodeFormatter::LineTerminator()
 		<< TEXT("namespace Klawr {")
 		<< TEXT("namespace NativeGlue {")
-		<< FCodeFormatter::LineTerminator()
-		<< TEXT("void RegisterWrapperClasses()")
-		<< FCodeFormatter::OpenBrace();
+		<< FCodeFormatter::LineTerminator();
 
-	for (auto wrappedClass : ClassesWithNativeWrappers)
+	if (Classes.Num() > 0)
 	{
-		const FString ClassName = wrappedClass->GetName();
-		const FString ClassNameCPP = FString::Printf(
-			TEXT("%s%s"), wrappedClass->GetPrefixCPP(), *ClassName
-		);
-		generatedGlue << FString::Printf(
-			TEXT("IClrHost::Get()->AddClass(TEXT(\"%s\"), %s_WrapperFunctions, ")
-			TEXT("sizeof(%s_WrapperFunctions) / sizeof(%s_WrapperFunctions[0]));"),
-			*ClassNameCPP, *ClassName, *ClassName, *ClassName
+		generatedGlue.Line(TEXT("static const NativeClassWrappers ShardClasses_"), ShardIndex, TEXT("[] ="));
+		generatedGlue << FCodeFormatter::OpenBrace();
+
+		for (const UClass* wrappedClass : Classes)
+		{
+			const FString ClassName = wrappedClass->GetName();
+			const FString ClassNameCPP = FString::Printf(
+				TEXT("%s%s"), wrappedClass->GetPrefixCPP(), *ClassName
+			);
+			generatedGlue << FString::Printf(
+				TEXT("{ TEXT(\"%s\"), %s_WrapperFunctions, %s_NumWrapperFunctions },"),
+				*ClassNameCPP, *ClassName, *ClassName
+			);
+		}
+
+		generatedGlue 
+			<< FCodeFormatter::CloseBrace()
+			<< TEXT(";")
+			<< FCodeFormatter::LineTerminator();
+	}
+
+	generatedGlue.Line(TEXT("void RegisterWrapperClasses_"), ShardIndex, TEXT("()"));
+	generatedGlue << FCodeFormatter::OpenBrace();
+
+	if (Classes.Num() > 0)
+	{
+		generatedGlue.Line(
+			TEXT("IClrHost::Get()->AddClasses(ShardClasses_"), ShardIndex, 
+			TEXT(", sizeof(ShardClasses_"), ShardIndex, TEXT(") / sizeof(ShardClasses_"), 
+			ShardIndex, TEXT("[0]));")
 		);
 	}
 
@@ -761,26 +1601,99 @@ void FCodeGenerator::GlueAllNativeWrapperFiles()
 		<< FCodeFormatter::LineTerminator()
 		<< TEXT("}} // namespace Klawr::NativeGlue");
 
-	WriteToFile(glueFilename, generatedGlue.Content);
-
-    UE_LOG(LogKlawrCodeGenerator, Log, TEXT("finish GlueAllNativeWrapperFiles"));
+	WriteToFile(GetNativeGlueShardFilename(ShardIndex), generatedGlue);
 }
 
-void FCodeGenerator::WriteToFile(const FString& Path, const FString& Content)
+void FCodeGenerator::WriteToFile(const FString& Path, const FCodeFormatter& Content)
 {
 	FString diskContent;
 	FFileHelper::LoadFileToString(diskContent, *Path);
 
-	const bool bContentChanged = (diskContent.Len() == 0) || FCString::Strcmp(*diskContent, *Content);
+	const bool bContentChanged = (diskContent.Len() == 0) || !Content.Equals(diskContent);
 	if (bContentChanged)
 	{
-		if (!FFileHelper::SaveStringToFile(Content, *Path))
+		if (!Content.SaveToFile(Path))
 		{
 			UE_LOG(LogKlawrCodeGenerator, Warning, TEXT("Failed to save '%s'"), *Path);
 		}
 	}
 }
 
+void FCodeGenerator::GetNativeWrapperSourceHeaders(const UClass* Class, TSet<FString>& OutHeaders) const
+{
+	// NOTE: Every member is considered (not just the exported ones), including a few headers 
+	//       too many is harmless but missing one isn't.
+	AddTypeSourceHeader(Class, OutHeaders);
+	for (TFieldIterator<UFunction> funcIt(Class, EFieldIteratorFlags::ExcludeSuper); funcIt; ++funcIt)
+	{
+		for (TFieldIterator<UProperty> paramIt(*funcIt); paramIt; ++paramIt)
+		{
+			AddPropertySourceHeaders(*paramIt, OutHeaders);
+		}
+	}
+	for (TFieldIterator<UProperty> propertyIt(Class, EFieldIteratorFlags::ExcludeSuper); propertyIt; ++propertyIt)
+	{
+		AddPropertySourceHeaders(*propertyIt, OutHeaders);
+	}
+}
+
+void FCodeGenerator::AddPropertySourceHeaders(const UProperty* Property, TSet<FString>& OutHeaders) const
+{
+	if (auto arrayProp = Cast<UArrayProperty>(Property))
+	{
+		AddPropertySourceHeaders(arrayProp->Inner, OutHeaders);
+	}
+	else if (auto objectProp = Cast<UObjectPropertyBase>(Property))
+	{
+		AddTypeSourceHeader(objectProp->PropertyClass, OutHeaders);
+		if (auto classProp = Cast<UClassProperty>(Property))
+		{
+			AddTypeSourceHeader(classProp->MetaClass, OutHeaders);
+		}
+	}
+	else if (auto structProp = Cast<UStructProperty>(Property))
+	{
+		AddTypeSourceHeader(structProp->Struct, OutHeaders);
+	}
+	else if (auto byteProp = Cast<UByteProperty>(Property))
+	{
+		AddTypeSourceHeader(byteProp->Enum, OutHeaders);
+	}
+}
+
+void FCodeGenerator::AddTypeSourceHeader(const UField* Type, TSet<FString>& OutHeaders) const
+{
+	if (!Type)
+	{
+		return;
+	}
+	// types that weren't declared in the header of an exported class come from the engine PCH
+	const FString* headerFilename = nullptr;
+	if (auto typeClass = Cast<UClass>(Type))
+	{
+		headerFilename = ClassSourceHeaders.Find(typeClass);
+	}
+	if (!headerFilename)
+	{
+		headerFilename = SourceHeadersByModulePath.Find(GetModulePathKey(Type));
+	}
+	if (headerFilename)
+	{
+		OutHeaders.Add(*headerFilename);
+	}
+}
+
+FString FCodeGenerator::GetModulePathKey(const UField* Type)
+{
+	// NOTE: Only the non hierarchical GetMetaData() is available to this plugin.
+	const FString& modulePath = Type->GetMetaData(TEXT("ModuleRelativePath"));
+	if (modulePath.IsEmpty())
+	{
+		return FString();
+	}
+	return Type->GetOutermost()->GetName() + TEXT(":") + modulePath;
+}
+
 FString FCodeGenerator::RebaseToBuildPath(const FString& Filename) const
 {
 	FString rebasedFilename(Filename);
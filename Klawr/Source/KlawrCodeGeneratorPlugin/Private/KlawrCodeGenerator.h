@@ -23,6 +23,9 @@
 //-------------------------------------------------------------------------------
 #pragma once
 
+#include "KlawrCodeGeneratorManifest.h"
+#include "KlawrCodeGeneratorReport.h"
+
 namespace Klawr {
 
 class FCodeFormatter;
@@ -59,8 +62,29 @@ public:
         TArray<FString> ExcludedModules;
         FString WrapperProjectTemplatePath;
         FString WrapperProjectCopyPath;
+        /** Generate the wrappers for multiple types at once on the task graph. */
+        bool bParallelGeneration;
+        /** Number of translation units the native wrappers are split between. */
+        int32 NumNativeGlueShards;
+        /** 
+         * Only generate bindings for the class members listed in the binding usage file (written
+         * by the editor whenever it loads the game scripts) or in KeepBindings.
+         * @note Trimmed members are missing from the C# wrappers too, so the game scripts can't
+         *       start using one until it's added to KeepBindings or trimming is turned off.
+         */
+        bool bTrimUnusedBindings;
+        FString BindingUsageFilePath;
+        /** Class members to keep when trimming, either a class name (e.g. AActor) or Class.Member. */
+        TArray<FString> KeepBindings;
+        /** The class members bindings should be generated for, only used when trimming. */
+        TSet<FString> UsedBindings;
+        /** 
+         * Include the generated C# wrappers in the wrapper project with a single wildcard item
+         * rather than one item per file.
+         */
+        bool bWildcardWrapperInclude;
 
-        FConfig() {
+        FConfig() : bParallelGeneration(true), NumNativeGlueShards(4), bTrimUnusedBindings(false), bWildcardWrapperInclude(false) {
             WrapperProjectTemplatePath = FPaths::ConvertRelativePathToFull(FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Resources/WrapperProjectTemplate"));
             WrapperProjectCopyPath = FPaths::ConvertRelativePathToFull(FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Project"));
 
@@ -68,7 +92,22 @@ public:
             GConfig->GetArray(TEXT("Config"), TEXT("ScriptExcludedNames"), Excluded, configFile);
             GConfig->GetArray(TEXT("Config"), TEXT("ScriptSupportedModules"), SupportedModules, configFile);
             GConfig->GetArray(TEXT("Config"), TEXT("ScriptExcludedModules"), ExcludedModules, configFile);
+            GConfig->GetBool(TEXT("Config"), TEXT("ParallelGeneration"), bParallelGeneration, configFile);
+            GConfig->GetInt(TEXT("Config"), TEXT("NativeGlueShards"), NumNativeGlueShards, configFile);
+
+            // must match FGameProjectBuilder::GetBindingUsageFilename() in the editor plugin
+            BindingUsageFilePath = FPaths::ConvertRelativePathToFull(FPaths::GameIntermediateDir() / TEXT("Klawr/BindingUsage.txt"));
+            GConfig->GetBool(TEXT("Config"), TEXT("TrimUnusedBindings"), bTrimUnusedBindings, configFile);
+            GConfig->GetString(TEXT("Config"), TEXT("BindingUsageFile"), BindingUsageFilePath, configFile);
+            GConfig->GetArray(TEXT("Config"), TEXT("KeepBindings"), KeepBindings, configFile);
+            GConfig->GetBool(TEXT("Config"), TEXT("WildcardWrapperInclude"), bWildcardWrapperInclude, configFile);
+            if (bTrimUnusedBindings) {
+                LoadUsedBindings();
+            }
         }
+
+        /** Read the binding usage file, trimming is disabled if it can't be read. */
+        void LoadUsedBindings();
     };
 
     inline static FConfig const & GetConig() {
@@ -78,10 +117,58 @@ public:
 
 private:
 
+	enum class EPendingExportKind
+	{
+		Class,
+		Struct,
+		Enum
+	};
+
+	/** 
+	 * A type whose wrappers will be generated by FinishExport(), everything that depends on the
+	 * other exported types is worked out up front so the wrappers can be generated in parallel.
+	 */
+	struct FPendingExport
+	{
+		EPendingExportKind Kind;
+		const UField* Type;
+		/** Only used for classes. */
+		const UClass* WrapperSuperClass;
+		/** Only used for classes, true if native wrappers should be generated. */
+		bool bCanExport;
+		FString NativeGlueFilename;
+		FString ManagedGlueFilename;
+		FString TypeKey;
+		FString InputHash;
+		/** True if the wrappers from the previous run can be reused. */
+		bool bIsUpToDate;
+		/** Set once the wrappers have been successfully written out. */
+		bool bGenerated;
+
+		FPendingExport()
+			: Kind(EPendingExportKind::Class)
+			, Type(nullptr)
+			, WrapperSuperClass(nullptr)
+			, bCanExport(false)
+			, bIsUpToDate(false)
+			, bGenerated(false)
+		{
+		}
+	};
+
 	// Structs which we have manually bound in ClrHostManaged for whatever reason (e.g. don't need to export them, but can still use them)
 	static const TArray<FName> SpecialStructs;
 
 	static const FString ClrHostManagedAssemblyName;
+	static const FString NativeGlueFilename;
+	static const FString ManagedWrapperProjectFilename;
+	static const FString ManifestFilename;
+	static const FString ReportFilename;
+	/** 
+	 * Number of native glue shard files that are always generated, the runtime plugin has a 
+	 * KlawrNativeGlueShard<N>.cpp for each one.
+	 */
+	static const int32 MaxNativeGlueShards;
 		
 	/** Path where generated script glue goes **/
 	FString GeneratedCodePath;
@@ -97,11 +184,28 @@ private:
 	TArray<FString> AllManagedWrapperFiles;
 	/** Engine source header filenames for all exported classes. */
 	TArray<FString> AllSourceClassHeaders;
+	/** Engine source header filename of each exported class. */
+	TMap<const UClass*, FString> ClassSourceHeaders;
+	/** 
+	 * Engine source header filenames of the exported classes indexed by GetModulePathKey(), 
+	 * used to find the headers that declare the structs and enums used by the wrappers.
+	 */
+	TMap<FString, FString> SourceHeadersByModulePath;
 	/** Classes for which native wrappers were generated. */
 	TArray<const UClass*> ClassesWithNativeWrappers;
 	TArray<const UClass*> AllExportedClasses;
 	TArray<const UScriptStruct*> AllExportedStructs;
 	TArray<const UEnum*> AllExportedEnums;
+	/** Input hashes of the wrappers generated by this run and the previous one. */
+	FCodeGeneratorManifest Manifest;
+	/** Types queued by ExportClass(), ExportStruct() and ExportEnum(), in the order they were queued. */
+	TArray<FPendingExport> PendingExports;
+	/** Number of types whose wrappers were (re)generated by this run. */
+	int32 NumGeneratedTypes;
+	/** Number of types whose wrappers were left as they were because their inputs didn't change. */
+	int32 NumUpToDateTypes;
+	/** Statistics about this run, saved alongside the generated code by FinishExport(). */
+	FCodeGeneratorReport Report;
 
 	static bool CanExportClass(const UClass* Class);
 	static bool CanExportStruct(const UScriptStruct* Struct);
@@ -109,20 +213,93 @@ private:
 	static bool CanExportProperty(const UClass* Class, const UProperty* Property);
 	static bool CanExportProperty(const UScriptStruct* Struct, const UProperty* Property);
 	static bool CanExportFunction(const UClass* Class, const UFunction* Function);
+	/** Check if a dynamic multicast delegate can be exported as a C# event. */
+	static bool CanExportEvent(const UClass* Class, const UMulticastDelegateProperty* Property);
+	/** 
+	 * The Get*SkipReason() functions return a short description of why a type or member can't be
+	 * exported (used in the report), or nullptr if it can be exported.
+	 */
+	static const TCHAR* GetClassSkipReason(const UClass* Class);
+	static const TCHAR* GetStructSkipReason(const UScriptStruct* Struct);
+	static const TCHAR* GetPropertySkipReason(const UClass* Class, const UProperty* Property);
+	static const TCHAR* GetFunctionSkipReason(const UClass* Class, const UFunction* Function);
+	static const TCHAR* GetEventSkipReason(const UClass* Class, const UMulticastDelegateProperty* Property);
+	/** Record the exported and skipped members of a class in the report. */
+	void ReportClassMembers(const UClass* Class, bool bCanExport);
+	/** Check if bindings should be generated for the given class member (see TrimUnusedBindings). */
+	static bool IsBindingUsed(const UClass* Class, const FString& MemberName);
 
 	/** Generate a .csproj for the C# wrapper classes. */
 	bool GenerateManagedWrapperProject();
+	/** Delete any C# wrappers left over from types that are no longer exported. */
+	void DeleteStaleManagedWrapperFiles() const;
 	/** Build the generated .csproj of C# wrapper classes. */
 	void BuildManagedWrapperProject();
-	/** Create a 'glue' file that merges all generated script files */
+	/** Save the statistics gathered during this run (see FCodeGeneratorReport). */
+	void SaveReport();
+	/** 
+	 * Generate the wrappers for all the queued types and gather the results.
+	 * @note The Generate*Wrappers() functions are called from worker threads, so they must only
+	 *       write to their own files and must not modify any of the generator's state.
+	 */
+	void GeneratePendingExports();
+	static bool GenerateClassWrappers(const FPendingExport& Export);
+	static bool GenerateStructWrappers(const FPendingExport& Export);
+	static bool GenerateEnumWrappers(const FPendingExport& Export);
+	/** 
+	 * Create the 'glue' files that merge all generated script files, the native wrappers are 
+	 * split between a number of shards so that they can be compiled in parallel.
+	 */
 	void GlueAllNativeWrapperFiles();
+	/** 
+	 * Generate a function that registers the layouts of the exported structs, so that they can
+	 * be checked against the generated C# structs at runtime.
+	 */
+	void GenerateStructLayoutRegistration(FCodeFormatter& GeneratedGlue) const;
+	/** Create a 'glue' file that merges the generated script files of the given classes. */
+	void GlueNativeWrapperFileShard(int32 ShardIndex, const TArray<const UClass*>& Classes);
+	/** 
+	 * Get the engine source headers needed to compile the native wrappers of the given class,
+	 * i.e. the header of the class itself and of the types its members reference.
+	 */
+	void GetNativeWrapperSourceHeaders(const UClass* Class, TSet<FString>& OutHeaders) const;
+	void AddPropertySourceHeaders(const UProperty* Property, TSet<FString>& OutHeaders) const;
+	void AddTypeSourceHeader(const UField* Type, TSet<FString>& OutHeaders) const;
+	/** Identifies the header a type was declared in (by package and module relative path). */
+	static FString GetModulePathKey(const UField* Type);
+	/** Get the number of shards the native wrappers should be split between. */
+	static int32 GetNumNativeGlueShards();
+	FString GetNativeGlueShardFilename(int32 ShardIndex) const;
 	
 	/** Check if a property type is supported */
 	static bool IsPropertyTypeSupported(const UProperty* Property);
+	/** 
+	 * Check if a parameter of a dynamic multicast delegate can be passed to managed event handlers,
+	 * must match UKlawrEventTrampoline::GetEventParams() in the runtime plugin.
+	 */
+	static bool IsEventParamTypeSupported(const UProperty* Param);
+	/**
+	 * Check if the elements of a TArray of the given struct can be copied to/from the generated
+	 * C# struct as raw memory, i.e. the struct owns no memory and its C# counterpart is blittable.
+	 */
+	static bool IsStructArrayElementSupported(const UScriptStruct* Struct);
 	/** Check if the property type is a pointer. */
 	static bool IsPropertyTypePointer(const UProperty* Property);
 
-	void WriteToFile(const FString& Path, const FString& Content);
+	/** 
+	 * Describe everything that affects the wrappers generated for a type, if the description
+	 * doesn't change between runs the wrappers don't need to be regenerated.
+	 */
+	static FString GetClassInputs(
+		const UClass* Class, const FString& SourceHeaderFilename, 
+		const UClass* WrapperSuperClass, bool bCanExport
+	);
+	static FString GetStructInputs(const UScriptStruct* Struct);
+	static FString GetEnumInputs(const UEnum* Enum);
+	/** Describe the set of exported types, this determines the content of the aggregate files. */
+	FString GetExportSetInputs() const;
+
+	static void WriteToFile(const FString& Path, const FCodeFormatter& Content);
 	FString RebaseToBuildPath(const FString& Filename) const;
 };
 
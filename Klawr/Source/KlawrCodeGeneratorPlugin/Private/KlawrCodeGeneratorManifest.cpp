@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "KlawrCodeGeneratorPluginPrivatePCH.h"
+#include "KlawrCodeGeneratorManifest.h"
+#include "SecureHash.h"
+
+namespace Klawr {
+
+const int32 FCodeGeneratorManifest::Version = 4;
+
+namespace 
+{
+	const TCHAR* const VersionKey = TEXT("Version");
+	const TCHAR* const ExportSetKey = TEXT("ExportSet");
+} // unnamed namespace
+
+FCodeGeneratorManifest::FCodeGeneratorManifest(const FString& InFilename)
+	: Filename(InFilename)
+{
+}
+
+void FCodeGeneratorManifest::Load()
+{
+	PreviousHashes.Empty();
+	PreviousExportSetHash.Empty();
+
+	FString content;
+	if (!FFileHelper::LoadFileToString(content, *Filename))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Log, TEXT("No manifest found at %s, all wrappers will be generated."), *Filename);
+		return;
+	}
+
+	TArray<FString> lines;
+	content.ParseIntoArrayLines(lines);
+
+	TMap<FString, FString> entries;
+	for (const FString& line : lines)
+	{
+		FString key, value;
+		if (!line.StartsWith(TEXT(";")) && line.Split(TEXT("="), &key, &value))
+		{
+			entries.Add(key, value);
+		}
+	}
+
+	const FString* version = entries.Find(VersionKey);
+	if (!version || (FCString::Atoi(**version) != Version))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Log, TEXT("Manifest %s is out of date, all wrappers will be generated."), *Filename);
+		return;
+	}
+
+	if (const FString* exportSetHash = entries.Find(ExportSetKey))
+	{
+		PreviousExportSetHash = *exportSetHash;
+	}
+	entries.Remove(VersionKey);
+	entries.Remove(ExportSetKey);
+	PreviousHashes = MoveTemp(entries);
+}
+
+bool FCodeGeneratorManifest::Save() const
+{
+	TArray<FString> keys;
+	CurrentHashes.GenerateKeyArray(keys);
+	// keep the file stable between runs so it's easy to diff
+	keys.Sort();
+
+	FString content = TEXT("; This file is autogenerated, DON'T EDIT it, if you do your changes will be lost!") LINE_TERMINATOR;
+	content += FString::Printf(TEXT("%s=%d") LINE_TERMINATOR, VersionKey, Version);
+	content += FString::Printf(TEXT("%s=%s") LINE_TERMINATOR, ExportSetKey, *CurrentExportSetHash);
+	for (const FString& key : keys)
+	{
+		content += FString::Printf(TEXT("%s=%s") LINE_TERMINATOR, *key, *CurrentHashes[key]);
+	}
+
+	if (!FFileHelper::SaveStringToFile(content, *Filename))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Warning, TEXT("Failed to save '%s'"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+bool FCodeGeneratorManifest::IsUpToDate(const FString& TypeKey, const FString& InputHash) const
+{
+	const FString* previousHash = PreviousHashes.Find(TypeKey);
+	return previousHash && (*previousHash == InputHash);
+}
+
+void FCodeGeneratorManifest::Update(const FString& TypeKey, const FString& InputHash)
+{
+	CurrentHashes.Add(TypeKey, InputHash);
+}
+
+bool FCodeGeneratorManifest::IsExportSetUpToDate(const FString& ExportSetHash) const
+{
+	return !PreviousExportSetHash.IsEmpty() && (PreviousExportSetHash == ExportSetHash);
+}
+
+void FCodeGeneratorManifest::UpdateExportSet(const FString& ExportSetHash)
+{
+	CurrentExportSetHash = ExportSetHash;
+}
+
+FString FCodeGeneratorManifest::HashInputs(const FString& Inputs)
+{
+	FMD5 md5;
+	md5.Update(reinterpret_cast<const uint8*>(*Inputs), Inputs.Len() * sizeof(TCHAR));
+	uint8 digest[16];
+	md5.Final(digest);
+	return BytesToHex(digest, sizeof(digest));
+}
+
+} // namespace Klawr
@@ -0,0 +1,71 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace Klawr {
+
+/**
+ * Keeps track of the inputs each generated wrapper was built from.
+ *
+ * An input hash is recorded for every exported type, on the next run the wrappers for a type only
+ * need to be regenerated if its input hash changed (or the generated files went missing). The
+ * manifest also stores a hash of the set of exported types, the aggregate files (the native glue
+ * .inl and the wrapper .csproj) only need to be regenerated when that set changes.
+ */
+class FCodeGeneratorManifest
+{
+public:
+	/** 
+	 * Bump this whenever the output of the code generator changes in a way that isn't reflected
+	 * in the input hashes, this will force all wrappers to be regenerated on the next run.
+	 */
+	static const int32 Version;
+
+	explicit FCodeGeneratorManifest(const FString& InFilename);
+
+	/** Load the manifest written by the previous run (if any). */
+	void Load();
+	/** Save the entries recorded during this run, entries that weren't recorded are dropped. */
+	bool Save() const;
+
+	/** Check if the given type was generated from the given inputs by the previous run. */
+	bool IsUpToDate(const FString& TypeKey, const FString& InputHash) const;
+	/** Record the inputs the given type was generated from during this run. */
+	void Update(const FString& TypeKey, const FString& InputHash);
+
+	/** Check if the set of exported types is the same as in the previous run. */
+	bool IsExportSetUpToDate(const FString& ExportSetHash) const;
+	void UpdateExportSet(const FString& ExportSetHash);
+
+	/** Compute the hash of a string describing the inputs of a type. */
+	static FString HashInputs(const FString& Inputs);
+
+private:
+	FString Filename;
+	TMap<FString, FString> PreviousHashes;
+	TMap<FString, FString> CurrentHashes;
+	FString PreviousExportSetHash;
+	FString CurrentExportSetHash;
+};
+
+} // namespace Klawr
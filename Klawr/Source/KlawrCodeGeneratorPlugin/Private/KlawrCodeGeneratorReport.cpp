@@ -0,0 +1,182 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#include "KlawrCodeGeneratorPluginPrivatePCH.h"
+#include "KlawrCodeGeneratorReport.h"
+#include "KlawrCodeGeneratorManifest.h"
+#include "Json.h"
+
+namespace Klawr {
+
+namespace 
+{
+	typedef TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>> FReportWriter;
+
+	/** Write the entries of a map sorted by key, so reports are easy to diff. */
+	template<typename ValueType, typename WriteValueFunc>
+	void WriteSortedObject(
+		FReportWriter& Writer, const FString& Identifier, const TMap<FString, ValueType>& Map, 
+		WriteValueFunc WriteValue
+	)
+	{
+		TArray<FString> keys;
+		Map.GenerateKeyArray(keys);
+		keys.Sort();
+
+		Writer.WriteObjectStart(Identifier);
+		for (const FString& key : keys)
+		{
+			WriteValue(Writer, key, Map[key]);
+		}
+		Writer.WriteObjectEnd();
+	}
+} // unnamed namespace
+
+FCodeGeneratorReport::FScopedPhaseTimer::FScopedPhaseTimer(
+	FCodeGeneratorReport& InReport, const TCHAR* InPhase
+)
+	: Report(InReport)
+	, Phase(InPhase)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FCodeGeneratorReport::FScopedPhaseTimer::~FScopedPhaseTimer()
+{
+	Report.AddPhaseTime(Phase, FPlatformTime::Seconds() - StartTime);
+}
+
+FString FCodeGeneratorReport::GetModuleName(const UField* Type)
+{
+	// e.g. /Script/Engine
+	return FPackageName::GetShortName(Type->GetOutermost()->GetName());
+}
+
+void FCodeGeneratorReport::AddExported(const FString& ModuleName, const TCHAR* Category)
+{
+	++Modules.FindOrAdd(ModuleName).Categories.FindOrAdd(Category).NumExported;
+}
+
+void FCodeGeneratorReport::AddSkipped(
+	const FString& ModuleName, const TCHAR* Category, const TCHAR* Reason
+)
+{
+	++Modules.FindOrAdd(ModuleName).Categories.FindOrAdd(Category).SkipReasons.FindOrAdd(Reason);
+}
+
+void FCodeGeneratorReport::AddGeneratedFile(
+	const FString& ModuleName, const FString& Filename, bool bManaged
+)
+{
+	const int64 fileSize = FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+	FModuleStats& moduleStats = Modules.FindOrAdd(ModuleName);
+	(bManaged ? moduleStats.ManagedBytes : moduleStats.NativeBytes) += fileSize;
+}
+
+void FCodeGeneratorReport::AddAggregateFile(const FString& Filename)
+{
+	AggregateFiles.Add(
+		FPaths::GetCleanFilename(Filename), 
+		FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0)
+	);
+}
+
+void FCodeGeneratorReport::AddPhaseTime(const TCHAR* Phase, double Seconds)
+{
+	for (TPair<FString, double>& phase : Phases)
+	{
+		if (phase.Key == Phase)
+		{
+			phase.Value += Seconds;
+			return;
+		}
+	}
+	Phases.Emplace(Phase, Seconds);
+}
+
+void FCodeGeneratorReport::SetTypeCounts(int32 InNumGeneratedTypes, int32 InNumUpToDateTypes)
+{
+	NumGeneratedTypes = InNumGeneratedTypes;
+	NumUpToDateTypes = InNumUpToDateTypes;
+}
+
+bool FCodeGeneratorReport::Save(const FString& Filename) const
+{
+	FString content;
+	TSharedRef<FReportWriter> writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&content);
+
+	writer->WriteObjectStart();
+	writer->WriteValue(TEXT("ManifestVersion"), FCodeGeneratorManifest::Version);
+	writer->WriteValue(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+	writer->WriteValue(TEXT("GeneratedTypes"), NumGeneratedTypes);
+	writer->WriteValue(TEXT("UpToDateTypes"), NumUpToDateTypes);
+
+	writer->WriteObjectStart(TEXT("PhaseSeconds"));
+	for (const TPair<FString, double>& phase : Phases)
+	{
+		writer->WriteValue(phase.Key, phase.Value);
+	}
+	writer->WriteObjectEnd();
+
+	WriteSortedObject(*writer, TEXT("Modules"), Modules, 
+		[](FReportWriter& Writer, const FString& ModuleName, const FModuleStats& ModuleStats)
+		{
+			Writer.WriteObjectStart(ModuleName);
+			Writer.WriteValue(TEXT("NativeBytes"), ModuleStats.NativeBytes);
+			Writer.WriteValue(TEXT("ManagedBytes"), ModuleStats.ManagedBytes);
+			WriteSortedObject(Writer, TEXT("Categories"), ModuleStats.Categories, 
+				[](FReportWriter& Writer, const FString& Category, const FCategoryStats& CategoryStats)
+				{
+					Writer.WriteObjectStart(Category);
+					Writer.WriteValue(TEXT("Exported"), CategoryStats.NumExported);
+					WriteSortedObject(Writer, TEXT("Skipped"), CategoryStats.SkipReasons, 
+						[](FReportWriter& Writer, const FString& Reason, int32 Count)
+						{
+							Writer.WriteValue(Reason, Count);
+						}
+					);
+					Writer.WriteObjectEnd();
+				}
+			);
+			Writer.WriteObjectEnd();
+		}
+	);
+
+	WriteSortedObject(*writer, TEXT("AggregateFileBytes"), AggregateFiles, 
+		[](FReportWriter& Writer, const FString& Filename, int64 FileSize)
+		{
+			Writer.WriteValue(Filename, FileSize);
+		}
+	);
+	writer->WriteObjectEnd();
+	writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(content, *Filename))
+	{
+		UE_LOG(LogKlawrCodeGenerator, Warning, TEXT("Failed to save '%s'"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+} // namespace Klawr
@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#pragma once
+
+namespace Klawr {
+
+/**
+ * Collects statistics about a run of the code generator: how many classes, functions, properties,
+ * structs and enums were exported or skipped (and why), how much C++ and C# was generated for each
+ * module, and how long each phase took. The report is saved as JSON so that it can be compared
+ * between runs, e.g. to track the growth of the bindings between engine upgrades.
+ *
+ * @note Not thread-safe, must only be used from the thread FCodeGenerator is used from.
+ */
+class FCodeGeneratorReport
+{
+public:
+	/** Adds the time elapsed between its construction and destruction to a phase of the report. */
+	class FScopedPhaseTimer
+	{
+	public:
+		FScopedPhaseTimer(FCodeGeneratorReport& InReport, const TCHAR* InPhase);
+		~FScopedPhaseTimer();
+
+	private:
+		FCodeGeneratorReport& Report;
+		const TCHAR* Phase;
+		double StartTime;
+	};
+
+	/** Get the name of the module the given type was declared in. */
+	static FString GetModuleName(const UField* Type);
+
+	/** Record a class member or type that was exported, e.g. Category could be "Function". */
+	void AddExported(const FString& ModuleName, const TCHAR* Category);
+	/** Record a class member or type that was skipped, along with the reason it was skipped. */
+	void AddSkipped(const FString& ModuleName, const TCHAR* Category, const TCHAR* Reason);
+	/** Record the size of a wrapper file generated for a type in the given module. */
+	void AddGeneratedFile(const FString& ModuleName, const FString& Filename, bool bManaged);
+	/** Record the size of a file generated for all the exported types (e.g. the native glue). */
+	void AddAggregateFile(const FString& Filename);
+	/** Add to the time spent in a phase, phases are reported in the order they were first added. */
+	void AddPhaseTime(const TCHAR* Phase, double Seconds);
+	void SetTypeCounts(int32 InNumGeneratedTypes, int32 InNumUpToDateTypes);
+
+	bool Save(const FString& Filename) const;
+
+private:
+	struct FCategoryStats
+	{
+		int32 NumExported;
+		TMap<FString, int32> SkipReasons;
+
+		FCategoryStats() : NumExported(0) {}
+	};
+
+	struct FModuleStats
+	{
+		TMap<FString, FCategoryStats> Categories;
+		int64 NativeBytes;
+		int64 ManagedBytes;
+
+		FModuleStats() : NativeBytes(0), ManagedBytes(0) {}
+	};
+
+	TMap<FString, FModuleStats> Modules;
+	TMap<FString, int64> AggregateFiles;
+	TArray<TPair<FString, double>> Phases;
+	int32 NumGeneratedTypes = 0;
+	int32 NumUpToDateTypes = 0;
+};
+
+} // namespace Klawr
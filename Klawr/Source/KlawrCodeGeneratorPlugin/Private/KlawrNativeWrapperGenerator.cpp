@@ -53,10 +53,13 @@ void FNativeWrapperGenerator::GenerateFooter()
 		<< FCodeFormatter::CloseBrace()
 		<< TEXT(";");
 
+	// generate an array of function pointers to all the native wrapper functions, along with
+	// the number of elements in it (the shard glue references both for every exported class,
+	// even ones that only export events and therefore have no wrapper functions at all)
+	FString arrayName = FString::Printf(TEXT("%s_WrapperFunctions"), *FriendlyClassName);
+	int32 numWrapperFunctions = 0;
 	if (ExportedProperties.Num() || ExportedFunctions.Num())
 	{
-		// generate an array of function pointers to all the native wrapper functions
-		FString arrayName = FString::Printf(TEXT("%s_WrapperFunctions"), *FriendlyClassName);
 		GeneratedGlue
 			<< FString::Printf(TEXT("static void* %s[] ="), *arrayName)
 			<< FCodeFormatter::OpenBrace();
@@ -65,23 +68,35 @@ void FNativeWrapperGenerator::GenerateFooter()
 		{
 			if (!exportedProperty.GetterWrapperFunctionName.IsEmpty())
 			{
-				GeneratedGlue << exportedProperty.GetterWrapperFunctionName + TEXT(",");
+				GeneratedGlue.Line(exportedProperty.GetterWrapperFunctionName, TEXT(','));
+				++numWrapperFunctions;
 			}
 			if (!exportedProperty.SetterWrapperFunctionName.IsEmpty())
 			{
-				GeneratedGlue << exportedProperty.SetterWrapperFunctionName + TEXT(",");
+				GeneratedGlue.Line(exportedProperty.SetterWrapperFunctionName, TEXT(','));
+				++numWrapperFunctions;
 			}
 		}
 		
 		for (const auto& exportedFunction : ExportedFunctions)
 		{
-			GeneratedGlue << exportedFunction.WrapperFunctionName + TEXT(",");
+			GeneratedGlue.Line(exportedFunction.WrapperFunctionName, TEXT(','));
+			++numWrapperFunctions;
 		}
 		
 		GeneratedGlue
 			<< FCodeFormatter::CloseBrace()
 			<< TEXT(";");
 	}
+	else
+	{
+		// zero-length arrays aren't legal C++
+		GeneratedGlue << FString::Printf(TEXT("static void** const %s = nullptr;"), *arrayName);
+	}
+	GeneratedGlue << FString::Printf(
+		TEXT("static const int %s_NumWrapperFunctions = %d;"), 
+		*FriendlyClassName, numWrapperFunctions
+	);
 
 	GeneratedGlue << TEXT("}} // namespace Klawr::NativeGlue");
 }
@@ -98,9 +113,9 @@ void FNativeWrapperGenerator::GenerateFunctionWrapper(const UFunction* Function)
 		returnValueTypeName = GetPropertyType(returnValue);
 	}
 	// define a native wrapper function that will be bound to a managed delegate
-	GeneratedGlue << FString::Printf(
-		TEXT("static %s %s(%s)"),
-		*returnValueTypeName, *Function->GetName(), *formalArgs
+	GeneratedGlue.Line(
+		TEXT("static "), returnValueTypeName, TEXT(' '), Function->GetName(), 
+		TEXT('('), formalArgs, TEXT(')')
 	);
 	GeneratedGlue << FCodeFormatter::OpenBrace();
 
@@ -120,15 +135,13 @@ void FNativeWrapperGenerator::GenerateFunctionWrapper(const UFunction* Function)
 		{
 			if (param->IsA<UNameProperty>())
 			{
-				GeneratedGlue << FString::Printf(
-					TEXT("*%s = NameToScriptName(Params.%s);"), *param->GetName(), *param->GetName()
+				GeneratedGlue.Line(
+					TEXT('*'), param->GetName(), TEXT(" = NameToScriptName(Params."), param->GetName(), TEXT(");")
 				);
 			}
 			else
 			{
-				GeneratedGlue << FString::Printf(
-					TEXT("*%s = Params.%s;"), *param->GetName(), *param->GetName()
-				);
+				GeneratedGlue.Line(TEXT('*'), param->GetName(), TEXT(" = Params."), param->GetName(), TEXT(';'));
 			}
 		}
 	}
@@ -342,40 +355,33 @@ void FNativeWrapperGenerator::GenerateReturnValueHandler(
 			//       investigate!
 			if (!ReturnValue->IsA<UClassProperty>())
 			{
-				GeneratedGlue
-					<< FString::Printf(TEXT("if (%s)"), *ReturnValueName)
-					<< FCodeFormatter::OpenBrace()
-						<< FString::Printf(
-							TEXT("FObjectReferencer::AddObjectRef(%s);"), *ReturnValueName
-						)
-					<< FCodeFormatter::CloseBrace();
+				GeneratedGlue.Line(TEXT("if ("), ReturnValueName, TEXT(')'));
+				GeneratedGlue << FCodeFormatter::OpenBrace();
+				GeneratedGlue.Line(TEXT("FObjectReferencer::AddObjectRef("), ReturnValueName, TEXT(");"));
+				GeneratedGlue << FCodeFormatter::CloseBrace();
 			}
-			GeneratedGlue << FString::Printf(TEXT("return static_cast<UObject*>(%s);"), *ReturnValueName);
+			GeneratedGlue.Line(TEXT("return static_cast<UObject*>("), ReturnValueName, TEXT(");"));
 		}
 		else if (ReturnValue->IsA<UIntProperty>() || 
 			ReturnValue->IsA<UFloatProperty>() ||
 			ReturnValue->IsA<UBoolProperty>())
 		{
-			GeneratedGlue << FString::Printf(TEXT("return %s;"), *ReturnValueName);
+			GeneratedGlue.Line(TEXT("return "), ReturnValueName, TEXT(';'));
 		}
 		else if (ReturnValue->IsA<UStrProperty>())
 		{
-			GeneratedGlue << FString::Printf(
-				TEXT("return MakeStringCopyForCLR(*%s);"), *ReturnValueName
-			);
+			GeneratedGlue.Line(TEXT("return MakeStringCopyForCLR(*"), ReturnValueName, TEXT(");"));
 		}
 		else if (ReturnValue->IsA<UNameProperty>())
 		{
-			GeneratedGlue << FString::Printf(
-				TEXT("return NameToScriptName(%s);"), *ReturnValueName
-			);
+			GeneratedGlue.Line(TEXT("return NameToScriptName("), ReturnValueName, TEXT(");"));
 		}
 		else if (ReturnValue->IsA<UStructProperty>())
 		{
 			auto structProp = CastChecked<UStructProperty>(ReturnValue);
 			if (FCodeGenerator::IsStructPropertyTypeSupported(structProp))
 			{
-				GeneratedGlue << FString::Printf(TEXT("return %s;"), *ReturnValueName);
+				GeneratedGlue.Line(TEXT("return "), ReturnValueName, TEXT(';'));
 			}
 			else
 			{
@@ -407,10 +413,7 @@ void FNativeWrapperGenerator::GenerateFunctionDispatch(const UFunction* Function
 		for (TFieldIterator<UProperty> paramIt(Function); paramIt; ++paramIt)
 		{
 			UProperty* param = *paramIt;
-			FString typeName = FCodeGenerator::GetPropertyCPPType(param);
-			GeneratedGlue << FString::Printf(
-				TEXT("%s %s;"), *typeName, *param->GetName()
-			);
+			GeneratedGlue.Line(FCodeGenerator::GetPropertyCPPType(param), TEXT(' '), param->GetName(), TEXT(';'));
 		}
 
 		GeneratedGlue
@@ -422,9 +425,7 @@ void FNativeWrapperGenerator::GenerateFunctionDispatch(const UFunction* Function
 		int32 paramIndex = 0;
 		for (TFieldIterator<UProperty> paramIt(Function); paramIt; ++paramIt, ++paramIndex)
 		{
-			GeneratedGlue << FString::Printf(
-				TEXT("%s,"), *GetFunctionDispatchParamInitializer(*paramIt)
-			);
+			GeneratedGlue.Line(GetFunctionDispatchParamInitializer(*paramIt), TEXT(','));
 		}
 
 		GeneratedGlue
@@ -432,9 +433,8 @@ void FNativeWrapperGenerator::GenerateFunctionDispatch(const UFunction* Function
 			<< TEXT(";");
 	}
 
-	GeneratedGlue << FString::Printf(
-		TEXT("static UFunction* Function = Obj->FindFunctionChecked(TEXT(\"%s\"));"),
-		*Function->GetName()
+	GeneratedGlue.Line(
+		TEXT("static UFunction* Function = Obj->FindFunctionChecked(TEXT(\""), Function->GetName(), TEXT("\"));")
 	);
 
 	if (bHasParamsOrReturnValue)
@@ -524,7 +524,9 @@ FString FNativeWrapperGenerator::GenerateArrayPropertyGetterWrapper(const UArray
 				*NativeClassName, *arrayProp->GetName()
 			)
 			<< FString::Printf(
-				TEXT("return new TArrayHelper<%s>(&self->%s, prop);"), 
+				TEXT("return new %s<%s>(&self->%s, prop);"), 
+				// most structs don't define operator==, so a different helper is used for those
+				arrayProp->Inner->IsA<UStructProperty>() ? TEXT("TStructArrayHelper") : TEXT("TArrayHelper"),
 				*FCodeGenerator::GetPropertyCPPType(arrayProp->Inner), *arrayProp->GetName()
 			)
 		<< FCodeFormatter::CloseBrace()
@@ -44,6 +44,7 @@ namespace UnrealBuildTool.Rules
                     "EditorStyle",
                     "DesktopPlatform",
                     "DirectoryWatcher",
+                    "MessageLog",
 					// ... add private dependencies that you statically link with here ...
 				}
 			);
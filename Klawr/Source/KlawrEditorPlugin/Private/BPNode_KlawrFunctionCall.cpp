@@ -51,7 +51,10 @@ struct FGetConfigNodeName
 UBPNode_KlawrFunctionCall::UBPNode_KlawrFunctionCall(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	NodeTooltip = LOCTEXT("NodeTooltip", "Call a C# function");
+	NodeTooltip = FText::Format(
+		LOCTEXT("NodeTooltip", "Call a C# function\n\nFunctions with more than {0} parameters can't be called, the blueprint will fail to compile."),
+		FText::AsNumber(UKlawrScriptComponent::MaxCSFunctionArgs)
+	);
 }
 
 void UBPNode_KlawrFunctionCall::AllocateDefaultPins()
@@ -342,97 +345,105 @@ void UBPNode_KlawrFunctionCall::ExpandNode(class FKismetCompilerContext& Compile
 	Super::ExpandNode(CompilerContext, SourceGraph);
 
 	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
-	UEdGraphPin* currentExec = GetExecPin();
 
-	// Make an arg array
-	UK2Node_CallFunction* makeArgArray = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	makeArgArray->SetFromFunction(UKlawrArgArray::StaticClass()->FindFunctionByName(L"Create"));
-	makeArgArray->AllocateDefaultPins();
-	CompilerContext.MovePinLinksToIntermediate(*currentExec, *makeArgArray->GetExecPin());
-	currentExec = makeArgArray->GetThenPin();
-	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(makeArgArray, this);
-
-	// Iterate each parameter
-	for (UEdGraphPin* paramPin : Pins)
-	{
-		// Link only parameter pins
-		if (IsParameterPin(paramPin))
-		{
-			TCHAR* funcName = nullptr;
-			if (paramPin->PinType.PinCategory == K2Schema->PC_Float)
-			{
-				funcName = L"AddFloat";
-			}
-			else if (paramPin->PinType.PinCategory == K2Schema->PC_Int)
-			{
-				funcName = L"AddInt";
-			}
-			else if (paramPin->PinType.PinCategory == K2Schema->PC_Boolean)
-			{
-				funcName = L"AddBool";
-			}
-			else if (paramPin->PinType.PinCategory == K2Schema->PC_String)
-			{
-				funcName = L"AddString";
-			}
-			else if (paramPin->PinType.PinCategory == K2Schema->PC_Object)
-			{
-				funcName = L"AddObject";
-			}
-			if (funcName != nullptr)
-			{
-				// Call argArray->Add*
-				UK2Node_CallFunction* addArg = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-				addArg->SetFromFunction(UKlawrArgArray::StaticClass()->FindFunctionByName(funcName));
-				addArg->AllocateDefaultPins();
-				makeArgArray->GetReturnValuePin()->MakeLinkTo(addArg->FindPin(L"self"));
-				UEdGraphPin* argPin = addArg->FindPin(L"value");
-				if (paramPin->LinkedTo.Num() > 0)
-				{
-					paramPin->LinkedTo.Last()->MakeLinkTo(argPin);
-					addArg->NotifyPinConnectionListChanged(argPin);
-				}
-				else
-				{
-					argPin->PinType.PinCategory = paramPin->PinType.PinCategory;
-					argPin->DefaultValue = paramPin->DefaultValue;
-					addArg->PinDefaultValueChanged(argPin);
-				}
-				currentExec->MakeLinkTo(addArg->GetExecPin());
-				currentExec = addArg->GetThenPin();
-				CompilerContext.MessageLog.NotifyIntermediateObjectCreation(addArg, this);
-			}
-		}
-	}
-
-	// Call function
-	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UFunction* function = UKlawrScriptComponent::StaticClass()->FindFunctionByName(*RawFunctionName);
+	// The node expands into a single call to one of the InvokeCSFunction* thunks, which read the
+	// arguments straight off the stack, rather than creating a UKlawrArgArray and calling one of
+	// its Add* functions for each argument before calling the matching CallCSFunction* function.
+	FString invokeFunctionName = RawFunctionName;
+	invokeFunctionName.ReplaceInline(TEXT("CallCSFunction"), TEXT("InvokeCSFunction"));
+	UFunction* function = UKlawrScriptComponent::StaticClass()->FindFunctionByName(*invokeFunctionName);
 	if (function == NULL)
 	{
-		UE_LOG(LogKlawrEditorPlugin, Warning, TEXT("Function Name %s not found!"), *(RawFunctionName));
+		UE_LOG(LogKlawrEditorPlugin, Warning, TEXT("Function Name %s not found!"), *(invokeFunctionName));
 		BreakAllNodeLinks();
 		return;
 	}
+
+	UK2Node_CallFunction* CallFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
 	CallFunction->SetFromFunction(function);
 	CallFunction->AllocateDefaultPins();
-	currentExec->MakeLinkTo(CallFunction->GetExecPin());
-	currentExec = CallFunction->GetThenPin();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
 
-	UEdGraphPin* targetPin = CallFunction->Pins[2];
-	UEdGraphPin* functionPin = FindPin(FGetConfigNodeName::GetInputObjectPinName());
-	CompilerContext.MovePinLinksToIntermediate(*functionPin, *targetPin);
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFunction->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetThenPin(), *CallFunction->GetThenPin());
 
-	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFunction, this);
-	makeArgArray->GetReturnValuePin()->MakeLinkTo(CallFunction->FindPin(TEXT("args")));
+	UEdGraphPin* componentPin = FindPin(FGetConfigNodeName::GetInputObjectPinName());
+	CompilerContext.MovePinLinksToIntermediate(*componentPin, *CallFunction->FindPinChecked(K2Schema->PN_Self));
 
-	UE_LOG(LogKlawrEditorPlugin, Warning, TEXT("Function Name: %s"), *(this->FindPin(FGetConfigNodeName::GetFunctionNamePinName())->DefaultValue));
-	CallFunction->FindPin(TEXT("functionName"))->DefaultValue = this->FindPin(FGetConfigNodeName::GetFunctionNamePinName())->DefaultValue;
+	CallFunction->FindPinChecked(TEXT("functionName"))->DefaultValue = FindPin(FGetConfigNodeName::GetFunctionNamePinName())->DefaultValue;
 
-	UEdGraphPin* SelfNodeThen = FindPin(K2Schema->PN_Then);
+	// Each parameter is passed through one of the wildcard arguments of the thunk
+	int32 argTypes = 0;
+	int32 argIndex = 0;
+	for (UEdGraphPin* paramPin : Pins)
+	{
+		if (!IsParameterPin(paramPin))
+		{
+			continue;
+		}
+
+		int32 argType = INDEX_NONE;
+		if (paramPin->PinType.PinCategory == K2Schema->PC_Float)
+		{
+			argType = Klawr::VariantArgType::Float;
+		}
+		else if (paramPin->PinType.PinCategory == K2Schema->PC_Int)
+		{
+			argType = Klawr::VariantArgType::Int;
+		}
+		else if (paramPin->PinType.PinCategory == K2Schema->PC_Boolean)
+		{
+			argType = Klawr::VariantArgType::Bool;
+		}
+		else if (paramPin->PinType.PinCategory == K2Schema->PC_String)
+		{
+			argType = Klawr::VariantArgType::String;
+		}
+		else if (paramPin->PinType.PinCategory == K2Schema->PC_Object)
+		{
+			argType = Klawr::VariantArgType::Object;
+		}
+		if (argType == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (argIndex >= UKlawrScriptComponent::MaxCSFunctionArgs)
+		{
+			CompilerContext.MessageLog.Error(
+				*FString::Printf(
+					*LOCTEXT("TooManyArgs", "@@ calls a C# function with more than %d parameters.").ToString(),
+					UKlawrScriptComponent::MaxCSFunctionArgs
+				),
+				this
+			);
+			BreakAllNodeLinks();
+			return;
+		}
+
+		UEdGraphPin* argPin = CallFunction->FindPinChecked(FString::Printf(TEXT("arg%d"), argIndex));
+		argPin->PinType = paramPin->PinType;
+		if (paramPin->LinkedTo.Num() > 0)
+		{
+			CompilerContext.MovePinLinksToIntermediate(*paramPin, *argPin);
+		}
+		else
+		{
+			argPin->DefaultValue = paramPin->DefaultValue;
+			argPin->DefaultObject = paramPin->DefaultObject;
+		}
+		argTypes = UKlawrScriptComponent::PackCSFunctionArgType(argTypes, argIndex, argType);
+		++argIndex;
+	}
 
-	//Connect End
-	CompilerContext.MovePinLinksToIntermediate(*SelfNodeThen, *currentExec);
+	// The wildcard arguments that aren't used still need a type
+	for (; argIndex < UKlawrScriptComponent::MaxCSFunctionArgs; ++argIndex)
+	{
+		UEdGraphPin* argPin = CallFunction->FindPinChecked(FString::Printf(TEXT("arg%d"), argIndex));
+		argPin->PinType.PinCategory = K2Schema->PC_Int;
+		argPin->DefaultValue = TEXT("0");
+	}
+	CallFunction->FindPinChecked(TEXT("argTypes"))->DefaultValue = FString::FromInt(argTypes);
 
 	// Connect Result Pin
 	if (FindPin(FGetConfigNodeName::GetResultPinName())->LinkedTo.Num() > 0)
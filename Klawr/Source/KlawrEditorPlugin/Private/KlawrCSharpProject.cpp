@@ -80,28 +80,46 @@ bool FCSharpProject::SaveAs(const FString& InProjectFilename)
 	return true;
 }
 
-bool FCSharpProject::AddSourceFile(const FString& InSourceFilename, const FString& InLinkFilename)
+bool FCSharpProject::InitSourceNode()
 {
-	// look for an existing ItemGroup containing the source files
-	if (!SourceNode)
+	if (SourceNode)
 	{
-		SourceNode = XmlDoc.first_element_by_path(TEXT("/Project/ItemGroup/Compile")).parent();
+		return true;
 	}
 
+	// look for an existing ItemGroup containing the source files
+	SourceNode = XmlDoc.first_element_by_path(TEXT("/Project/ItemGroup/Compile")).parent();
+
 	// if the ItemGroup doesn't exist yet create it
 	if (!SourceNode)
 	{
 		SourceNode = XmlDoc.child(TEXT("Project")).append_child(TEXT("ItemGroup"));
 	}
-	
+
 	if (SourceNode)
+	{
+		for (auto CompileNode = SourceNode.child(TEXT("Compile")); 
+			CompileNode; 
+			CompileNode = CompileNode.next_sibling(TEXT("Compile")))
+		{
+			SourceFiles.Add(CompileNode.attribute(TEXT("Include")).value());
+		}
+	}
+	return !!SourceNode;
+}
+
+bool FCSharpProject::AddSourceFile(const FString& InSourceFilename, const FString& InLinkFilename)
+{
+	if (InitSourceNode())
 	{
 		FString SourceFilename = InSourceFilename;
 		FPaths::MakePathRelativeTo(SourceFilename, *ProjectFilename);
 		FPaths::MakePlatformFilename(SourceFilename);
 
 		// only add the source file if it's not already in the project
-		if (!SourceNode.find_child_by_attribute(TEXT("Compile"), TEXT("Include"), *SourceFilename))
+		bool bAlreadyInProject = false;
+		SourceFiles.Add(SourceFilename, &bAlreadyInProject);
+		if (!bAlreadyInProject)
 		{
 			auto CompileNode = SourceNode.append_child(TEXT("Compile"));
 			CompileNode.append_attribute(TEXT("Include")) = *SourceFilename;
@@ -67,12 +67,21 @@ private:
 
 	bool LoadFromFile(const FString& InProjectFilename);
 
+	/** 
+	 * Find (or create) the ItemGroup containing the source files, and record the source files
+	 * that are already in it.
+	 */
+	bool InitSourceNode();
+
 private:
 	// absolute path to .csproj file
 	FString ProjectFilename;
 	pugi::xml_document XmlDoc;
 	pugi::xml_node SourceNode;
 	pugi::xml_node ReferencesNode;
+	// paths of the source files in the project (as they appear in the .csproj), this is used to
+	// check for duplicates without scanning through all the Compile elements every time
+	TSet<FString> SourceFiles;
 };
 
 } // namespace Klawr
\ No newline at end of file
@@ -30,6 +30,8 @@
 #include "IKlawrRuntimePlugin.h"
 #include "KlawrGameProjectBuilder.h"
 #include "KlawrScriptsReloader.h"
+#include "KlawrScriptCompilerServer.h"
+#include "KlawrScriptBuildLog.h"
 
 DEFINE_LOG_CATEGORY(LogKlawrEditorPlugin);
 
@@ -77,7 +79,8 @@ private:
 		if (ensure(PIEAppDomainID == 0))
 		{
 			auto& Runtime = IKlawrRuntimePlugin::Get();
-			if (Runtime.CreateAppDomain(PIEAppDomainID))
+			// this will hand out the standby app domain if one has been prepared
+			if (Runtime.AcquireAppDomain(PIEAppDomainID))
 			{
 				Runtime.SetPIEAppDomainID(PIEAppDomainID);
 			}
@@ -143,6 +146,10 @@ public: // IModuleInterface interface
 	
 	virtual void StartupModule() override
 	{
+		// launch the compiler server first so it can warm up while the rest of the editor loads
+		FScriptCompilerServer::Startup();
+		FScriptBuildLog::RegisterLogListing();
+
         auto path = FGameProjectBuilder::GetProjectAssemblyFilename();
 		// check if game scripts assembly exists, if not build it
 		if (!FPaths::FileExists(path))
@@ -156,7 +163,10 @@ public: // IModuleInterface interface
 			}
 		}
 
-		IKlawrRuntimePlugin::Get().CreatePrimaryAppDomain();
+		if (IKlawrRuntimePlugin::Get().CreatePrimaryAppDomain())
+		{
+			IKlawrRuntimePlugin::Get().WriteBindingUsage(FGameProjectBuilder::GetBindingUsageFilename());
+		}
 				
 		// register asset types
 		auto& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
@@ -177,6 +187,8 @@ public: // IModuleInterface interface
 	virtual void ShutdownModule() override
 	{
 		FScriptsReloader::Shutdown();
+		FScriptCompilerServer::Shutdown();
+		FScriptBuildLog::UnregisterLogListing();
 
 		FEditorDelegates::BeginPIE.RemoveAll(this);
 		FEditorDelegates::EndPIE.RemoveAll(this);
@@ -195,6 +207,7 @@ public: // IModuleInterface interface
 			}
 		}
 
+		IKlawrRuntimePlugin::Get().DiscardStandbyAppDomain();
 		IKlawrRuntimePlugin::Get().DestroyPrimaryAppDomain();
 	}
 
@@ -25,12 +25,19 @@
 #include "KlawrEditorPluginPrivatePCH.h"
 #include "KlawrGameProjectBuilder.h"
 #include "KlawrCSharpProject.h"
-#include "FeedbackContextMarkup.h"
+#include "KlawrScriptCompilerServer.h"
+#include "KlawrScriptBuildLog.h"
 
 namespace Klawr {
 
 namespace FGameProjectBuilderInternal 
 {
+	/** 
+	 * Held for the duration of a build, builds write to the same output files (and share the 
+	 * compiler server) so they can't overlap.
+	 */
+	FCriticalSection BuildCS;
+
 	/** @return true if the .csproj was modified, false otherwise */
 	bool AddSourceFileToProject(const TSharedRef<FCSharpProject>& Project, const FString& SourceFilename, const TArray<FString>& SourceDirs)
 	{
@@ -64,6 +71,135 @@ namespace FGameProjectBuilderInternal
 			*FPaths::Combine(FPlatformProcess::BaseDir(), *AssemblyPDB)
 		);
 	}
+
+	/** Make sure the game scripts .csproj exists before attempting to build it. */
+	bool PrepareBuild(FOutputDevice* Output)
+	{
+		if (!FPaths::FileExists(FGameProjectBuilder::GetProjectFilename()))
+		{
+			if (!FGameProjectBuilder::GenerateProject())
+			{
+				// TODO: log error
+				Output->Log(TEXT("Error BuildProject: The project could not be created. The Project Template was not found."));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool FinishBuild(FScriptBuildLog& BuildLog, bool bBuildSucceeded)
+	{
+		BuildLog.Finish(bBuildSucceeded);
+		if (bBuildSucceeded)
+		{
+			FGameProjectBuilder::CopyPrivateReferencedAssemblies();
+		}
+		return bBuildSucceeded;
+	}
+
+	/** Get the command line that builds the game scripts project with MSBuild. */
+	bool GetBuildCommand(FOutputDevice* Output, FString& OutBuildFilename, FString& OutArgs)
+	{
+		FString EnvironmentSetupFilename;
+		if (!FPlatformMisc::GetVSComnTools(15 /* VS 2017 */, EnvironmentSetupFilename))
+		{
+			// TODO: log error
+			return false;
+		}
+		EnvironmentSetupFilename /= TEXT("../../VC/Auxiliary/Build/vcvarsx86_amd64.bat");
+		FPaths::CollapseRelativeDirectories(EnvironmentSetupFilename);
+		FPaths::MakePlatformFilename(EnvironmentSetupFilename);
+
+		if (!FPaths::FileExists(EnvironmentSetupFilename))
+		{
+			// TODO: log error
+			Output->Log(TEXT("Error EnvironmentSetupFilename:"));
+			return false;
+		}
+
+		const FString& ProjectFilename = FGameProjectBuilder::GetProjectFilename();
+		OutBuildFilename = FPaths::GetPath(ProjectFilename) / TEXT("Build.bat");
+		FPaths::CollapseRelativeDirectories(OutBuildFilename);
+		FPaths::MakePlatformFilename(OutBuildFilename);
+		OutArgs = FString::Printf(
+			TEXT("\"%s\" %s"), 
+			*EnvironmentSetupFilename, *FPaths::GetCleanFilename(ProjectFilename)
+		);
+		return true;
+	}
+
+	/** Pass on the complete lines in Buffer to Output, the incomplete last line is left in Buffer. */
+	void LogProcessOutput(FString& Buffer, FOutputDevice* Output)
+	{
+		int32 LineEnd = INDEX_NONE;
+		while (Buffer.FindChar(TEXT('\n'), LineEnd))
+		{
+			FString Line = Buffer.Left(LineEnd);
+			Line.TrimTrailing();
+			Output->Log(*Line);
+			Buffer = Buffer.Mid(LineEnd + 1);
+		}
+	}
+
+	/** 
+	 * Run a build process to completion, the output is passed on line by line while the process
+	 * is running. Can be used from any thread.
+	 * @param ShouldCancel Called periodically while the process is running, the process will be 
+	 *                     terminated as soon as this returns true.
+	 * @return false if the process couldn't be launched or was terminated, true otherwise
+	 */
+	bool RunBuildProcess(
+		const FString& URL, const FString& Args, FOutputDevice* Output, 
+		TFunctionRef<bool()> ShouldCancel, int32& OutReturnCode
+	)
+	{
+		void* PipeRead = nullptr;
+		void* PipeWrite = nullptr;
+		if (!FPlatformProcess::CreatePipe(PipeRead, PipeWrite))
+		{
+			return false;
+		}
+
+		FProcHandle ProcessHandle = FPlatformProcess::CreateProc(
+			*URL, *Args, false /* bLaunchDetached */, true /* bLaunchHidden */, 
+			true /* bLaunchReallyHidden */, nullptr, 0, nullptr, PipeWrite
+		);
+		if (!ProcessHandle.IsValid())
+		{
+			FPlatformProcess::ClosePipe(PipeRead, PipeWrite);
+			return false;
+		}
+
+		bool bCanceled = false;
+		FString Buffer;
+		while (FPlatformProcess::IsProcRunning(ProcessHandle))
+		{
+			if (ShouldCancel())
+			{
+				FPlatformProcess::TerminateProc(ProcessHandle, true /* KillTree */);
+				bCanceled = true;
+				break;
+			}
+			Buffer += FPlatformProcess::ReadPipe(PipeRead);
+			LogProcessOutput(Buffer, Output);
+			FPlatformProcess::Sleep(0.01f);
+		}
+		Buffer += FPlatformProcess::ReadPipe(PipeRead);
+		Buffer += TEXT("\n");
+		LogProcessOutput(Buffer, Output);
+
+		if (bCanceled)
+		{
+			Output->Log(TEXT("Compiling Scripts canceled."));
+		}
+		else if (!FPlatformProcess::GetProcReturnCode(ProcessHandle, &OutReturnCode))
+		{
+			OutReturnCode = -1;
+		}
+		FPlatformProcess::CloseProc(ProcessHandle);
+		FPlatformProcess::ClosePipe(PipeRead, PipeWrite);
+		return !bCanceled;
+	}
 } // FGameProjectBuilderInternal
 
 const FString& FGameProjectBuilder::GetProjectFilename()
@@ -284,59 +420,85 @@ const FString& FGameProjectBuilder::GetOutputDir()
 	return OutputDir;
 }
 
+const FString& FGameProjectBuilder::GetBindingUsageFilename()
+{
+	static const FString UsageFilename = FPaths::ConvertRelativePathToFull(
+		FPaths::GameIntermediateDir() / TEXT("Klawr/BindingUsage.txt")
+	);
+	return UsageFilename;
+}
+
 bool FGameProjectBuilder::BuildProject(FFeedbackContext* Warn)
 {
-	// make sure the game scripts .csproj exists before attempting to build it
-	if (!FPaths::FileExists(GetProjectFilename()))
+	FScopeLock BuildLock(&FGameProjectBuilderInternal::BuildCS);
+	// errors and warnings are added to the message log as soon as they're reported
+	FScriptBuildLog BuildLog(Warn);
+	bool bBuildSucceeded = false;
+	if (!FGameProjectBuilderInternal::PrepareBuild(&BuildLog) || 
+		FScriptCompilerServer::Build(&BuildLog, bBuildSucceeded))
 	{
-		if (!GenerateProject())
-		{
-			// TODO: log error
-            Warn->Log(TEXT("Error BuildProject: The project could not be created. The Project Template was not found."));
-            return false;
-		}
+		return FGameProjectBuilderInternal::FinishBuild(BuildLog, bBuildSucceeded);
 	}
 
-	FString EnvironmentSetupFilename;
-	if (!FPlatformMisc::GetVSComnTools(15 /* VS 2017 */, EnvironmentSetupFilename))
+	FString BuildFilename, Args;
+	if (!FGameProjectBuilderInternal::GetBuildCommand(&BuildLog, BuildFilename, Args))
 	{
-		// TODO: log error
 		return false;
 	}
-	EnvironmentSetupFilename /= TEXT("../../VC/Auxiliary/Build/vcvarsx86_amd64.bat");
-	FPaths::CollapseRelativeDirectories(EnvironmentSetupFilename);
-	FPaths::MakePlatformFilename(EnvironmentSetupFilename);
 
-	if (!FPaths::FileExists(EnvironmentSetupFilename))
-	{
-		// TODO: log error
-        Warn->Log(TEXT("Error EnvironmentSetupFilename:"));
-        return false;
-	}
+	BuildLog.Log(TEXT("Compiling Scripts..."));
+	BuildLog.Logf(TEXT("Running %s %s"), *BuildFilename, *Args);
 
-	FString BuildFilename = FPaths::GetPath(GetProjectFilename()) / TEXT("Build.bat");
-	FPaths::CollapseRelativeDirectories(BuildFilename);
-	FPaths::MakePlatformFilename(BuildFilename);
-	FString Args = FString::Printf(
-		TEXT("\"%s\" %s"), 
-		*EnvironmentSetupFilename, *FPaths::GetCleanFilename(GetProjectFilename())
+	FScopedSlowTask SlowTask(
+		0, NSLOCTEXT("KlawrGameProjectBuilder", "CompilingScripts", "Compiling Scripts...")
 	);
-
-	Warn->Log(TEXT("Compiling Scripts..."));
-	Warn->Logf(TEXT("Running %s %s"), *BuildFilename, *Args);
+	SlowTask.MakeDialog(true /* bShowCancelButton */);
 
 	int32 ReturnCode = -1; // zero will indicate success
-	bool bBuildExecuted = FFeedbackContextMarkup::PipeProcessOutput(
-		NSLOCTEXT("KlawrGameProjectBuilder", "CompilingScripts", "Compiling Scripts..."), 
-		BuildFilename, Args, Warn, &ReturnCode
+	bool bBuildExecuted = FGameProjectBuilderInternal::RunBuildProcess(
+		BuildFilename, Args, &BuildLog, 
+		[&SlowTask, &BuildLog]()
+		{
+			// keep the progress dialog responsive while the build is running
+			SlowTask.EnterProgressFrame(0);
+			return SlowTask.ShouldCancel() || BuildLog.ShouldAbort();
+		},
+		ReturnCode
 	);
-	bool bBuildSucceeded = bBuildExecuted && (ReturnCode == 0);
+	return FGameProjectBuilderInternal::FinishBuild(BuildLog, bBuildExecuted && (ReturnCode == 0));
+}
+
+bool FGameProjectBuilder::BuildProjectInBackground(FOutputDevice* Output, const FThreadSafeBool* bCancel)
+{
+	FScopeLock BuildLock(&FGameProjectBuilderInternal::BuildCS);
+	FScriptBuildLog BuildLog(Output);
+	bool bBuildSucceeded = false;
+	// the compiler server can't be interrupted, but its builds are quick so there's no need to
+	if (!FGameProjectBuilderInternal::PrepareBuild(&BuildLog) || 
+		FScriptCompilerServer::Build(&BuildLog, bBuildSucceeded))
+	{
+		return FGameProjectBuilderInternal::FinishBuild(BuildLog, bBuildSucceeded);
+	}
 
-	if (bBuildSucceeded)
+	FString BuildFilename, Args;
+	if (!FGameProjectBuilderInternal::GetBuildCommand(&BuildLog, BuildFilename, Args))
 	{
-		CopyPrivateReferencedAssemblies();
+		return false;
 	}
-	return bBuildSucceeded;
+
+	BuildLog.Log(TEXT("Compiling Scripts..."));
+	BuildLog.Logf(TEXT("Running %s %s"), *BuildFilename, *Args);
+
+	int32 ReturnCode = -1; // zero will indicate success
+	bool bBuildExecuted = FGameProjectBuilderInternal::RunBuildProcess(
+		BuildFilename, Args, &BuildLog, 
+		[bCancel, &BuildLog]()
+		{
+			return (bCancel && *bCancel) || BuildLog.ShouldAbort();
+		},
+		ReturnCode
+	);
+	return FGameProjectBuilderInternal::FinishBuild(BuildLog, bBuildExecuted && (ReturnCode == 0));
 }
 
 void FGameProjectBuilder::CopyPrivateReferencedAssemblies()
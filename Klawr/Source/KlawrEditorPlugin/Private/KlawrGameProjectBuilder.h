@@ -51,7 +51,26 @@ public:
 	static const FString& GetProjectAssemblyName();
 	static const FString& GetProjectAssemblyFilename();
 	static const FString& GetOutputDir();
+	/** 
+	 * Get the path to the file that lists the wrapper class members referenced by the game 
+	 * scripts assembly, the code generator expects to find it in the same location.
+	 */
+	static const FString& GetBindingUsageFilename();
+	/** 
+	 * Build the game scripts assembly while displaying a progress dialog, the build output is 
+	 * passed on to Warn. Errors and warnings are also added to the Klawr Scripts message log (see
+	 * FScriptBuildLog), and the build is abandoned once MaxBuildErrors errors have been reported.
+	 * If another build is in progress this waits for it to finish first.
+	 */
 	static bool BuildProject(FFeedbackContext* Warn);
+	/**
+	 * Build the game scripts assembly without displaying any progress UI, unlike BuildProject()
+	 * this can be called from any thread. If another build is in progress this waits for it to 
+	 * finish first.
+	 * @param Output Receives the build output, must be thread-safe (e.g. GLog).
+	 * @param bCancel If not null the build will be abandoned as soon as possible after this is set.
+	 */
+	static bool BuildProjectInBackground(FOutputDevice* Output, const FThreadSafeBool* bCancel);
 	/** Copy private referenced assemblies to a location they can be loaded from at runtime. */
 	static void CopyPrivateReferencedAssemblies();
 };
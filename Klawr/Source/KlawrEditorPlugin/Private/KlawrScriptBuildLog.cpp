@@ -0,0 +1,196 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+
+#include "KlawrEditorPluginPrivatePCH.h"
+#include "KlawrScriptBuildLog.h"
+#include "MessageLogModule.h"
+#include "MessageLog.h"
+#include "SourceCodeNavigation.h"
+#include "Regex.h"
+#include "Async.h"
+
+#define LOCTEXT_NAMESPACE "KlawrEditorPlugin.ScriptBuildLog"
+
+namespace Klawr {
+
+namespace FScriptBuildLogInternal
+{
+	/** 
+	 * Matches "File(Line,Column): error Code: Text [Project]", the location and project are 
+	 * optional (e.g. "CSC : error CS2001: Source file 'Foo.cs' could not be found").
+	 */
+	const TCHAR* const DiagnosticPattern = 
+		TEXT("^\\s*(.*?)(?:\\((\\d+),(\\d+)\\))?\\s*:\\s*(error|warning)\\s+(\\w+)\\s*:\\s*(.*?)(?:\\s+\\[[^\\]]*\\])?\\s*$");
+
+	int32 GetMaxBuildErrors()
+	{
+		int32 MaxErrors = 0;
+		const FString ConfigFilename = FPaths::ConvertRelativePathToFull(
+			FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Resources/Config.ini")
+		);
+		GConfig->GetInt(TEXT("Config"), TEXT("MaxBuildErrors"), MaxErrors, ConfigFilename);
+		return MaxErrors;
+	}
+} // namespace FScriptBuildLogInternal
+
+const FName FScriptBuildLog::LogName(TEXT("KlawrScripts"));
+
+void FScriptBuildLog::RegisterLogListing()
+{
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	FMessageLogInitializationOptions InitOptions;
+	InitOptions.bShowPages = true;
+	InitOptions.bShowFilters = true;
+	MessageLogModule.RegisterLogListing(
+		LogName, LOCTEXT("ScriptsLogLabel", "Klawr Scripts"), InitOptions
+	);
+}
+
+void FScriptBuildLog::UnregisterLogListing()
+{
+	// the message log module may have been unloaded already
+	FMessageLogModule* MessageLogModule = FModuleManager::GetModulePtr<FMessageLogModule>("MessageLog");
+	if (MessageLogModule)
+	{
+		MessageLogModule->UnregisterLogListing(LogName);
+	}
+}
+
+FScriptBuildLog::FScriptBuildLog(FOutputDevice* InOutput)
+	: Output(InOutput)
+	, MaxErrors(FScriptBuildLogInternal::GetMaxBuildErrors())
+	, NumErrors(0)
+	, bAbort(false)
+{
+	const FText PageLabel = FText::Format(
+		LOCTEXT("BuildPageLabel", "Compile Scripts: {0}"), FText::AsDateTime(FDateTime::Now())
+	);
+	RunOnGameThread([PageLabel]()
+	{
+		FMessageLog(LogName).NewPage(PageLabel);
+	});
+}
+
+void FScriptBuildLog::Finish(bool bBuildSucceeded)
+{
+	if (!bBuildSucceeded)
+	{
+		RunOnGameThread([]()
+		{
+			FMessageLog(LogName).Notify(LOCTEXT("BuildFailed", "Compiling Scripts failed"));
+		});
+	}
+}
+
+void FScriptBuildLog::Serialize(
+	const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category
+)
+{
+	Output->Serialize(V, Verbosity, Category);
+	ParseLine(V);
+}
+
+void FScriptBuildLog::ParseLine(const FString& Line)
+{
+	// compiling the pattern isn't cheap, and there may be thousands of lines of output
+	static const FRegexPattern Pattern(FScriptBuildLogInternal::DiagnosticPattern);
+	FRegexMatcher Matcher(Pattern, Line);
+	if (!Matcher.FindNext())
+	{
+		return;
+	}
+
+	bool bAlreadyReported = false;
+	ReportedLines.Add(Line.Trim(), &bAlreadyReported);
+	if (bAlreadyReported)
+	{
+		return;
+	}
+
+	FString Filename = Matcher.GetCaptureGroup(1).Trim().TrimTrailing();
+	const FString LineNumber = Matcher.GetCaptureGroup(2);
+	const FString ColumnNumber = Matcher.GetCaptureGroup(3);
+	const bool bIsError = (Matcher.GetCaptureGroup(4) == TEXT("error"));
+	const FString Code = Matcher.GetCaptureGroup(5);
+	const FString Text = Matcher.GetCaptureGroup(6);
+
+	// only a location with a line number refers to a source file (rather than e.g. "CSC")
+	const bool bHasSourceLocation = !LineNumber.IsEmpty() && !Filename.IsEmpty();
+	if (bHasSourceLocation)
+	{
+		Filename = FPaths::ConvertRelativePathToFull(Filename);
+	}
+
+	RunOnGameThread([=]()
+	{
+		TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(
+			bIsError ? EMessageSeverity::Error : EMessageSeverity::Warning
+		);
+		if (bHasSourceLocation)
+		{
+			const int32 SourceLine = FCString::Atoi(*LineNumber);
+			const int32 SourceColumn = FCString::Atoi(*ColumnNumber);
+			Message->AddToken(FActionToken::Create(
+				FText::FromString(FString::Printf(
+					TEXT("%s(%d,%d)"), *FPaths::GetCleanFilename(Filename), SourceLine, SourceColumn
+				)),
+				FText::FromString(Filename),
+				FOnActionTokenExecuted::CreateLambda([Filename, SourceLine, SourceColumn]()
+				{
+					FSourceCodeNavigation::OpenSourceFile(Filename, SourceLine, SourceColumn);
+				})
+			));
+		}
+		Message->AddToken(FTextToken::Create(
+			FText::FromString(FString::Printf(TEXT("%s: %s"), *Code, *Text))
+		));
+		FMessageLog(LogName).AddMessage(Message);
+	});
+
+	if (bIsError)
+	{
+		++NumErrors;
+		if ((MaxErrors > 0) && (NumErrors >= MaxErrors) && !bAbort)
+		{
+			bAbort = true;
+			Output->Logf(TEXT("Abandoning build after %d error(s)."), NumErrors);
+		}
+	}
+}
+
+void FScriptBuildLog::RunOnGameThread(TFunction<void()> Function)
+{
+	if (IsInGameThread())
+	{
+		Function();
+	}
+	else
+	{
+		AsyncTask(ENamedThreads::GameThread, MoveTemp(Function));
+	}
+}
+
+} // namespace Klawr
+
+#undef LOCTEXT_NAMESPACE
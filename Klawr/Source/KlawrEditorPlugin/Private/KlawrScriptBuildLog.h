@@ -0,0 +1,84 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#pragma once
+
+namespace Klawr {
+
+/**
+ * @brief Passes on the output of a game scripts build, and picks out the errors and warnings as 
+ *        they're written so they show up in the Klawr Scripts message log while the build is 
+ *        still running.
+ *
+ * Diagnostics are expected to be in the format used by MSBuild and the C# compiler, e.g.
+ * Path\To\File.cs(12,34): error CS1002: ; expected
+ * Clicking the location of a diagnostic in the message log opens the source file.
+ */
+class FScriptBuildLog : public FOutputDevice
+{
+public:
+	/** Name of the message log listing the diagnostics are added to. */
+	static const FName LogName;
+
+	static void RegisterLogListing();
+	static void UnregisterLogListing();
+
+	/** 
+	 * Start a new page in the message log for a build.
+	 * @param InOutput Receives all the build output.
+	 */
+	explicit FScriptBuildLog(FOutputDevice* InOutput);
+
+	/** 
+	 * Check if the build has reported enough errors that it should be abandoned rather than 
+	 * left to run to completion (see MaxBuildErrors in Config.ini).
+	 */
+	bool ShouldAbort() const { return bAbort; }
+	/** Let the user know if the build failed, call this once the build is done. */
+	void Finish(bool bBuildSucceeded);
+
+public: // FOutputDevice interface
+	virtual void Serialize(
+		const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category
+	) override;
+	virtual bool CanBeUsedOnAnyThread() const override { return true; }
+
+private:
+	/** Add a message to the log if the given line of output contains a diagnostic. */
+	void ParseLine(const FString& Line);
+	/** The message log can only be accessed from the game thread. */
+	static void RunOnGameThread(TFunction<void()> Function);
+
+private:
+	FOutputDevice* Output;
+	int32 MaxErrors;
+	int32 NumErrors;
+	bool bAbort;
+	/** 
+	 * MSBuild repeats all the errors and warnings in a summary at the end of the build, only the
+	 * first occurrence of each one is added to the log.
+	 */
+	TSet<FString> ReportedLines;
+};
+
+} // namespace Klawr
@@ -0,0 +1,191 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+
+#include "KlawrEditorPluginPrivatePCH.h"
+#include "KlawrScriptCompilerServer.h"
+#include "KlawrGameProjectBuilder.h"
+#include "InteractiveProcess.h"
+
+namespace Klawr {
+
+namespace FScriptCompilerServerInternal
+{
+	// must match the constants in Klawr.ScriptCompiler
+	const TCHAR* const BuildSucceeded = TEXT("@@KLAWR BUILD SUCCEEDED");
+	const TCHAR* const BuildFailed = TEXT("@@KLAWR BUILD FAILED");
+
+	/** How long to wait for the server to finish a build before giving up on it. */
+	const double BuildTimeout = 120.0;
+
+	bool IsServerEnabled()
+	{
+		bool bEnabled = true;
+		const FString ConfigFilename = FPaths::ConvertRelativePathToFull(
+			FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Resources/Config.ini")
+		);
+		GConfig->GetBool(TEXT("Config"), TEXT("UseScriptCompilerServer"), bEnabled, ConfigFilename);
+		return bEnabled;
+	}
+} // namespace FScriptCompilerServerInternal
+
+FInteractiveProcess* FScriptCompilerServer::Process = nullptr;
+TArray<FString> FScriptCompilerServer::PendingOutput;
+FCriticalSection FScriptCompilerServer::PendingOutputCS;
+
+FString FScriptCompilerServer::GetServerFilename()
+{
+	// KlawrClrHostNative.Build.cs copies the server to the engine binaries directory
+	return FPaths::ConvertRelativePathToFull(
+		FPaths::Combine(FPlatformProcess::BaseDir(), TEXT("KlawrScriptCompiler/Klawr.ScriptCompiler.exe"))
+	);
+}
+
+void FScriptCompilerServer::Startup()
+{
+	if (Process || !FScriptCompilerServerInternal::IsServerEnabled())
+	{
+		return;
+	}
+
+	const FString ServerFilename = GetServerFilename();
+	if (!FPaths::FileExists(ServerFilename))
+	{
+		UE_LOG(
+			LogKlawrEditorPlugin, Log, 
+			TEXT("Script compiler server not found at %s, scripts will be built with MSBuild."), 
+			*ServerFilename
+		);
+		return;
+	}
+
+	FString ProjectFilename = FPaths::ConvertRelativePathToFull(FGameProjectBuilder::GetProjectFilename());
+	FPaths::MakePlatformFilename(ProjectFilename);
+	Process = new FInteractiveProcess(
+		ServerFilename, FString::Printf(TEXT("\"%s\""), *ProjectFilename), true /* Hidden */, 
+		true /* LongTime */
+	);
+	Process->OnOutput().BindStatic(&FScriptCompilerServer::OnOutput);
+	Process->OnCompleted().BindStatic(&FScriptCompilerServer::OnCompleted);
+	if (!Process->Launch())
+	{
+		UE_LOG(LogKlawrEditorPlugin, Warning, TEXT("Failed to launch script compiler server."));
+		delete Process;
+		Process = nullptr;
+	}
+}
+
+void FScriptCompilerServer::Shutdown()
+{
+	if (Process)
+	{
+		// the server doesn't hold on to anything that needs to be cleaned up
+		Process->Cancel(true);
+		delete Process;
+		Process = nullptr;
+	}
+	FScopeLock Lock(&PendingOutputCS);
+	PendingOutput.Empty();
+}
+
+bool FScriptCompilerServer::IsRunning()
+{
+	return Process && Process->IsRunning();
+}
+
+void FScriptCompilerServer::OnOutput(const FString& Line)
+{
+	FScopeLock Lock(&PendingOutputCS);
+	PendingOutput.Add(Line);
+}
+
+void FScriptCompilerServer::OnCompleted(int32 ReturnCode, bool bCanceling)
+{
+	if (!bCanceling)
+	{
+		UE_LOG(
+			LogKlawrEditorPlugin, Warning, 
+			TEXT("Script compiler server exited unexpectedly (code %d)."), ReturnCode
+		);
+	}
+}
+
+bool FScriptCompilerServer::Build(FOutputDevice* Output, bool& bOutBuildSucceeded)
+{
+	using namespace FScriptCompilerServerInternal;
+
+	bOutBuildSucceeded = false;
+	if (!IsRunning())
+	{
+		return false;
+	}
+
+	{
+		// anything the server wrote while idle (e.g. warnings about a broken project) isn't
+		// part of this build
+		FScopeLock Lock(&PendingOutputCS);
+		for (const FString& Line : PendingOutput)
+		{
+			UE_LOG(LogKlawrEditorPlugin, Log, TEXT("%s"), *Line);
+		}
+		PendingOutput.Reset();
+	}
+
+	Output->Log(TEXT("Compiling Scripts..."));
+	Process->SendWhenReady(TEXT("build\n"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FString> Lines;
+	while (IsRunning() && ((FPlatformTime::Seconds() - StartTime) < BuildTimeout))
+	{
+		{
+			FScopeLock Lock(&PendingOutputCS);
+			Lines = MoveTemp(PendingOutput);
+			PendingOutput.Reset();
+		}
+		for (FString& Line : Lines)
+		{
+			Line.TrimTrailing();
+			if (Line == BuildSucceeded || Line == BuildFailed)
+			{
+				bOutBuildSucceeded = (Line == BuildSucceeded);
+				return true;
+			}
+			// errors and warnings use the same format as MSBuild so they'll be picked up by the 
+			// message log like any other build output
+			Output->Log(*Line);
+		}
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	// the server is unusable if it stopped responding, so kill it and let the caller fall back 
+	// to MSBuild (the process itself is cleaned up by Shutdown() on the game thread)
+	Output->Log(TEXT("Script compiler server stopped responding."));
+	if (Process->IsRunning())
+	{
+		Process->Cancel(true);
+	}
+	return false;
+}
+
+} // namespace Klawr
@@ -0,0 +1,74 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#pragma once
+
+class FInteractiveProcess;
+
+namespace Klawr {
+
+/**
+ * @brief Builds the game scripts with a long running compiler server (Klawr.ScriptCompiler).
+ *
+ * Running MSBuild for every rebuild means paying for the startup of MSBuild and the C# compiler
+ * every time, and reparsing every source file. The compiler server stays loaded for as long as the
+ * editor is running and only reparses the source files that changed since the previous build, it
+ * writes the game scripts assembly directly to the project output directory.
+ * The server is optional, if it's disabled (see UseScriptCompilerServer in Config.ini) or isn't 
+ * available FGameProjectBuilder falls back to MSBuild.
+ */
+class FScriptCompilerServer
+{
+public:
+	/** Launch the server if it's enabled, does nothing if the server is already running. */
+	static void Startup();
+	/** Shut down the server. */
+	static void Shutdown();
+	/** Check if the server is ready to take build requests. */
+	static bool IsRunning();
+	/**
+	 * Build the game scripts project, blocks until the build is done. Can be called from any 
+	 * thread, but only one build may be in progress at a time (FGameProjectBuilder takes care 
+	 * of that).
+	 * @param Output Receives the build output.
+	 * @param bOutBuildSucceeded Set to true if the build succeeded, false otherwise.
+	 * @return false if the server couldn't handle the request (e.g. because it isn't running or 
+	 *         stopped responding), in which case the project should be built some other way.
+	 */
+	static bool Build(FOutputDevice* Output, bool& bOutBuildSucceeded);
+
+private:
+	/** Called on the process reader thread for each line the server writes to stdout. */
+	static void OnOutput(const FString& Line);
+	static void OnCompleted(int32 ReturnCode, bool bCanceling);
+
+	static FString GetServerFilename();
+
+private:
+	static FInteractiveProcess* Process;
+	/** Output lines received since the last time they were passed on to the build log. */
+	static TArray<FString> PendingOutput;
+	static FCriticalSection PendingOutputCS;
+};
+
+} // namespace Klawr
@@ -25,11 +25,16 @@
 #include "KlawrEditorPluginPrivatePCH.h"
 #include "KlawrScriptsReloader.h"
 #include "KlawrGameProjectBuilder.h"
+#include "KlawrScriptCompilerServer.h"
 #include "DirectoryWatcherModule.h"
 #include "IKlawrRuntimePlugin.h"
+#include "NotificationManager.h"
+#include "SNotificationList.h"
 //#include "UnrealEd.h"
 //#include "GlobalEditorNotification.h"
 //
+#define LOCTEXT_NAMESPACE "KlawrScriptsReloader"
+
 namespace Klawr {
 //
 ///** Notification class for asynchronous shader compiling. */
@@ -52,6 +57,32 @@ namespace Klawr {
 ///** Global notification object. */
 //FRelodedNotificationImpl NotificationObject;
 
+namespace {
+
+/** Check if PreserveScriptStateOnReload is enabled in Config.ini (it is by default). */
+bool ShouldPreserveScriptState()
+{
+	bool bPreserve = true;
+	const FString ConfigFilename = FPaths::ConvertRelativePathToFull(
+		FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Resources/Config.ini")
+	);
+	GConfig->GetBool(TEXT("Config"), TEXT("PreserveScriptStateOnReload"), bPreserve, ConfigFilename);
+	return bPreserve;
+}
+
+/** Check if UseStandbyAppDomain is enabled in Config.ini (it is by default). */
+bool ShouldUseStandbyAppDomain()
+{
+	bool bUseStandby = true;
+	const FString ConfigFilename = FPaths::ConvertRelativePathToFull(
+		FPaths::EnginePluginsDir() / TEXT("Klawr/Klawr/Resources/Config.ini")
+	);
+	GConfig->GetBool(TEXT("Config"), TEXT("UseStandbyAppDomain"), bUseStandby, ConfigFilename);
+	return bUseStandby;
+}
+
+} // unnamed namespace
+
 FScriptsReloader* FScriptsReloader::Singleton = nullptr;
 
 void FScriptsReloader::Startup()
@@ -80,6 +111,27 @@ FScriptsReloader::~FScriptsReloader()
 	{
 		Disable();
 	}
+	// the build must not outlive the things it's using (e.g. the compiler server)
+	if (PendingBuild.IsValid())
+	{
+		bCancelBuildRequested = true;
+		PendingBuild.Wait();
+	}
+}
+
+void FScriptsReloader::OnScriptFilesChanged()
+{
+	TimeOfLastModification = TimeSinceLastRefresh;
+	if (FirstEditTime == 0)
+	{
+		FirstEditTime = FPlatformTime::Seconds();
+	}
+	// the build in progress won't include this change, so there's no point in finishing it
+	if (PendingBuild.IsValid())
+	{
+		bBuildOutdated = true;
+		bCancelBuildRequested = true;
+	}
 }
 
 void FScriptsReloader::OnSourceDirChanged(const TArray<FFileChangeData>& InFileChanges)
@@ -102,7 +154,7 @@ void FScriptsReloader::OnSourceDirChanged(const TArray<FFileChangeData>& InFileC
 					{
 						NewScriptFiles.AddUnique(Filename);
 					}
-					TimeOfLastModification = TimeSinceLastRefresh;
+					OnScriptFilesChanged();
 					break;
 
 				case FFileChangeData::FCA_Modified:
@@ -112,7 +164,7 @@ void FScriptsReloader::OnSourceDirChanged(const TArray<FFileChangeData>& InFileC
 						// we only need to know that files were modified, the names are only
 						// useful for debugging
 						ModifiedScriptFiles.AddUnique(Filename);
-						TimeOfLastModification = TimeSinceLastRefresh;
+						OnScriptFilesChanged();
 					}
 					break;
 
@@ -259,7 +311,7 @@ bool FScriptsReloader::ReloadScripts()
 	if (CurrentScriptsAssemblyTimeStamp != LastScriptsAssemblyTimeStamp)
 	{
 		LastScriptsAssemblyTimeStamp = CurrentScriptsAssemblyTimeStamp;
-		if (!IKlawrRuntimePlugin::Get().ReloadPrimaryAppDomain())
+		if (!IKlawrRuntimePlugin::Get().ReloadPrimaryAppDomain(ShouldPreserveScriptState()))
 		{
 			UE_LOG(
 				LogKlawrEditorPlugin, Warning,
@@ -267,6 +319,7 @@ bool FScriptsReloader::ReloadScripts()
 			);
 			return false;
 		}
+		IKlawrRuntimePlugin::Get().WriteBindingUsage(FGameProjectBuilder::GetBindingUsageFilename());
 	}
 
 	return true;
@@ -275,7 +328,6 @@ bool FScriptsReloader::ReloadScripts()
 void FScriptsReloader::Tick(float DeltaTime)
 {
 	TimeSinceLastRefresh += DeltaTime;
-	bool bReload = false;
 
 	// don't rebuild/reload while in PIE, delay until PIE exits
 	if (bIsPIEActive)
@@ -283,9 +335,21 @@ void FScriptsReloader::Tick(float DeltaTime)
 		return;
 	}
 
+	if (PendingBuild.IsValid())
+	{
+		if (!PendingBuild.IsReady())
+		{
+			return;
+		}
+		const bool bBuildSucceeded = PendingBuild.Get();
+		PendingBuild = TFuture<bool>();
+		FinishBuild(bBuildSucceeded);
+	}
+
 	// this is how long we should wait (in seconds) after a user changes or adds a script file,
-	// or the game scripts assembly is modified (possibly because the user rebuilt it)
-	const double RefreshDelay = 3;
+	// or the game scripts assembly is modified (possibly because the user rebuilt it), builds are
+	// cheap when the compiler server is running so there's no need to wait as long
+	const double RefreshDelay = FScriptCompilerServer::IsRunning() ? 0.5 : 3;
 	if ((TimeSinceLastRefresh - TimeOfLastModification) < RefreshDelay)
 	{
 		return;
@@ -297,7 +361,6 @@ void FScriptsReloader::Tick(float DeltaTime)
 	}
 
 	bool bProjectModified = false;
-	bool bBuildFailed = false;
 	
 	if (NewScriptFiles.Num())
 	{
@@ -309,12 +372,135 @@ void FScriptsReloader::Tick(float DeltaTime)
 	if (bProjectModified || ModifiedScriptFiles.Num())
 	{
 		ModifiedScriptFiles.Reset();
-		bBuildFailed = !FGameProjectBuilder::BuildProject(GWarn);
+		StartBuild();
 	}
-	
-	if (!bBuildFailed)
+	else
 	{
-		ReloadScripts();
+		const FDateTime PreviousScriptsAssemblyTimeStamp = LastScriptsAssemblyTimeStamp;
+		if (ReloadScripts() && (LastScriptsAssemblyTimeStamp == PreviousScriptsAssemblyTimeStamp) &&
+			ShouldUseStandbyAppDomain())
+		{
+			// the game scripts assembly hasn't changed since the last refresh, so get an app 
+			// domain ready for the next PIE session while the editor is idle
+			IKlawrRuntimePlugin::Get().PrepareStandbyAppDomain();
+		}
+	}
+}
+
+void FScriptsReloader::CancelBuild()
+{
+	if (PendingBuild.IsValid())
+	{
+		bCancelBuildRequested = true;
+	}
+}
+
+void FScriptsReloader::StartBuild()
+{
+	bCancelBuildRequested = false;
+	bBuildOutdated = false;
+	BuildStartTime = FPlatformTime::Seconds();
+	++Stats.NumBuilds;
+	ShowBuildNotification();
+
+	const FThreadSafeBool* bCancel = &bCancelBuildRequested;
+	PendingBuild = Async<bool>(EAsyncExecution::Thread, [bCancel]()
+	{
+		return FGameProjectBuilder::BuildProjectInBackground(GLog, bCancel);
+	});
+}
+
+void FScriptsReloader::FinishBuild(bool bBuildSucceeded)
+{
+	const double BuildTime = FPlatformTime::Seconds() - BuildStartTime;
+	Stats.LastBuildTime = BuildTime;
+	Stats.TotalBuildTime += BuildTime;
+
+	if (bCancelBuildRequested || bBuildOutdated)
+	{
+		// if the build was superseded by further edits they'll trigger another build shortly
+		++Stats.NumCanceledBuilds;
+		if (!bBuildOutdated)
+		{
+			// the user canceled the build, so don't pick up whatever it may have written out
+			LastScriptsAssemblyTimeStamp = IFileManager::Get().GetTimeStamp(
+				*FGameProjectBuilder::GetProjectAssemblyFilename()
+			);
+		}
+		CompleteBuildNotification(LOCTEXT("ScriptsBuildCanceled", "Compiling Scripts canceled"), false);
+		return;
+	}
+
+	if (!bBuildSucceeded)
+	{
+		++Stats.NumFailedBuilds;
+		// the next successful reload will be measured from the edit that fixes the build
+		FirstEditTime = 0;
+		CompleteBuildNotification(LOCTEXT("ScriptsBuildFailed", "Compiling Scripts failed, see the Output Log for details"), false);
+		return;
+	}
+
+	const double ReloadStartTime = FPlatformTime::Seconds();
+	const bool bReloaded = ReloadScripts();
+	const double Now = FPlatformTime::Seconds();
+	Stats.LastReloadTime = Now - ReloadStartTime;
+	Stats.TotalReloadTime += Stats.LastReloadTime;
+	++Stats.NumReloads;
+	Stats.LastEditToReloadTime = (FirstEditTime != 0) ? (Now - FirstEditTime) : 0;
+	FirstEditTime = 0;
+
+	UE_LOG(
+		LogKlawrEditorPlugin, Log, 
+		TEXT("Scripts rebuilt in %.2fs and reloaded in %.2fs (%.2fs since the first edit)."),
+		Stats.LastBuildTime, Stats.LastReloadTime, Stats.LastEditToReloadTime
+	);
+
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("BuildTime"), FText::AsNumber(Stats.LastBuildTime));
+	Args.Add(TEXT("ReloadTime"), FText::AsNumber(Stats.LastReloadTime));
+	CompleteBuildNotification(
+		bReloaded
+			? FText::Format(LOCTEXT("ScriptsReloaded", "Scripts compiled in {BuildTime}s and reloaded in {ReloadTime}s"), Args)
+			: LOCTEXT("ScriptsReloadFailed", "Failed to reload Scripts"),
+		bReloaded
+	);
+}
+
+void FScriptsReloader::ShowBuildNotification()
+{
+	// a new build replaces the notification of the previous one
+	if (BuildNotification.IsValid())
+	{
+		BuildNotification->ExpireAndFadeout();
+		BuildNotification.Reset();
+	}
+
+	FNotificationInfo Info(LOCTEXT("CompilingScripts", "Compiling Scripts..."));
+	Info.bFireAndForget = false;
+	Info.ExpireDuration = 3.0f;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		LOCTEXT("CancelBuild", "Cancel"),
+		LOCTEXT("CancelBuildTooltip", "Cancel the build, the scripts won't be reloaded."),
+		FSimpleDelegate::CreateRaw(this, &FScriptsReloader::CancelBuild),
+		SNotificationItem::CS_Pending
+	));
+	BuildNotification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (BuildNotification.IsValid())
+	{
+		BuildNotification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+}
+
+void FScriptsReloader::CompleteBuildNotification(const FText& Text, bool bSucceeded)
+{
+	if (BuildNotification.IsValid())
+	{
+		BuildNotification->SetText(Text);
+		BuildNotification->SetCompletionState(
+			bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail
+		);
+		BuildNotification->ExpireAndFadeout();
+		BuildNotification.Reset();
 	}
 }
 
@@ -324,3 +510,5 @@ TStatId FScriptsReloader::GetStatId() const
 }
 
 } // namespace Klawr
+
+#undef LOCTEXT_NAMESPACE
@@ -23,16 +23,44 @@
 //-------------------------------------------------------------------------------
 #pragma once
 
+#include "Async.h"
+
 struct FFileChangeData;
+class SNotificationItem;
 
 namespace Klawr {
 
+/** Timings of the builds and reloads done by FScriptsReloader, all times are in seconds. */
+struct FScriptsReloadStats
+{
+	int32 NumBuilds;
+	int32 NumFailedBuilds;
+	/** Builds that were canceled, or superseded by edits made while they were in progress. */
+	int32 NumCanceledBuilds;
+	int32 NumReloads;
+	double LastBuildTime;
+	double TotalBuildTime;
+	/** Time spent swapping the app domain on the game thread. */
+	double LastReloadTime;
+	double TotalReloadTime;
+	/** Time from the first edit of a batch of edits to the reload that picked them up. */
+	double LastEditToReloadTime;
+
+	FScriptsReloadStats()
+	{
+		FMemory::Memzero(*this);
+	}
+};
+
 /**
  * @brief Automatically rebuilds and/or reloads the game scripts assembly.
  * This class will automatically rebuild the game scripts whenever the user modifies or adds 
  * source files in the script source directories, the rebuilt assembly is then reloaded.
  * The game scripts assembly will also be automatically reloaded if the user explicitly rebuilds
  * it in Visual Studio.
+ * Builds run on a background thread, only the reload of the rebuilt assembly is done on the game
+ * thread. If the user makes further edits while a build is in progress the build is canceled 
+ * and its result is discarded, the edits are picked up by the next build.
  */
 class FScriptsReloader : public FTickableEditorObject
 {
@@ -53,6 +81,10 @@ public:
 	 * @return false if the reload failed (but only if it was actually attempted), true otherwise
 	 */
 	bool ReloadScripts();
+	/** Cancel the build in progress (if any), the assembly it was building won't be reloaded. */
+	void CancelBuild();
+	/** Get the timings of the builds and reloads done so far. */
+	const FScriptsReloadStats& GetStats() const { return Stats; }
 
 public: // FTickableEditorObject interface
 	virtual void Tick(float DeltaTime) override;
@@ -65,6 +97,9 @@ private:
 		, TimeSinceLastRefresh(0)
 		, TimeOfLastModification(0)
 		, bIsPIEActive(false)
+		, bBuildOutdated(false)
+		, BuildStartTime(0)
+		, FirstEditTime(0)
 	{
 	}
 
@@ -78,6 +113,15 @@ private:
 	void OnBeginPIE(const bool bIsSimulating);
 	/** Called when UnrealEd exits Play In Editor mode. */
 	void OnEndPIE(const bool bIsSimulating);
+	/** Called whenever a script file is added or modified. */
+	void OnScriptFilesChanged();
+
+	/** Launch a build of the game scripts on a background thread. */
+	void StartBuild();
+	/** Called on the game thread once the background build is done. */
+	void FinishBuild(bool bBuildSucceeded);
+	void ShowBuildNotification();
+	void CompleteBuildNotification(const FText& Text, bool bSucceeded);
 
 
 private:
@@ -103,6 +147,19 @@ private:
 	FDelegateHandle OnBeginPIEDelegate;
 	FDelegateHandle OnEndPIEDelegate;
 
+	// result of the build in progress, invalid if there's no build in progress
+	TFuture<bool> PendingBuild;
+	// set to abandon the build in progress
+	FThreadSafeBool bCancelBuildRequested;
+	// true if script files were modified after the build in progress was started
+	bool bBuildOutdated;
+	// FPlatformTime::Seconds() at the start of the build in progress
+	double BuildStartTime;
+	// FPlatformTime::Seconds() at the first edit that hasn't been reloaded yet, or zero
+	double FirstEditTime;
+	TSharedPtr<SNotificationItem> BuildNotification;
+	FScriptsReloadStats Stats;
+
 	static FScriptsReloader* Singleton;
 };
 
@@ -161,17 +161,19 @@ namespace Klawr {
         if(!scriptFilename.IsEmpty()) {
             // update the game scripts .csproj
             if(FGameProjectBuilder::AddSourceFileToProject(scriptFilename)) {
+                // the background build (if any) doesn't include the new file, and this build
+                // would have to wait for it to finish
+                FScriptsReloader::Get().CancelBuild();
                 // build the game scripts .csproj
                 if(FGameProjectBuilder::BuildProject(GWarn)) {
                     if(FScriptsReloader::Get().ReloadScripts()) {
                         ScriptTypeTreeWidget->Reload();
-                        // TODO: select newly created type
-                        //ScriptTypeTreeWidget->SelectType(
-                        //	FString::Printf(TEXT("%s.%s"), 
-                        //		*FGameProjectBuilder::GetProjectRootNamespace(),
-                        //		*FPaths::GetBaseFilename(scriptFilename)
-                        //	)
-                        //);
+                        ScriptTypeTreeWidget->SelectType(
+                            FString::Printf(TEXT("%s.%s"),
+                                *FGameProjectBuilder::GetProjectRootNamespace(),
+                                *FPaths::GetBaseFilename(scriptFilename)
+                            )
+                        );
                     }
                 }
             }
@@ -22,10 +22,14 @@
 // SOFTWARE.
 //-------------------------------------------------------------------------------
 
+
 #include "KlawrEditorPluginPrivatePCH.h"
 #include "SScriptTypeTree.h"
+#include "SSearchBox.h"
 #include "IKlawrRuntimePlugin.h"
 
+#define LOCTEXT_NAMESPACE "KlawrEditorPlugin.SScriptTypeTree"
+
 namespace Klawr {
 
 /**
@@ -48,6 +52,9 @@ public:
 	FString Name;
 	// fully qualified type name (e.g. GameScripts.MyClass) or namespace (e.g. GameScripts.Weapons)
 	FString FullName;
+	// lowercase versions of Name and FullName, used when filtering types
+	FString SearchName;
+	FString SearchFullName;
 
 	FScriptTypeTreeItem(const FString& InName, const FScriptTypeTreeItemWeakPtr& InParent)
 		: Name(InName)
@@ -62,6 +69,8 @@ public:
 		{
 			FullName = Name;
 		}
+		SearchName = Name.ToLower();
+		SearchFullName = FullName.ToLower();
 	}
 
 	bool IsType() const
@@ -70,61 +79,88 @@ public:
 	}
 };
 
-void SScriptTypeTree::Construct(const FArguments& InArgs)
+/**
+ * The tree items for all the script types in the primary app domain.
+ *
+ * Building the tree for thousands of types isn't free, so the index is only rebuilt when the 
+ * runtime plugin reports that the script types have changed (e.g. after the game scripts
+ * assembly was reloaded), until then every SScriptTypeTree shares the same index.
+ */
+class FScriptTypeIndex
 {
-	OnScriptTypeSelected = InArgs._OnScriptTypeSelected;
+public:
+	/** Namespaces that are the top-level items in the tree. */
+	TArray<FScriptTypeTreeItemPtr> RootNamespaces;
+	/** All the types in the tree, sorted by their fully qualified names. */
+	TArray<FScriptTypeTreeItemPtr> Types;
+	TMap<FString, FScriptTypeTreeItemPtr> TypesByName;
 
-	ChildSlot
-	[
-		SAssignNew(TreeView, STreeView<FScriptTypeTreeItemPtr>)
-		.SelectionMode(ESelectionMode::Single)
-		.TreeItemsSource(&RootNamespaces)
-		// get child items for any given parent item
-		.OnGetChildren(this, &SScriptTypeTree::TreeView_OnGetChildren)
-		// generate a widget for each item
-		.OnGenerateRow(this, &SScriptTypeTree::TreeView_OnGenerateRow)
-		.OnSelectionChanged(this, &SScriptTypeTree::TreeView_OnSelectionChanged)
-	];
+	/** Get an index that's up to date with the script types in the primary app domain. */
+	static TSharedRef<FScriptTypeIndex> Get()
+	{
+		static TSharedPtr<FScriptTypeIndex> CurrentIndex;
 
-	Populate();
-}
+		IKlawrRuntimePlugin& runtimePlugin = IKlawrRuntimePlugin::Get();
+		const uint32 typesVersion = runtimePlugin.GetScriptComponentTypesVersion();
+		if (!CurrentIndex.IsValid() || (CurrentIndex->Version != typesVersion))
+		{
+			// widgets still displaying the old index keep it alive until they're reloaded
+			CurrentIndex = MakeShareable(new FScriptTypeIndex(typesVersion));
+			CurrentIndex->Populate(runtimePlugin.GetScriptComponentTypes());
+		}
+		return CurrentIndex.ToSharedRef();
+	}
+
+private:
+	explicit FScriptTypeIndex(uint32 InVersion)
+		: Version(InVersion)
+	{
+	}
+
+	void Populate(const TArray<FString>& typeNames);
+	FScriptTypeTreeItemPtr FindOrAddNamespaceItem(const FString& typeNamespace);
+	void MergeNamespaceItems(TArray<FScriptTypeTreeItemPtr>& namespaceItems);
+
+private:
+	/** Value of IKlawrRuntimePlugin::GetScriptComponentTypesVersion() the index was built for. */
+	uint32 Version;
+	TMap<FString, FScriptTypeTreeItemPtr> NamespacesByName;
+};
 
 /** 
  * Find the tree item matching the given namespace, or add the components of the given namespace 
  * to the tree and return the tree item matching the last component of the namespace. Each component
  * of the namespace is represent by a single tree item.
  */
-FScriptTypeTreeItemPtr SScriptTypeTree::FindOrAddNamespaceItem(const FString& typeNamespace)
+FScriptTypeTreeItemPtr FScriptTypeIndex::FindOrAddNamespaceItem(const FString& typeNamespace)
 {
-	TArray<FString> namespaceComponents;
-	typeNamespace.ParseIntoArray(namespaceComponents, TEXT("."), true);
-	FScriptTypeTreeItemPtr namespaceItem;
-	FScriptTypeTreeItemWeakPtr namespaceParent;
-	auto* namespaceItems = &RootNamespaces;
+	const FScriptTypeTreeItemPtr* existingItem = NamespacesByName.Find(typeNamespace);
+	if (existingItem)
+	{
+		return *existingItem;
+	}
 
-	for (const FString& namespaceComponent : namespaceComponents)
+	FScriptTypeTreeItemPtr parentItem;
+	FString namespaceComponent = typeNamespace;
+	int32 lastDotIndex;
+	if (typeNamespace.FindLastChar(TEXT('.'), lastDotIndex))
 	{
-		auto predicate = [namespaceComponent](const FScriptTypeTreeItemPtr& item)
-		{
-			return item->Name == namespaceComponent;
-		};
+		parentItem = FindOrAddNamespaceItem(typeNamespace.Left(lastDotIndex));
+		namespaceComponent = typeNamespace.Mid(lastDotIndex + 1);
+	}
 
-		const FScriptTypeTreeItemPtr* item = namespaceItems->FindByPredicate(predicate);
-		if (item)
-		{
-			namespaceItem = *item;
-			namespaceItems = &(namespaceItem->Namespaces);
-		}
-		else
-		{
-			namespaceItem = MakeShareable(
-				new FScriptTypeTreeItem(namespaceComponent, namespaceParent)
-			);
-			namespaceItems->Add(namespaceItem);
-			namespaceItems = &namespaceItem->Namespaces;
-		}
-		namespaceParent = namespaceItem;
+	FScriptTypeTreeItemPtr namespaceItem = MakeShareable(
+		new FScriptTypeTreeItem(namespaceComponent, parentItem)
+	);
+	if (parentItem.IsValid())
+	{
+		parentItem->Namespaces.Add(namespaceItem);
+	}
+	else
+	{
+		RootNamespaces.Add(namespaceItem);
 	}
+	NamespacesByName.Add(typeNamespace, namespaceItem);
 	return namespaceItem;
 }
 
@@ -132,7 +168,7 @@ FScriptTypeTreeItemPtr SScriptTypeTree::FindOrAddNamespaceItem(const FString& ty
  * Recursively merge namespace components with their parent if they have no types and only a single
  * child component.
  */
-void SScriptTypeTree::MergeNamespaceItems(TArray<FScriptTypeTreeItemPtr>& namespaceItems)
+void FScriptTypeIndex::MergeNamespaceItems(TArray<FScriptTypeTreeItemPtr>& namespaceItems)
 {
 	for (int32 i = 0; i < namespaceItems.Num(); ++i)
 	{
@@ -151,10 +187,9 @@ void SScriptTypeTree::MergeNamespaceItems(TArray<FScriptTypeTreeItemPtr>& namesp
 	}
 }
 
-void SScriptTypeTree::Populate()
+void FScriptTypeIndex::Populate(const TArray<FString>& typeNames)
 {
-	TArray<FString> typeNames;
-	IKlawrRuntimePlugin::Get().GetScriptComponentTypes(typeNames);
+	Types.Reserve(typeNames.Num());
 
 	FScriptTypeTreeItemPtr namespaceItem;
 	for (const auto& fullTypeName : typeNames)
@@ -173,28 +208,192 @@ void SScriptTypeTree::Populate()
 			typeName = fullTypeName;
 		}
 
-		if (!namespaceItem.IsValid() || (namespaceItem->FullName != typeNamespace))
+		FScriptTypeTreeItemPtr typeItem;
+		if (typeNamespace.IsEmpty())
 		{
-			namespaceItem = FindOrAddNamespaceItem(typeNamespace);
+			// types in the global namespace are top-level items
+			typeItem = MakeShareable(new FScriptTypeTreeItem(typeName, FScriptTypeTreeItemWeakPtr()));
+			RootNamespaces.Add(typeItem);
 		}
-		
-		if (ensure(namespaceItem.IsValid()))
+		else
 		{
-			namespaceItem->Types.Add(
-				MakeShareable(new FScriptTypeTreeItem(typeName, namespaceItem))
-			);
+			// the type names are sorted, so consecutive types usually share a namespace
+			if (!namespaceItem.IsValid() || (namespaceItem->FullName != typeNamespace))
+			{
+				namespaceItem = FindOrAddNamespaceItem(typeNamespace);
+			}
+			typeItem = MakeShareable(new FScriptTypeTreeItem(typeName, namespaceItem));
+			namespaceItem->Types.Add(typeItem);
 		}
+		Types.Add(typeItem);
+		TypesByName.Add(typeItem->FullName, typeItem);
 	}
 
 	MergeNamespaceItems(RootNamespaces);
+	NamespacesByName.Empty();
+}
 
-	TreeView->RequestTreeRefresh();
+namespace {
+
+/** Check if all the characters of the pattern appear in the given string, in the same order. */
+bool IsSubsequence(const FString& pattern, const FString& str)
+{
+	const TCHAR* strChar = *str;
+	for (const TCHAR* patternChar = *pattern; *patternChar; ++patternChar)
+	{
+		while (*strChar && (*strChar != *patternChar))
+		{
+			++strChar;
+		}
+		if (!*strChar)
+		{
+			return false;
+		}
+		++strChar;
+	}
+	return true;
+}
+
+/** 
+ * Rank how well a type matches a (lowercase) filter string, lower is better.
+ * @return The rank of the match, or INDEX_NONE if the type doesn't match the filter.
+ */
+int32 GetMatchRank(const FScriptTypeTreeItem& typeItem, const FString& filterString)
+{
+	if (typeItem.SearchName.StartsWith(filterString, ESearchCase::CaseSensitive))
+	{
+		return 0;
+	}
+	if (typeItem.SearchFullName.Contains(filterString, ESearchCase::CaseSensitive))
+	{
+		return 1;
+	}
+	// fuzzy match, e.g. "plrctl" matches "PlayerController"
+	if (IsSubsequence(filterString, typeItem.SearchFullName))
+	{
+		return 2;
+	}
+	return INDEX_NONE;
+}
+
+} // unnamed namespace
+
+void SScriptTypeTree::Construct(const FArguments& InArgs)
+{
+	OnScriptTypeSelected = InArgs._OnScriptTypeSelected;
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SAssignNew(SearchBox, SSearchBox)
+			.HintText(LOCTEXT("SearchHint", "Search Script Types"))
+			.OnTextChanged(this, &SScriptTypeTree::SearchBox_OnTextChanged)
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			// the tree view only generates widgets for the rows that are scrolled into view,
+			// so the number of types doesn't affect how long it takes to display
+			SAssignNew(TreeView, STreeView<FScriptTypeTreeItemPtr>)
+			.SelectionMode(ESelectionMode::Single)
+			.TreeItemsSource(&VisibleItems)
+			// get child items for any given parent item
+			.OnGetChildren(this, &SScriptTypeTree::TreeView_OnGetChildren)
+			// generate a widget for each item
+			.OnGenerateRow(this, &SScriptTypeTree::TreeView_OnGenerateRow)
+			.OnSelectionChanged(this, &SScriptTypeTree::TreeView_OnSelectionChanged)
+		]
+	];
+
+	Reload();
 }
 
 void SScriptTypeTree::Reload()
 {
-	RootNamespaces.Reset();
-	Populate();
+	Index = FScriptTypeIndex::Get();
+	// the previous matches belong to the old index
+	FilterString.Empty();
+	ApplyFilter();
+}
+
+void SScriptTypeTree::SelectType(const FString& FullTypeName)
+{
+	const FScriptTypeTreeItemPtr* typeItem = Index->TypesByName.Find(FullTypeName);
+	if (!typeItem)
+	{
+		return;
+	}
+
+	// the type may not be visible in the filtered list
+	if (!FilterText.IsEmpty())
+	{
+		SearchBox->SetText(FText::GetEmpty());
+		FilterText = FText::GetEmpty();
+		ApplyFilter();
+	}
+
+	for (auto parentItem = (*typeItem)->Parent.Pin(); parentItem.IsValid(); parentItem = parentItem->Parent.Pin())
+	{
+		TreeView->SetItemExpansion(parentItem, true);
+	}
+	TreeView->SetSelection(*typeItem);
+	TreeView->RequestScrollIntoView(*typeItem);
+}
+
+void SScriptTypeTree::SearchBox_OnTextChanged(const FText& InFilterText)
+{
+	FilterText = InFilterText;
+	ApplyFilter();
+}
+
+void SScriptTypeTree::ApplyFilter()
+{
+	const FString newFilterString = FilterText.ToString().TrimTrailing().ToLower();
+	if (newFilterString.IsEmpty())
+	{
+		FilteredTypes.Reset();
+		VisibleItems = Index->RootNamespaces;
+	}
+	else
+	{
+		// every type that matches the new filter also matched the previous one if the user just
+		// typed some more characters, so only the previous matches need to be checked again
+		const bool bRefine = !FilterString.IsEmpty() && newFilterString.StartsWith(FilterString, ESearchCase::CaseSensitive);
+		const TArray<FScriptTypeTreeItemPtr>& candidates = bRefine ? FilteredTypes : Index->Types;
+
+		TArray<TPair<int32, FScriptTypeTreeItemPtr>> matches;
+		for (const auto& typeItem : candidates)
+		{
+			const int32 rank = GetMatchRank(*typeItem, newFilterString);
+			if (rank != INDEX_NONE)
+			{
+				matches.Emplace(rank, typeItem);
+			}
+		}
+		matches.Sort([](const TPair<int32, FScriptTypeTreeItemPtr>& a, const TPair<int32, FScriptTypeTreeItemPtr>& b)
+		{
+			return (a.Key != b.Key) ? (a.Key < b.Key) : (a.Value->FullName < b.Value->FullName);
+		});
+
+		FilteredTypes.Reset(matches.Num());
+		for (const auto& match : matches)
+		{
+			FilteredTypes.Add(match.Value);
+		}
+		VisibleItems = FilteredTypes;
+	}
+	FilterString = newFilterString;
+
+	TreeView->RequestTreeRefresh();
+}
+
+FText SScriptTypeTree::GetItemText(FScriptTypeTreeItemPtr Item) const
+{
+	// the namespace isn't visible when the types are displayed as a list
+	return FilterString.IsEmpty() ? Item->Title : FText::FromString(Item->FullName);
 }
 
 TSharedRef<ITableRow> SScriptTypeTree::TreeView_OnGenerateRow(
@@ -205,7 +404,8 @@ TSharedRef<ITableRow> SScriptTypeTree::TreeView_OnGenerateRow(
 		SNew(STableRow<FScriptTypeTreeItemPtr>, OwnerTable)
 		[
 			SNew(STextBlock)
-			.Text(Item->Title)
+			.Text(this, &SScriptTypeTree::GetItemText, Item)
+			.HighlightText(this, &SScriptTypeTree::GetFilterText)
 		];
 }
 
@@ -231,3 +431,5 @@ void SScriptTypeTree::TreeView_OnSelectionChanged(
 }
 
 } // namespace Klawr
+
+#undef LOCTEXT_NAMESPACE
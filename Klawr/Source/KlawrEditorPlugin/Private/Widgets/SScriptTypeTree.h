@@ -32,7 +32,8 @@ typedef TWeakPtr<class FScriptTypeTreeItem> FScriptTypeTreeItemWeakPtr;
  * @brief A widget that displays a tree of relevant types defined in the game scripts assembly or 
  *        any other assemblies loaded into the primary app domain.
  * 
- * Currently the relevant types consist of those derived from UKlawrScriptComponent.
+ * Currently the relevant types consist of those derived from UKlawrScriptComponent. The types 
+ * can be filtered by typing part of a name into the search box above the tree.
  */
 class SScriptTypeTree : public SCompoundWidget
 {
@@ -47,13 +48,18 @@ public:
 
 public:
 	void Construct(const FArguments& InArgs);
-	/** Rebuild the tree from scratch. */
+	/** Rebuild the tree, this only queries the primary app domain if the script types changed. */
 	void Reload();
+	/** Select the given type in the tree, and scroll it into view. */
+	void SelectType(const FString& FullTypeName);
 
 private:
-	FScriptTypeTreeItemPtr FindOrAddNamespaceItem(const FString& typeNamespace);
-	void MergeNamespaceItems(TArray<FScriptTypeTreeItemPtr>& namespaceItems);
-	void Populate();
+	/** Called by SearchBox whenever the user edits the filter. */
+	void SearchBox_OnTextChanged(const FText& InFilterText);
+	/** Update the items displayed by TreeView to match the current filter. */
+	void ApplyFilter();
+	FText GetItemText(FScriptTypeTreeItemPtr Item) const;
+	FText GetFilterText() const { return FilterText; }
 
 	/** Called by TreeView to generate a table row for the given item. */
 	TSharedRef<ITableRow> TreeView_OnGenerateRow(
@@ -69,10 +75,23 @@ private:
 	void TreeView_OnSelectionChanged(FScriptTypeTreeItemPtr Item, ESelectInfo::Type SelectInfo);
 
 private:
+	TSharedPtr<class SSearchBox> SearchBox;
 	TSharedPtr<STreeView<FScriptTypeTreeItemPtr>> TreeView;
 
-	/** Namespaces that are the top-level items in the tree. */
-	TArray<FScriptTypeTreeItemPtr> RootNamespaces;
+	/** Tree items built from the script types, shared by all SScriptTypeTree instances. */
+	TSharedPtr<class FScriptTypeIndex> Index;
+
+	/** 
+	 * Items displayed by TreeView, either the top-level namespaces from the index, or the types 
+	 * that match the filter (in which case the tree is flattened into a list).
+	 */
+	TArray<FScriptTypeTreeItemPtr> VisibleItems;
+
+	/** Types that matched the filter, best matches first. */
+	TArray<FScriptTypeTreeItemPtr> FilteredTypes;
+	FText FilterText;
+	/** Lowercase version of FilterText the types were last matched against. */
+	FString FilterString;
 
 	FOnScriptTypeSelected OnScriptTypeSelected;
 };
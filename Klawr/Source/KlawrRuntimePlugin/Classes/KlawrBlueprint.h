@@ -39,7 +39,7 @@ public:
 	 * Name of a type defined in a script or assembly.
 	 * For C# types this should be a fully qualified class name, e.g. MyProject.MyClass
 	 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Script)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AssetRegistrySearchable, Category=Script)
 	FString ScriptDefinedType;
 
 public:
@@ -0,0 +1,128 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#pragma once
+
+#include "KlawrClrHost.h"
+#include "KlawrEventTrampoline.generated.h"
+
+class UKlawrEventTrampoline;
+
+/**
+ * The object a dynamic multicast delegate bound in managed code is actually bound to.
+ *
+ * A dynamic delegate can only be bound to a named UFunction of a UObject, and a delegate only 
+ * accepts each object/function pair once, so every binding gets one of these small objects and 
+ * all of them are bound via the same function. ProcessEvent() forwards each call to the 
+ * trampoline of the app domain the binding was made in.
+ */
+UCLASS(Transient)
+class UKlawrEventBinding : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UKlawrEventBinding(const FObjectInitializer& ObjectInitializer);
+
+	/** 
+	 * The function every delegate is bound to, the delegate passes its own parameters so 
+	 * ProcessEvent() intercepts the call before it can get here.
+	 */
+	UFUNCTION()
+	void HandleEvent();
+
+public: // UObject interface
+	virtual void ProcessEvent(UFunction* Function, void* Parms) override;
+
+private:
+	friend class UKlawrEventTrampoline;
+
+	/** Cleared when the binding is removed. */
+	UKlawrEventTrampoline* Trampoline;
+	int32 BindingID;
+};
+
+/**
+ * Forwards the dynamic multicast delegates (events) bound in managed code to the managed event 
+ * dispatcher of an engine app domain.
+ *
+ * There's a single trampoline per app domain, it owns a UKlawrEventBinding for every binding made
+ * in that app domain. ProcessBinding() converts the delegate parameters into VariantArg(s) with 
+ * a list of parameter properties that was worked out when the binding was created.
+ */
+UCLASS(Transient)
+class UKlawrEventTrampoline : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UKlawrEventTrampoline(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 * Bind a dynamic multicast delegate property of the given object to the managed dispatcher
+	 * of the given app domain (the app domain requesting the binding).
+	 * @return ID of the new binding, or zero if the delegate couldn't be bound.
+	 */
+	static int32 BindEvent(
+		int InAppDomainID, UObject* SourceObject, const TCHAR* DelegateName, 
+		Klawr::EventUtilsProxy::DispatchEventAction Dispatch
+	);
+	static void UnbindEvent(int32 BindingID);
+	/** Remove all the bindings created in the given app domain, must be called before it's unloaded. */
+	static void DestroyAppDomainTrampoline(int AppDomainID);
+
+public: // UObject interface
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+private:
+	struct FEventParam
+	{
+		const UProperty* Property;
+		Klawr::VariantArgType::VariantArgType_t Type;
+	};
+
+	struct FEventBinding
+	{
+		TWeakObjectPtr<UObject> SourceObject;
+		const UMulticastDelegateProperty* DelegateProperty;
+		/** The object the delegate is bound to. */
+		UKlawrEventBinding* Object;
+		TArray<FEventParam> Params;
+	};
+
+	/** Work out how the parameters of a delegate signature are passed to managed code. */
+	static bool GetEventParams(const UFunction* Signature, TArray<FEventParam>& OutParams);
+	void RemoveBinding(int32 BindingID);
+	/** Pass the parameters of a delegate call on to the managed handlers of a binding. */
+	void ProcessBinding(int32 BindingID, void* Parms);
+
+	friend class UKlawrEventBinding;
+
+	int AppDomainID;
+	Klawr::EventUtilsProxy::DispatchEventAction Dispatch;
+	TMap<int32, FEventBinding> Bindings;
+
+	/** The trampolines of all the app domains, indexed by app domain ID. */
+	static TMap<int, UKlawrEventTrampoline*> Trampolines;
+	static int32 LastBindingID;
+};
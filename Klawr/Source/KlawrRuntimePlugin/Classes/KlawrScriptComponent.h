@@ -51,6 +51,9 @@ namespace Klawr
 			ZeroMemory(PreviousManaged, 8);
 		}
 	};
+
+	/** Return type of a C# function called by one of the UKlawrScriptComponent::InvokeCSFunction*() thunks. */
+	enum class ECSFunctionResultType { Float, Int, Bool, String, Object, Void };
 } // namespace Klawr
 
 /**
@@ -98,10 +101,108 @@ public: // UActorComponent interface
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "Klawr")
 	virtual void CallCSFunctionVoid(FString functionName, UKlawrArgArray* args);
 
+	/** Max number of arguments that can be passed to the InvokeCSFunction*() thunks. */
+	static const int32 MaxCSFunctionArgs = 8;
+
+	/** 
+	 * Record the type of an argument passed to one of the InvokeCSFunction*() thunks in argTypes.
+	 * @param ArgType One of the Klawr::VariantArgType values.
+	 */
+	static int32 PackCSFunctionArgType(int32 ArgTypes, int32 ArgIndex, int32 ArgType)
+	{
+		return ArgTypes | ((ArgType + 1) << (ArgIndex * 4));
+	}
+
+	/*
+	 * Call a C# function of this component, these are used by UBPNode_KlawrFunctionCall instead of
+	 * the CallCSFunction*() functions above. The thunks read the arguments straight off the 
+	 * blueprint VM stack into a native frame on the C++ stack, so no UKlawrArgArray needs to be 
+	 * created and filled in by a separate blueprint function call for each argument.
+	 * argTypes describes the arguments that are actually used (see PackCSFunctionArgType()), the
+	 * arguments are wildcards that take on the type of whatever is connected to them.
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	float InvokeCSFunctionFloat(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionFloat)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::Float);
+	}
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	int32 InvokeCSFunctionInt(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionInt)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::Int);
+	}
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	bool InvokeCSFunctionBool(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionBool)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::Bool);
+	}
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	FString InvokeCSFunctionString(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionString)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::String);
+	}
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	UObject* InvokeCSFunctionObject(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionObject)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::Object);
+	}
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "Klawr", meta = (BlueprintInternalUseOnly = "true", CustomStructureParam = "arg0,arg1,arg2,arg3,arg4,arg5,arg6,arg7"))
+	void InvokeCSFunctionVoid(
+		FString functionName, int32 argTypes, const int32& arg0, const int32& arg1, const int32& arg2, 
+		const int32& arg3, const int32& arg4, const int32& arg5, const int32& arg6, const int32& arg7
+	);
+	DECLARE_FUNCTION(execInvokeCSFunctionVoid)
+	{
+		P_THIS->InvokeCSFunction(Stack, RESULT_PARAM, Klawr::ECSFunctionResultType::Void);
+	}
+
+#if WITH_EDITOR
+	/**
+	 * Destroy the managed instances of all script components that live in the given app domain,
+	 * this must be called before the app domain is unloaded.
+	 * @param bSaveState If true the fields of each managed instance will be saved first and 
+	 *                   restored into the instance that replaces it in ResumeScriptComponents().
+	 */
+	static void SuspendScriptComponents(int AppDomainID, bool bSaveState);
+
+	/**
+	 * Recreate the managed instances of the script components suspended by 
+	 * SuspendScriptComponents() in the app domain each component now belongs to.
+	 */
+	static void ResumeScriptComponents();
+#endif // WITH_EDITOR
+
 
 private:
+	/** Read the arguments of an InvokeCSFunction*() call from the stack and call the C# function. */
+	void InvokeCSFunction(FFrame& Stack, void* Result, Klawr::ECSFunctionResultType ResultType);
+
 	void CreateScriptComponentProxy();
 	void DestroyScriptComponentProxy();
+#if WITH_EDITOR
+	/** Restore the state saved for this component by SuspendScriptComponents() (if any). */
+	void RestoreSuspendedScriptState();
+#endif // WITH_EDITOR
 
 	void UpdatePropertyTracker(Klawr::PropertyTracker& tracker);
 
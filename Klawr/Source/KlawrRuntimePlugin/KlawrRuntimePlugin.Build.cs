@@ -7,6 +7,10 @@ namespace UnrealBuildTool.Rules
 	{
 		public KlawrRuntimePlugin(TargetInfo Target)
 		{
+			// the generated native wrappers are split between several KlawrNativeGlueShard*.cpp files
+			// so that they can be compiled in parallel, a unity build would merge them back together
+			bFasterWithoutUnity = true;
+
 			PublicIncludePaths.AddRange(
 				new string[] {
 					// ... add other public include paths required here ...
@@ -25,15 +25,101 @@
 #include "KlawrRuntimePluginPrivatePCH.h"
 #include "KlawrArgArray.h"
 
+DECLARE_STATS_GROUP(TEXT("Klawr"), STATGROUP_Klawr, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Arg Arrays Reused"), STAT_KlawrArgArraysReused, STATGROUP_Klawr);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Arg Arrays Created"), STAT_KlawrArgArraysCreated, STATGROUP_Klawr);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Arg Arrays"), STAT_KlawrPooledArgArrays, STATGROUP_Klawr);
+
+namespace {
+
+/** 
+ * Max number of arg arrays that will be kept in the pool, this only needs to cover the arrays 
+ * handed out during a single frame.
+ */
+const int32 MaxPooledArgArrays = 64;
+/** Number of args space is reserved for in each pooled array. */
+const int32 ReservedArgs = 8;
+
+/** Pooled arrays that can be handed out by Create(), only accessed from the game thread. */
+TArray<UKlawrArgArray*> FreeArgArrays;
+/** Pooled arrays that were handed out by Create() during the current frame. */
+TArray<UKlawrArgArray*> InUseArgArrays;
+FDelegateHandle EndFrameHandle;
+
+/** 
+ * Return all the pooled arrays handed out during the frame to the pool, the caller that created
+ * an array owns it until the end of the frame so it's free to pass the same array to any number
+ * of C# function calls (or to hold on to it) within that frame.
+ */
+void ResetArgArrays()
+{
+	for (UKlawrArgArray* ArgArray : InUseArgArrays)
+	{
+		ArgArray->Clear();
+	}
+	FreeArgArrays.Append(InUseArgArrays);
+	InUseArgArrays.Reset();
+}
+
+} // unnamed namespace
+
+UKlawrArgArray::UKlawrArgArray(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
 UKlawrArgArray* UKlawrArgArray::Create()
 {
-	return NewObject<UKlawrArgArray>();
+	check(IsInGameThread());
+
+	UKlawrArgArray* ArgArray = nullptr;
+	if (FreeArgArrays.Num() > 0)
+	{
+		INC_DWORD_STAT(STAT_KlawrArgArraysReused);
+		ArgArray = FreeArgArrays.Pop(false);
+		// should already be empty, but an array that escaped the pool could've been modified
+		ArgArray->Clear();
+		InUseArgArrays.Add(ArgArray);
+		return ArgArray;
+	}
+
+	INC_DWORD_STAT(STAT_KlawrArgArraysCreated);
+	ArgArray = NewObject<UKlawrArgArray>();
+	if ((FreeArgArrays.Num() + InUseArgArrays.Num()) < MaxPooledArgArrays)
+	{
+		// pooled arrays are never garbage collected, once the pool is full any extra arrays are
+		// left for the garbage collector to clean up as before
+		ArgArray->AddToRoot();
+		ArgArray->args.Reserve(ReservedArgs);
+		InUseArgArrays.Add(ArgArray);
+		INC_DWORD_STAT(STAT_KlawrPooledArgArrays);
+	}
+	return ArgArray;
+}
+
+void UKlawrArgArray::StartupPool()
+{
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&ResetArgArrays);
+}
+
+void UKlawrArgArray::ShutdownPool()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+	ResetArgArrays();
+	for (UKlawrArgArray* ArgArray : FreeArgArrays)
+	{
+		ArgArray->RemoveFromRoot();
+	}
+	SET_DWORD_STAT(STAT_KlawrPooledArgArrays, 0);
+	FreeArgArrays.Empty();
 }
 
 void UKlawrArgArray::Clear()
 {
-	args.Empty();
-	refStrings.Empty();
+	// keep the memory around for the next call
+	args.Reset();
+	refStrings.Reset();
 }
 
 void UKlawrArgArray::AddInt(int value)
@@ -65,8 +151,9 @@ void UKlawrArgArray::AddBool(bool value)
 
 void UKlawrArgArray::AddString(FString value)
 {
-	// Store the string in refStrings, so that the buffer doesn't get deallocated while we're using it
-	int idx = refStrings.Add(value);
+	// Store the string in refStrings, so that the buffer doesn't get deallocated while we're using it,
+	// the blueprint VM already made a copy of the string for this call so it can just be moved
+	int idx = refStrings.Add(MoveTemp(value));
 	Klawr::VariantArg arg;
 	arg.Type = Klawr::VariantArgType::String;
 	*(reinterpret_cast<const TCHAR**>(arg.Data)) = *refStrings[idx];
@@ -0,0 +1,191 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace Klawr {
+
+/**
+ * Abstract base class for TArrayHelper and TStructArrayHelper.
+ * 
+ * It's impractical to wrap every instantiation of the TArrayHelper template (not by hand
+ * anyway) so it can be passed across the native/managed code boundary, but wrapping a simple
+ * interface like FArrayHelper is easy.
+ */
+class FArrayHelper
+{
+protected:
+	// property type that corresponds to the element type of the TArray this helper acts on
+	// e.g. for TArray<FString> this will be UStrProperty
+	const UProperty* ElementProperty;
+	int32 ElementSize;
+
+protected:
+	void Construct(int32 index)
+	{
+		if (ElementProperty->HasAnyPropertyFlags(CPF_ZeroConstructor))
+		{
+			FMemory::Memzero(GetRawPtr(index), ElementSize);
+		}
+		else
+		{
+			ElementProperty->InitializeValue(GetRawPtr(index));
+		}
+	}
+
+public:
+	FArrayHelper(const UProperty* elementProperty, int32 elementSize)
+		: ElementProperty(elementProperty)
+		, ElementSize(elementSize)
+	{
+	}
+
+	virtual ~FArrayHelper()
+	{
+	}
+
+	const UProperty* GetElementProperty() const
+	{
+		return ElementProperty;
+	}
+
+	int32 GetElementSize() const
+	{
+		return ElementSize;
+	}
+
+	virtual int32 Num() const = 0;
+	virtual uint8* GetRawPtr(int32 index) = 0;
+	virtual int32 Add() = 0;
+	virtual void Insert(int32 index) = 0;
+	virtual void Remove(int32 index) = 0;
+	virtual int32 Find(const void* item) const = 0;
+	virtual void Reset(int32 newCapacity) = 0;
+};
+
+/**
+ * Implements everything but FArrayHelper::Find() for a TArray of a specific type.
+ */
+template <typename T>
+class TArrayHelperBase : public FArrayHelper
+{
+private:
+	typedef FArrayHelper Super;
+
+protected:
+	TArray<T>* Array;
+
+public:
+	TArrayHelperBase(TArray<T>* array, const UArrayProperty* arrayProperty)
+		: FArrayHelper(arrayProperty->Inner, arrayProperty->Inner->ElementSize)
+		, Array(array)
+	{
+	}
+
+	virtual ~TArrayHelperBase()
+	{
+	}
+
+	int32 Num() const override
+	{
+		return Array->Num();
+	}
+
+	uint8* GetRawPtr(int32 index) override
+	{
+		return reinterpret_cast<uint8*>(&((*Array)[index]));
+	}
+
+	int32 Add() override
+	{
+		const int32 index = Array->AddUninitialized();
+		Super::Construct(index);
+		return index;
+	}
+
+	void Insert(int32 index) override
+	{
+		Array->InsertUninitialized(index);
+		Super::Construct(index);
+	}
+
+	void Remove(int32 index) override
+	{
+		Array->RemoveAt(index);
+	}
+
+	void Reset(int32 newCapacity) override
+	{
+		Array->Reset(newCapacity);
+	}
+};
+
+/**
+ * This class manipulates TArray directly.
+ * 
+ * This template class is used by the native code generator to expose native TArray(s) to
+ * managed code, T must have an equality operator.
+ */
+template <typename T>
+class TArrayHelper : public TArrayHelperBase<T>
+{
+public:
+	TArrayHelper(TArray<T>* array, const UArrayProperty* arrayProperty)
+		: TArrayHelperBase<T>(array, arrayProperty)
+	{
+	}
+
+	int32 Find(const void* itemPtr) const override
+	{
+		return this->Array->Find(*static_cast<const T*>(itemPtr));
+	}
+};
+
+/**
+ * This class manipulates a TArray of USTRUCTs directly.
+ *
+ * Most USTRUCTs don't have an equality operator, so elements are compared using the reflection
+ * data of the struct instead.
+ */
+template <typename T>
+class TStructArrayHelper : public TArrayHelperBase<T>
+{
+public:
+	TStructArrayHelper(TArray<T>* array, const UArrayProperty* arrayProperty)
+		: TArrayHelperBase<T>(array, arrayProperty)
+	{
+	}
+
+	int32 Find(const void* itemPtr) const override
+	{
+		for (int32 index = 0; index < this->Array->Num(); ++index)
+		{
+			if (this->ElementProperty->Identical(&((*this->Array)[index]), itemPtr))
+			{
+				return index;
+			}
+		}
+		return INDEX_NONE;
+	}
+};
+
+} // namespace Klawr
@@ -26,125 +26,11 @@
 #include "KlawrNativeUtils.h"
 #include "KlawrClrHost.h"
 #include "KlawrObjectReferencer.h"
+#include "KlawrArrayUtilsSimd.h"
+#include "KlawrArrayHelper.h"
 
 namespace Klawr 
 {
-	/**
-	 * Abstract base class for TArrayHelper.
-	 * 
-	 * It's impractical to wrap every instantiation of the TArrayHelper template (not by hand
-	 * anyway) so it can be passed across the native/managed code boundary, but wrapping a simple
-	 * interface like FArrayHelper is easy.
-	 */
-	class FArrayHelper
-	{
-	protected:
-		// property type that corresponds to the element type of the TArray this helper acts on
-		// e.g. for TArray<FString> this will be UStrProperty
-		const UProperty* ElementProperty;
-		int32 ElementSize;
-
-	protected:
-		void Construct(int32 index)
-		{
-			if (ElementProperty->HasAnyPropertyFlags(CPF_ZeroConstructor))
-			{
-				FMemory::Memzero(GetRawPtr(index), ElementSize);
-			}
-			else
-			{
-				ElementProperty->InitializeValue(GetRawPtr(index));
-			}
-		}
-
-	public:
-		FArrayHelper(const UProperty* elementProperty, int32 elementSize)
-			: ElementProperty(elementProperty)
-			, ElementSize()
-		{
-		}
-
-		virtual ~FArrayHelper()
-		{
-		}
-
-		const UProperty* GetElementProperty() const
-		{
-			return ElementProperty;
-		}
-
-		virtual int32 Num() const = 0;
-		virtual uint8* GetRawPtr(int32 index) = 0;
-		virtual int32 Add() = 0;
-		virtual void Insert(int32 index) = 0;
-		virtual void Remove(int32 index) = 0;
-		virtual int32 Find(const void* item) const = 0;
-		virtual void Reset(int32 newCapacity) = 0;
-	};
-
-	/**
-	 * This class manipulates TArray directly.
-	 * 
-	 * This template class is used by the native code generator to expose native TArray(s) to
-	 * managed code.
-	 */
-	template <typename T>
-	class TArrayHelper : public FArrayHelper
-	{
-	private:
-		typedef FArrayHelper Super;
-		TArray<T>* Array;
-
-	public:
-		TArrayHelper(TArray<T>* array, const UArrayProperty* arrayProperty)
-			: FArrayHelper(arrayProperty->Inner, arrayProperty->ElementSize)
-			, Array(array)
-		{
-		}
-
-		virtual ~TArrayHelper()
-		{
-		}
-
-		int32 Num() const override
-		{
-			return Array->Num();
-		}
-
-		uint8* GetRawPtr(int32 index) override
-		{
-			return reinterpret_cast<uint8*>(&((*Array)[index]));
-		}
-
-		int32 Add() override
-		{
-			const int32 index = Array->AddUninitialized();
-			Super::Construct(index);
-			return index;
-		}
-
-		void Insert(int32 index) override
-		{
-			Array->InsertUninitialized(index);
-			Super::Construct(index);
-		}
-
-		void Remove(int32 index) override
-		{
-			Array->RemoveAt(index);
-		}
-
-		int32 Find(const void* itemPtr) const override
-		{
-			return Array->Find(*static_cast<const T*>(itemPtr));
-		}
-
-		void Reset(int32 newCapacity) override
-		{
-			Array->Reset(newCapacity);
-		}
-	};
-
 	namespace ArrayUtils 
 	{
 		int32 Num(FArrayHelper* arrayHelper)
@@ -187,7 +73,7 @@ namespace Klawr
 
 		UObject* GetObject(FArrayHelper* arrayHelper, int32 index)
 		{
-			auto obj = reinterpret_cast<UObject*>(arrayHelper->GetRawPtr(index));
+			auto obj = *reinterpret_cast<UObject**>(arrayHelper->GetRawPtr(index));
 			if (obj)
 			{
 				// UObject* gets marshaled to UObjectHandle in managed code, 
@@ -267,10 +153,44 @@ namespace Klawr
 			return arrayHelper->Find(itemPtr);
 		}
 
+		/** 
+		 * Get a pointer to the first element of an array of primitives, or nullptr if the array 
+		 * is empty.
+		 */
+		template <typename T>
+		const T* GetPrimitiveData(FArrayHelper* arrayHelper)
+		{
+			check(arrayHelper->GetElementProperty()->ElementSize == sizeof(T));
+			if (arrayHelper->Num() > 0)
+			{
+				return reinterpret_cast<const T*>(arrayHelper->GetRawPtr(0));
+			}
+			return nullptr;
+		}
+
 		template <typename T>
 		int32 FindByValue(FArrayHelper* arrayHelper, T item)
 		{
-			return arrayHelper->Find(&item);
+			const T* data = GetPrimitiveData<T>(arrayHelper);
+			return data ? ArrayUtilsSimd::Find(data, arrayHelper->Num(), item) : INDEX_NONE;
+		}
+
+		template <typename T>
+		int32 CountByValue(FArrayHelper* arrayHelper, T item)
+		{
+			const T* data = GetPrimitiveData<T>(arrayHelper);
+			return data ? ArrayUtilsSimd::Count(data, arrayHelper->Num(), item) : 0;
+		}
+
+		template <typename T>
+		int32 FindAnyByValue(FArrayHelper* arrayHelper, const T* items, int32 numItems)
+		{
+			const T* data = GetPrimitiveData<T>(arrayHelper);
+			if (data && items && (numItems > 0))
+			{
+				return ArrayUtilsSimd::FindAny(data, arrayHelper->Num(), items, numItems);
+			}
+			return INDEX_NONE;
 		}
 		
 		int32 FindString(FArrayHelper* arrayHelper, const TCHAR* item)
@@ -308,6 +228,107 @@ namespace Klawr
 			arrayHelper->Remove(index);
 		}
 
+		int32 GetElementSize(FArrayHelper* arrayHelper)
+		{
+			return arrayHelper->GetElementSize();
+		}
+
+		/** 
+		 * Copy a range of elements from an array into a buffer, this is only supported when the 
+		 * array elements are plain old data (so they can be safely memcpy'd).
+		 * @return true if the elements were copied, false otherwise
+		 */
+		uint8 CopyToBuffer(FArrayHelper* arrayHelper, int32 index, void* buffer, int32 count)
+		{
+			if (!arrayHelper->GetElementProperty()->HasAnyPropertyFlags(CPF_IsPlainOldData))
+			{
+				return false;
+			}
+			if (count > 0)
+			{
+				check((index >= 0) && ((index + count) <= arrayHelper->Num()));
+				FMemory::Memcpy(
+					buffer, arrayHelper->GetRawPtr(index), count * arrayHelper->GetElementSize()
+				);
+			}
+			return true;
+		}
+
+		/**
+		 * Copy a range of elements from a buffer into an array, the array must already contain
+		 * the elements being overwritten.
+		 * @return true if the elements were copied, false otherwise
+		 * @see CopyToBuffer()
+		 */
+		uint8 CopyFromBuffer(FArrayHelper* arrayHelper, int32 index, const void* buffer, int32 count)
+		{
+			if (!arrayHelper->GetElementProperty()->HasAnyPropertyFlags(CPF_IsPlainOldData))
+			{
+				return false;
+			}
+			if (count > 0)
+			{
+				check((index >= 0) && ((index + count) <= arrayHelper->Num()));
+				FMemory::Memcpy(
+					arrayHelper->GetRawPtr(index), buffer, count * arrayHelper->GetElementSize()
+				);
+			}
+			return true;
+		}
+
+		/** 
+		 * Get pointers to the characters of a range of strings in an array, the pointers are only
+		 * valid until the array is modified so managed code copies the strings straight away.
+		 */
+		void GetStrings(FArrayHelper* arrayHelper, int32 index, const TCHAR** buffer, int32 count)
+		{
+			check(arrayHelper->GetElementProperty()->IsA<UStrProperty>());
+			if (count > 0)
+			{
+				check((index >= 0) && ((index + count) <= arrayHelper->Num()));
+				auto strings = reinterpret_cast<const FString*>(arrayHelper->GetRawPtr(index));
+				for (int32 i = 0; i < count; ++i)
+				{
+					buffer[i] = *strings[i];
+				}
+			}
+		}
+
+		/** Copy a range of names from an array into a buffer, @see GetName() */
+		void GetNames(FArrayHelper* arrayHelper, int32 index, FScriptName* buffer, int32 count)
+		{
+			check(arrayHelper->GetElementProperty()->IsA<UNameProperty>());
+			if (count > 0)
+			{
+				check((index >= 0) && ((index + count) <= arrayHelper->Num()));
+				auto names = reinterpret_cast<const FName*>(arrayHelper->GetRawPtr(index));
+				for (int32 i = 0; i < count; ++i)
+				{
+					buffer[i] = NameToScriptName(names[i]);
+				}
+			}
+		}
+
+		/** Copy a range of object pointers from an array into a buffer, @see GetObject() */
+		void GetObjects(FArrayHelper* arrayHelper, int32 index, UObject** buffer, int32 count)
+		{
+			check(arrayHelper->GetElementProperty()->IsA<UObjectProperty>());
+			if (count > 0)
+			{
+				check((index >= 0) && ((index + count) <= arrayHelper->Num()));
+				auto objects = reinterpret_cast<UObject* const*>(arrayHelper->GetRawPtr(index));
+				for (int32 i = 0; i < count; ++i)
+				{
+					buffer[i] = objects[i];
+					// each object is wrapped in a UObjectHandle that releases the reference
+					if (objects[i])
+					{
+						FObjectReferencer::AddObjectRef(objects[i]);
+					}
+				}
+			}
+		}
+
 		void Destroy(FArrayHelper* arrayHelper)
 		{
 			delete arrayHelper;
@@ -338,8 +359,22 @@ namespace Klawr
 		ArrayUtils::FindString,
 		ArrayUtils::FindName,
 		ArrayUtils::FindByPtr<UObject>,
+		ArrayUtils::CountByValue<uint8>,
+		ArrayUtils::CountByValue<int16>,
+		ArrayUtils::CountByValue<int32>,
+		ArrayUtils::CountByValue<int64>,
+		ArrayUtils::FindAnyByValue<uint8>,
+		ArrayUtils::FindAnyByValue<int16>,
+		ArrayUtils::FindAnyByValue<int32>,
+		ArrayUtils::FindAnyByValue<int64>,
 		ArrayUtils::Insert,
 		ArrayUtils::RemoveAt,
+		ArrayUtils::GetElementSize,
+		ArrayUtils::CopyToBuffer,
+		ArrayUtils::CopyFromBuffer,
+		ArrayUtils::GetStrings,
+		ArrayUtils::GetNames,
+		ArrayUtils::GetObjects,
 		ArrayUtils::Destroy,
 	};
 
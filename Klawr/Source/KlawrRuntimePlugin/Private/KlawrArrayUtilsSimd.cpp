@@ -0,0 +1,508 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "KlawrRuntimePluginPrivatePCH.h"
+#include "KlawrArrayUtilsSimd.h"
+
+// SSE2 is always available on x64, AVX2 support is detected at runtime. MSVC doesn't require
+// any special compiler flags to emit AVX2 instructions from intrinsics, so both code paths can
+// live in the same translation unit.
+#if PLATFORM_WINDOWS && PLATFORM_64BITS
+#define KLAWR_ARRAYUTILS_SIMD 1
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#define KLAWR_ARRAYUTILS_SIMD 0
+#endif
+
+namespace Klawr {
+namespace ArrayUtilsSimd {
+
+namespace 
+{
+	// FindAny() falls back to the scalar kernel when searching for more items than this
+	const int32 MaxVectorFindAnyItems = 16;
+
+	int32 PopCount(uint32 bits)
+	{
+		bits = bits - ((bits >> 1) & 0x55555555);
+		bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+		return (((bits + (bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+	}
+
+	EInstructionSet DetectInstructionSet()
+	{
+#if KLAWR_ARRAYUTILS_SIMD
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 0);
+		const int maxLeaf = cpuInfo[0];
+		__cpuid(cpuInfo, 1);
+		const bool bHasOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+		const bool bHasAVX = (cpuInfo[2] & (1 << 28)) != 0;
+		// the OS must also preserve the YMM registers across context switches
+		if (bHasOSXSave && bHasAVX && (maxLeaf >= 7) && ((_xgetbv(0) & 0x6) == 0x6))
+		{
+			__cpuidex(cpuInfo, 7, 0);
+			if ((cpuInfo[1] & (1 << 5)) != 0)
+			{
+				return EInstructionSet::AVX2;
+			}
+		}
+		return EInstructionSet::SSE2;
+#else
+		return EInstructionSet::Scalar;
+#endif
+	}
+
+	template <typename T>
+	int32 ScalarFind(const T* data, int32 num, T item)
+	{
+		for (int32 index = 0; index < num; ++index)
+		{
+			if (data[index] == item)
+			{
+				return index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	template <typename T>
+	int32 ScalarCount(const T* data, int32 num, T item)
+	{
+		int32 count = 0;
+		for (int32 index = 0; index < num; ++index)
+		{
+			count += (data[index] == item) ? 1 : 0;
+		}
+		return count;
+	}
+
+	template <typename T>
+	int32 ScalarFindAny(const T* data, int32 num, const T* items, int32 numItems)
+	{
+		for (int32 index = 0; index < num; ++index)
+		{
+			for (int32 itemIndex = 0; itemIndex < numItems; ++itemIndex)
+			{
+				if (data[index] == items[itemIndex])
+				{
+					return index;
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+
+#if KLAWR_ARRAYUTILS_SIMD
+	/**
+	 * SSE2 operations for each supported element type.
+	 *
+	 * EqualMask() returns a mask with one bit per byte in the vector, all the bits corresponding
+	 * to a matching element are set, so for T that's larger than a byte the index of a matching
+	 * element is obtained by dividing the bit index by sizeof(T).
+	 */
+	template <typename T>
+	struct TSse2Ops;
+
+	template <>
+	struct TSse2Ops<uint8>
+	{
+		typedef __m128i VectorType;
+		static VectorType Load(const uint8* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+		static VectorType Splat(uint8 item) { return _mm_set1_epi8(static_cast<char>(item)); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+	};
+
+	template <>
+	struct TSse2Ops<int16>
+	{
+		typedef __m128i VectorType;
+		static VectorType Load(const int16* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+		static VectorType Splat(int16 item) { return _mm_set1_epi16(item); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return _mm_movemask_epi8(_mm_cmpeq_epi16(a, b)); }
+	};
+
+	template <>
+	struct TSse2Ops<int32>
+	{
+		typedef __m128i VectorType;
+		static VectorType Load(const int32* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+		static VectorType Splat(int32 item) { return _mm_set1_epi32(item); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)); }
+	};
+
+	template <>
+	struct TSse2Ops<int64>
+	{
+		typedef __m128i VectorType;
+		static VectorType Load(const int64* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+		static VectorType Splat(int64 item) { return _mm_set1_epi64x(item); }
+		static uint32 EqualMask(VectorType a, VectorType b)
+		{
+			// SSE2 has no 64-bit compare, so compare the 32-bit halves and then only keep the 
+			// lanes where both halves match
+			const __m128i halves = _mm_cmpeq_epi32(a, b);
+			const __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+			return _mm_movemask_epi8(_mm_and_si128(halves, swapped));
+		}
+	};
+
+	/** AVX2 operations for each supported element type, see TSse2Ops. */
+	template <typename T>
+	struct TAvx2Ops;
+
+	template <>
+	struct TAvx2Ops<uint8>
+	{
+		typedef __m256i VectorType;
+		static VectorType Load(const uint8* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+		static VectorType Splat(uint8 item) { return _mm256_set1_epi8(static_cast<char>(item)); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+	};
+
+	template <>
+	struct TAvx2Ops<int16>
+	{
+		typedef __m256i VectorType;
+		static VectorType Load(const int16* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+		static VectorType Splat(int16 item) { return _mm256_set1_epi16(item); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b))); }
+	};
+
+	template <>
+	struct TAvx2Ops<int32>
+	{
+		typedef __m256i VectorType;
+		static VectorType Load(const int32* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+		static VectorType Splat(int32 item) { return _mm256_set1_epi32(item); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b))); }
+	};
+
+	template <>
+	struct TAvx2Ops<int64>
+	{
+		typedef __m256i VectorType;
+		static VectorType Load(const int64* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+		static VectorType Splat(int64 item) { return _mm256_set1_epi64x(item); }
+		static uint32 EqualMask(VectorType a, VectorType b) { return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b))); }
+	};
+
+	template <typename TOps, typename T>
+	int32 VectorFind(const T* data, int32 num, T item)
+	{
+		const int32 numLanes = sizeof(typename TOps::VectorType) / sizeof(T);
+		const auto itemVector = TOps::Splat(item);
+		int32 index = 0;
+		for (; index + numLanes <= num; index += numLanes)
+		{
+			const uint32 mask = TOps::EqualMask(TOps::Load(data + index), itemVector);
+			if (mask != 0)
+			{
+				return index + static_cast<int32>(FMath::CountTrailingZeros(mask) / sizeof(T));
+			}
+		}
+		const int32 tailIndex = ScalarFind(data + index, num - index, item);
+		return (tailIndex == INDEX_NONE) ? INDEX_NONE : (index + tailIndex);
+	}
+
+	template <typename TOps, typename T>
+	int32 VectorCount(const T* data, int32 num, T item)
+	{
+		const int32 numLanes = sizeof(typename TOps::VectorType) / sizeof(T);
+		const auto itemVector = TOps::Splat(item);
+		int32 count = 0;
+		int32 index = 0;
+		for (; index + numLanes <= num; index += numLanes)
+		{
+			// the mask has a bit per byte, so each matching element sets sizeof(T) bits, divide per
+			// block so the count can't overflow before it's scaled down
+			count += PopCount(TOps::EqualMask(TOps::Load(data + index), itemVector)) / static_cast<int32>(sizeof(T));
+		}
+		return count + ScalarCount(data + index, num - index, item);
+	}
+
+	template <typename TOps, typename T>
+	int32 VectorFindAny(const T* data, int32 num, const T* items, int32 numItems)
+	{
+		if (numItems > MaxVectorFindAnyItems)
+		{
+			return ScalarFindAny(data, num, items, numItems);
+		}
+		const int32 numLanes = sizeof(typename TOps::VectorType) / sizeof(T);
+		typename TOps::VectorType itemVectors[MaxVectorFindAnyItems];
+		for (int32 itemIndex = 0; itemIndex < numItems; ++itemIndex)
+		{
+			itemVectors[itemIndex] = TOps::Splat(items[itemIndex]);
+		}
+		int32 index = 0;
+		for (; index + numLanes <= num; index += numLanes)
+		{
+			const auto dataVector = TOps::Load(data + index);
+			uint32 mask = 0;
+			for (int32 itemIndex = 0; itemIndex < numItems; ++itemIndex)
+			{
+				mask |= TOps::EqualMask(dataVector, itemVectors[itemIndex]);
+			}
+			if (mask != 0)
+			{
+				return index + static_cast<int32>(FMath::CountTrailingZeros(mask) / sizeof(T));
+			}
+		}
+		const int32 tailIndex = ScalarFindAny(data + index, num - index, items, numItems);
+		return (tailIndex == INDEX_NONE) ? INDEX_NONE : (index + tailIndex);
+	}
+#endif // KLAWR_ARRAYUTILS_SIMD
+
+	// NOTE: The AVX2 code paths call _mm256_zeroupper() before returning because the rest of
+	//       the module is compiled without VEX encoding, and mixing the two without clearing the
+	//       upper halves of the YMM registers incurs a hefty transition penalty.
+
+	template <typename T>
+	int32 FindUsing(EInstructionSet instructionSet, const T* data, int32 num, T item)
+	{
+#if KLAWR_ARRAYUTILS_SIMD
+		if (instructionSet == EInstructionSet::AVX2)
+		{
+			const int32 result = VectorFind<TAvx2Ops<T>>(data, num, item);
+			_mm256_zeroupper();
+			return result;
+		}
+		if (instructionSet == EInstructionSet::SSE2)
+		{
+			return VectorFind<TSse2Ops<T>>(data, num, item);
+		}
+#endif
+		return ScalarFind(data, num, item);
+	}
+
+	template <typename T>
+	int32 CountUsing(EInstructionSet instructionSet, const T* data, int32 num, T item)
+	{
+#if KLAWR_ARRAYUTILS_SIMD
+		if (instructionSet == EInstructionSet::AVX2)
+		{
+			const int32 result = VectorCount<TAvx2Ops<T>>(data, num, item);
+			_mm256_zeroupper();
+			return result;
+		}
+		if (instructionSet == EInstructionSet::SSE2)
+		{
+			return VectorCount<TSse2Ops<T>>(data, num, item);
+		}
+#endif
+		return ScalarCount(data, num, item);
+	}
+
+	template <typename T>
+	int32 FindAnyUsing(
+		EInstructionSet instructionSet, const T* data, int32 num, const T* items, int32 numItems
+	)
+	{
+#if KLAWR_ARRAYUTILS_SIMD
+		if (instructionSet == EInstructionSet::AVX2)
+		{
+			const int32 result = VectorFindAny<TAvx2Ops<T>>(data, num, items, numItems);
+			_mm256_zeroupper();
+			return result;
+		}
+		if (instructionSet == EInstructionSet::SSE2)
+		{
+			return VectorFindAny<TSse2Ops<T>>(data, num, items, numItems);
+		}
+#endif
+		return ScalarFindAny(data, num, items, numItems);
+	}
+} // unnamed namespace
+
+EInstructionSet GetInstructionSet()
+{
+	static const EInstructionSet instructionSet = DetectInstructionSet();
+	return instructionSet;
+}
+
+const TCHAR* GetInstructionSetName(EInstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+		case EInstructionSet::SSE2:
+			return TEXT("SSE2");
+		case EInstructionSet::AVX2:
+			return TEXT("AVX2");
+		default:
+			return TEXT("Scalar");
+	}
+}
+
+template <typename T>
+int32 Find(const T* data, int32 num, T item)
+{
+	return FindUsing(GetInstructionSet(), data, num, item);
+}
+
+template <typename T>
+int32 Count(const T* data, int32 num, T item)
+{
+	return CountUsing(GetInstructionSet(), data, num, item);
+}
+
+template <typename T>
+int32 FindAny(const T* data, int32 num, const T* items, int32 numItems)
+{
+	return FindAnyUsing(GetInstructionSet(), data, num, items, numItems);
+}
+
+template int32 Find<uint8>(const uint8*, int32, uint8);
+template int32 Find<int16>(const int16*, int32, int16);
+template int32 Find<int32>(const int32*, int32, int32);
+template int32 Find<int64>(const int64*, int32, int64);
+
+template int32 Count<uint8>(const uint8*, int32, uint8);
+template int32 Count<int16>(const int16*, int32, int16);
+template int32 Count<int32>(const int32*, int32, int32);
+template int32 Count<int64>(const int64*, int32, int64);
+
+template int32 FindAny<uint8>(const uint8*, int32, const uint8*, int32);
+template int32 FindAny<int16>(const int16*, int32, const int16*, int32);
+template int32 FindAny<int32>(const int32*, int32, const int32*, int32);
+template int32 FindAny<int64>(const int64*, int32, const int64*, int32);
+
+#if !UE_BUILD_SHIPPING
+
+namespace 
+{
+	// results of the benchmarked calls are accumulated here so the optimizer can't discard them
+	volatile int32 BenchmarkSink = 0;
+
+	/** Run the given function the specified number of times, return the mean time per call in microseconds. */
+	template <typename TFunc>
+	double TimeCalls(int32 numCalls, TFunc func)
+	{
+		int32 sink = 0;
+		const double startTime = FPlatformTime::Seconds();
+		for (int32 call = 0; call < numCalls; ++call)
+		{
+			sink += func();
+		}
+		const double elapsedTime = FPlatformTime::Seconds() - startTime;
+		BenchmarkSink += sink;
+		return (elapsedTime * 1000000.0) / numCalls;
+	}
+
+	template <typename T>
+	void BenchmarkElementType(const TCHAR* typeName)
+	{
+		const int32 arraySizes[] = { 1000, 10000, 100000, 1000000 };
+		// every element of the array is smaller than this so searches always scan the whole array
+		const T missingItem = static_cast<T>(127);
+		const T anyItems[] = { static_cast<T>(125), static_cast<T>(126), missingItem };
+		const EInstructionSet bestInstructionSet = GetInstructionSet();
+
+		for (const int32 arraySize : arraySizes)
+		{
+			TArray<T> array;
+			array.SetNumUninitialized(arraySize);
+			for (int32 index = 0; index < arraySize; ++index)
+			{
+				array[index] = static_cast<T>(index % 100);
+			}
+			const T* data = array.GetData();
+			// scan roughly the same number of elements for every array size
+			const int32 numCalls = FMath::Max(1, (64 * 1000 * 1000) / arraySize);
+
+			const double baselineTime = TimeCalls(numCalls, [&]() { return array.Find(missingItem); });
+			FString findResults = FString::Printf(TEXT("TArray::Find %.2fus"), baselineTime);
+			FString countResults;
+			FString findAnyResults;
+
+			for (uint8 level = 0; level <= static_cast<uint8>(bestInstructionSet); ++level)
+			{
+				const auto instructionSet = static_cast<EInstructionSet>(level);
+				const TCHAR* instructionSetName = GetInstructionSetName(instructionSet);
+
+				const double findTime = TimeCalls(numCalls, [&]() 
+				{ 
+					return FindUsing(instructionSet, data, arraySize, missingItem); 
+				});
+				findResults += FString::Printf(
+					TEXT(", %s %.2fus (%.1fx)"), instructionSetName, findTime, 
+					baselineTime / FMath::Max(findTime, SMALL_NUMBER)
+				);
+
+				const double countTime = TimeCalls(numCalls, [&]() 
+				{ 
+					return CountUsing(instructionSet, data, arraySize, missingItem); 
+				});
+				countResults += FString::Printf(
+					TEXT("%s%s %.2fus"), countResults.IsEmpty() ? TEXT("") : TEXT(", "),
+					instructionSetName, countTime
+				);
+
+				const double findAnyTime = TimeCalls(numCalls, [&]() 
+				{ 
+					return FindAnyUsing(instructionSet, data, arraySize, anyItems, ARRAY_COUNT(anyItems)); 
+				});
+				findAnyResults += FString::Printf(
+					TEXT("%s%s %.2fus"), findAnyResults.IsEmpty() ? TEXT("") : TEXT(", "),
+					instructionSetName, findAnyTime
+				);
+			}
+
+			UE_LOG(
+				LogKlawrRuntimePlugin, Display, TEXT("TArray<%s>[%d] Find: %s"), 
+				typeName, arraySize, *findResults
+			);
+			UE_LOG(
+				LogKlawrRuntimePlugin, Display, TEXT("TArray<%s>[%d] Count: %s"), 
+				typeName, arraySize, *countResults
+			);
+			UE_LOG(
+				LogKlawrRuntimePlugin, Display, TEXT("TArray<%s>[%d] FindAny(%d items): %s"), 
+				typeName, arraySize, ARRAY_COUNT(anyItems), *findAnyResults
+			);
+		}
+	}
+
+	void BenchmarkArrayUtils()
+	{
+		UE_LOG(
+			LogKlawrRuntimePlugin, Display, TEXT("Benchmarking array search kernels (best instruction set: %s)..."), 
+			GetInstructionSetName(GetInstructionSet())
+		);
+		BenchmarkElementType<uint8>(TEXT("uint8"));
+		BenchmarkElementType<int16>(TEXT("int16"));
+		BenchmarkElementType<int32>(TEXT("int32"));
+		BenchmarkElementType<int64>(TEXT("int64"));
+	}
+
+	FAutoConsoleCommand BenchmarkArrayUtilsCommand(
+		TEXT("Klawr.BenchmarkArrayUtils"),
+		TEXT("Compare the performance of the TArray search kernels used by managed code to TArray::Find() on 1k-1M element arrays."),
+		FConsoleCommandDelegate::CreateStatic(&BenchmarkArrayUtils)
+	);
+} // unnamed namespace
+
+#endif // !UE_BUILD_SHIPPING
+
+} // namespace ArrayUtilsSimd
+} // namespace Klawr
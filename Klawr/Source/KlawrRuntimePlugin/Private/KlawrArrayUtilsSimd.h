@@ -0,0 +1,71 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+namespace Klawr {
+namespace ArrayUtilsSimd {
+
+/** Instruction sets the search kernels can be dispatched to. */
+enum class EInstructionSet : uint8
+{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+/** 
+ * Get the best instruction set supported by the host CPU, this is detected once and then cached.
+ */
+EInstructionSet GetInstructionSet();
+
+/** Get a human readable name for the given instruction set (used for logging). */
+const TCHAR* GetInstructionSetName(EInstructionSet instructionSet);
+
+/**
+ * Find the index of the first element equal to the given item.
+ *
+ * Only instantiated for uint8, int16, int32, and int64.
+ * @return Index of the first matching element, or INDEX_NONE if there are no matches.
+ */
+template <typename T>
+int32 Find(const T* data, int32 num, T item);
+
+/**
+ * Count the number of elements equal to the given item.
+ *
+ * Only instantiated for uint8, int16, int32, and int64.
+ */
+template <typename T>
+int32 Count(const T* data, int32 num, T item);
+
+/**
+ * Find the index of the first element equal to any of the given items.
+ *
+ * Only instantiated for uint8, int16, int32, and int64.
+ * @return Index of the first matching element, or INDEX_NONE if there are no matches.
+ */
+template <typename T>
+int32 FindAny(const T* data, int32 num, const T* items, int32 numItems);
+
+} // namespace ArrayUtilsSimd
+} // namespace Klawr
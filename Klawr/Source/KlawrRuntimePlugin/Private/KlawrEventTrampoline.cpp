@@ -0,0 +1,289 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+
+#include "KlawrRuntimePluginPrivatePCH.h"
+#include "KlawrEventTrampoline.h"
+#include "KlawrObjectReferencer.h"
+
+using Klawr::VariantArg;
+using Klawr::VariantArgType::VariantArgType_t;
+
+TMap<int, UKlawrEventTrampoline*> UKlawrEventTrampoline::Trampolines;
+int32 UKlawrEventTrampoline::LastBindingID = 0;
+
+UKlawrEventBinding::UKlawrEventBinding(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Trampoline(nullptr)
+	, BindingID(0)
+{
+}
+
+void UKlawrEventBinding::HandleEvent()
+{
+	// never called, see ProcessEvent()
+}
+
+void UKlawrEventBinding::ProcessEvent(UFunction* Function, void* Parms)
+{
+	// HandleEvent() is the only function a binding has, so there's nothing else to process
+	if (Trampoline)
+	{
+		Trampoline->ProcessBinding(BindingID, Parms);
+	}
+}
+
+UKlawrEventTrampoline::UKlawrEventTrampoline(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, AppDomainID(0)
+	, Dispatch(nullptr)
+{
+}
+
+bool UKlawrEventTrampoline::GetEventParams(const UFunction* Signature, TArray<FEventParam>& OutParams)
+{
+	for (TFieldIterator<UProperty> ParamIt(Signature); ParamIt; ++ParamIt)
+	{
+		const UProperty* Param = *ParamIt;
+		if (!Param->HasAnyPropertyFlags(CPF_Parm) || Param->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			continue;
+		}
+		FEventParam EventParam;
+		EventParam.Property = Param;
+		// must match FCodeGenerator::GetEventSkipReason()
+		if (Param->IsA<UIntProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::Int;
+		}
+		else if (Param->IsA<UFloatProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::Float;
+		}
+		else if (Param->IsA<UBoolProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::Bool;
+		}
+		else if (Param->IsA<UStrProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::String;
+		}
+		else if (Param->IsA<UObjectProperty>() && !Param->IsA<UClassProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::Object;
+		}
+		else if (Param->IsA<UStructProperty>())
+		{
+			EventParam.Type = Klawr::VariantArgType::Struct;
+		}
+		else
+		{
+			UE_LOG(
+				LogKlawrRuntimePlugin, Error, 
+				TEXT("Parameter %s of %s can't be passed to managed code."), 
+				*Param->GetName(), *Signature->GetName()
+			);
+			return false;
+		}
+		OutParams.Add(EventParam);
+	}
+	return true;
+}
+
+int32 UKlawrEventTrampoline::BindEvent(
+	int InAppDomainID, UObject* SourceObject, const TCHAR* DelegateName, 
+	Klawr::EventUtilsProxy::DispatchEventAction Dispatch
+)
+{
+	if (!SourceObject || !Dispatch)
+	{
+		return 0;
+	}
+
+	auto DelegateProperty = FindField<UMulticastDelegateProperty>(SourceObject->GetClass(), DelegateName);
+	if (!DelegateProperty)
+	{
+		UE_LOG(
+			LogKlawrRuntimePlugin, Error, TEXT("%s has no event named %s."), 
+			*SourceObject->GetClass()->GetName(), DelegateName
+		);
+		return 0;
+	}
+
+	FEventBinding Binding;
+	if (!GetEventParams(DelegateProperty->SignatureFunction, Binding.Params))
+	{
+		return 0;
+	}
+
+	// the trampoline belongs to the app domain that requested the binding rather than the one the
+	// source object was created in, since that's the app domain the dispatcher lives in
+	UKlawrEventTrampoline*& Trampoline = Trampolines.FindOrAdd(InAppDomainID);
+	if (!Trampoline)
+	{
+		Trampoline = NewObject<UKlawrEventTrampoline>(GetTransientPackage());
+		// kept alive until the app domain is destroyed
+		Trampoline->AddToRoot();
+		Trampoline->AppDomainID = InAppDomainID;
+		// every binding made in an app domain uses the same dispatcher
+		Trampoline->Dispatch = Dispatch;
+	}
+	check(Trampoline->Dispatch == Dispatch);
+
+	const int32 BindingID = ++LastBindingID;
+	Binding.SourceObject = SourceObject;
+	Binding.DelegateProperty = DelegateProperty;
+	Binding.Object = NewObject<UKlawrEventBinding>(Trampoline);
+	Binding.Object->Trampoline = Trampoline;
+	Binding.Object->BindingID = BindingID;
+
+	FScriptDelegate ScriptDelegate;
+	ScriptDelegate.BindUFunction(
+		Binding.Object, GET_FUNCTION_NAME_CHECKED(UKlawrEventBinding, HandleEvent)
+	);
+	DelegateProperty->ContainerPtrToValuePtr<FMulticastScriptDelegate>(SourceObject)->AddUnique(ScriptDelegate);
+
+	Trampoline->Bindings.Add(BindingID, MoveTemp(Binding));
+	return BindingID;
+}
+
+void UKlawrEventTrampoline::UnbindEvent(int32 BindingID)
+{
+	for (const auto& Pair : Trampolines)
+	{
+		if (Pair.Value->Bindings.Contains(BindingID))
+		{
+			Pair.Value->RemoveBinding(BindingID);
+			return;
+		}
+	}
+}
+
+void UKlawrEventTrampoline::RemoveBinding(int32 BindingID)
+{
+	FEventBinding Binding;
+	if (!Bindings.RemoveAndCopyValue(BindingID, Binding))
+	{
+		return;
+	}
+	
+	if (UObject* SourceObject = Binding.SourceObject.Get())
+	{
+		Binding.DelegateProperty->ContainerPtrToValuePtr<FMulticastScriptDelegate>(SourceObject)->Remove(
+			Binding.Object, GET_FUNCTION_NAME_CHECKED(UKlawrEventBinding, HandleEvent)
+		);
+	}
+	// a copy of the invocation list that is currently being broadcast may still call the binding
+	// object, once it's detached it ignores the call, and now that it's been removed from 
+	// Bindings it will be garbage collected
+	Binding.Object->Trampoline = nullptr;
+}
+
+void UKlawrEventTrampoline::DestroyAppDomainTrampoline(int AppDomainID)
+{
+	UKlawrEventTrampoline* Trampoline = nullptr;
+	if (Trampolines.RemoveAndCopyValue(AppDomainID, Trampoline))
+	{
+		TArray<int32> BindingIDs;
+		Trampoline->Bindings.GenerateKeyArray(BindingIDs);
+		for (int32 BindingID : BindingIDs)
+		{
+			Trampoline->RemoveBinding(BindingID);
+		}
+		Trampoline->Dispatch = nullptr;
+		Trampoline->RemoveFromRoot();
+	}
+}
+
+void UKlawrEventTrampoline::ProcessBinding(int32 BindingID, void* Parms)
+{
+	const FEventBinding* Binding = Bindings.Find(BindingID);
+	if (!Binding || !Dispatch)
+	{
+		return;
+	}
+
+	TArray<VariantArg, TInlineAllocator<8>> Args;
+	TArray<UObject*, TInlineAllocator<8>> ObjectArgs;
+	Args.AddZeroed(Binding->Params.Num());
+	for (int32 ParamIndex = 0; ParamIndex < Binding->Params.Num(); ++ParamIndex)
+	{
+		const FEventParam& Param = Binding->Params[ParamIndex];
+		const void* Value = Param.Property->ContainerPtrToValuePtr<void>(Parms);
+		VariantArg& Arg = Args[ParamIndex];
+		Arg.Type = Param.Type;
+		switch (Param.Type)
+		{
+			case Klawr::VariantArgType::Int:
+				Arg.Data[0] = *static_cast<const int32*>(Value);
+				break;
+
+			case Klawr::VariantArgType::Float:
+				*reinterpret_cast<float*>(Arg.Data) = *static_cast<const float*>(Value);
+				break;
+
+			case Klawr::VariantArgType::Bool:
+				Arg.Data[0] = static_cast<const UBoolProperty*>(Param.Property)->GetPropertyValue(Value) ? 1 : 0;
+				break;
+
+			case Klawr::VariantArgType::String:
+				*reinterpret_cast<const TCHAR**>(Arg.Data) = **static_cast<const FString*>(Value);
+				break;
+
+			case Klawr::VariantArgType::Object:
+			{
+				UObject* Object = *static_cast<UObject* const*>(Value);
+				// keeps the object alive while the handlers run, a handler that wants a handle to
+				// the object adds its own reference (see NativeEventArgs.GetObject())
+				if (Object)
+				{
+					Klawr::FObjectReferencer::AddObjectRef(Object);
+					ObjectArgs.Add(Object);
+				}
+				*reinterpret_cast<UObject**>(Arg.Data) = Object;
+				break;
+			}
+
+			case Klawr::VariantArgType::Struct:
+				*reinterpret_cast<const void**>(Arg.Data) = Value;
+				break;
+		}
+	}
+	// Binding may be invalidated by the handlers (if they unbind), so it mustn't be used past here
+	Dispatch(BindingID, Args.GetData(), Args.Num());
+
+	for (UObject* Object : ObjectArgs)
+	{
+		Klawr::FObjectReferencer::RemoveObjectRef(Object);
+	}
+}
+
+void UKlawrEventTrampoline::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	auto This = CastChecked<UKlawrEventTrampoline>(InThis);
+	for (auto& Pair : This->Bindings)
+	{
+		Collector.AddReferencedObject(Pair.Value.Object, This);
+	}
+	Super::AddReferencedObjects(InThis, Collector);
+}
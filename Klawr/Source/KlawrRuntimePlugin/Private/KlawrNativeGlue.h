@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//-------------------------------------------------------------------------------
+#pragma once
+
+#include "KlawrClrHost.h"
+#include "KlawrObjectReferencer.h"
+#include "KlawrArrayHelper.h"
+
+namespace Klawr {
+
+/** Used by the generated native wrappers to look up the properties they wrap. */
+UProperty* FindScriptPropertyHelper(const UClass* Class, FName PropertyName);
+
+/** 
+ * Record the native layout of a struct that has a generated C# counterpart, the layouts are 
+ * checked against the C# structs whenever an engine app domain is initialized.
+ * @param StructName Name of the struct without a prefix (e.g. HitResult).
+ * @param ManagedStructName Name of the C# struct (e.g. FHitResult).
+ * @param FieldNames Pairs of native property names and corresponding C# field names.
+ * @param NumFields Number of elements in the FieldNames array.
+ */
+void AddStructLayout(
+	const TCHAR* StructName, const TCHAR* ManagedStructName, const TCHAR* const (*FieldNames)[2], 
+	int32 NumFields
+);
+
+namespace NativeGlue {
+
+/** 
+ * Register the generated native wrappers with the CLR host.
+ * Defined in KlawrGeneratedNativeWrappers.inl, the wrappers themselves are compiled in 
+ * KlawrNativeGlueShard<N>.cpp.
+ */
+void RegisterWrapperClasses();
+
+/** 
+ * Call AddStructLayout() for each struct that has a generated C# counterpart.
+ * Defined in KlawrGeneratedNativeWrappers.inl.
+ */
+void RegisterStructLayouts();
+
+} // namespace NativeGlue
+} // namespace Klawr
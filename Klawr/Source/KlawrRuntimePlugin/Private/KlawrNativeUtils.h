@@ -33,6 +33,7 @@ struct FNativeUtils
 	static ObjectUtilsProxy Object;
 	static LogUtilsProxy Log;
 	static ArrayUtilsProxy Array;
+	static EventUtilsProxy Event;
 };
 
 } // namespace Klawr
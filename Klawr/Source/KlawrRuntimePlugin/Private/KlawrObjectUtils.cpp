@@ -55,6 +55,15 @@ namespace Klawr {
 				Klawr::FObjectReferencer::RemoveObjectRef(obj);
 			}
 		}
+
+		static void AddObjectRef(UObject* obj)
+		{
+			// must match RemoveObjectRef()
+			if (!obj->IsA<UClass>())
+			{
+				Klawr::FObjectReferencer::AddObjectRef(obj);
+			}
+		}
 	} // namespace ObjectUtils
 
 	ObjectUtilsProxy FNativeUtils::Object =
@@ -62,7 +71,8 @@ namespace Klawr {
 		ObjectUtils::GetClassByName,
 		ObjectUtils::GetClassName,
 		ObjectUtils::IsClassChildOf,
-		ObjectUtils::RemoveObjectRef
+		ObjectUtils::RemoveObjectRef,
+		ObjectUtils::AddObjectRef
 	};
 
 } // namespace Klawr
\ No newline at end of file
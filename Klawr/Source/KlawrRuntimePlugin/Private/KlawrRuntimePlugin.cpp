@@ -25,7 +25,11 @@
 #include "KlawrClrHost.h"
 #include "KlawrNativeUtils.h"
 #include "KlawrObjectReferencer.h"
+#include "KlawrNativeGlue.h"
 #include "KlawrBlueprintGeneratedClass.h"
+#include "KlawrEventTrampoline.h"
+#include "KlawrScriptComponent.h"
+#include "KlawrArgArray.h"
 
 #if WITH_EDITOR
 #include "BlueprintEditorUtils.h"
@@ -33,6 +37,7 @@
 #include "KismetEditorUtilities.h"
 #include "CompilerResultsLog.h"
 #include "KlawrBlueprint.h"
+#include "JsonObjectConverter.h"
 #endif
 
 DEFINE_LOG_CATEGORY(LogKlawrRuntimePlugin);
@@ -53,12 +58,65 @@ UProperty* FindScriptPropertyHelper(const UClass* Class, FName PropertyName)
 	return nullptr;
 }
 
+namespace {
+
+/** Layouts recorded by AddStructLayout(), these are passed to the CLR host. */
+TArray<NativeStructFieldLayout>& GetStructLayouts()
+{
+	static TArray<NativeStructFieldLayout> StructLayouts;
+	return StructLayouts;
+}
+
+} // unnamed namespace
+
+void AddStructLayout(
+	const TCHAR* StructName, const TCHAR* ManagedStructName, const TCHAR* const (*FieldNames)[2], 
+	int32 NumFields
+)
+{
+	const UScriptStruct* Struct = FindObject<UScriptStruct>(ANY_PACKAGE, StructName);
+	if (!Struct)
+	{
+		UE_LOG(LogKlawrRuntimePlugin, Warning, TEXT("Can't find struct %s to check its layout."), StructName);
+		return;
+	}
+
+	TArray<NativeStructFieldLayout>& StructLayouts = GetStructLayouts();
+	const int32 StructSize = Struct->GetStructureSize();
+	// the first entry for a struct only describes its size
+	StructLayouts.Add({ ManagedStructName, nullptr, StructSize, 0, 0 });
+
+	for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+	{
+		const UProperty* Property = FindField<UProperty>(Struct, FieldNames[FieldIndex][0]);
+		if (!Property)
+		{
+			UE_LOG(
+				LogKlawrRuntimePlugin, Warning, TEXT("Can't find property %s of struct %s."), 
+				FieldNames[FieldIndex][0], StructName
+			);
+			continue;
+		}
+
+		int32 Offset = Property->GetOffset_ForInternal();
+		int32 Mask = 0;
+		const UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property);
+		if (BoolProperty && !BoolProperty->IsNativeBool())
+		{
+			// the C# struct wraps the byte the bitfield is stored in
+			Offset += BoolProperty->GetByteOffset();
+			Mask = BoolProperty->GetFieldMask();
+		}
+		StructLayouts.Add({ ManagedStructName, FieldNames[FieldIndex][1], StructSize, Offset, Mask });
+	}
+}
+
 namespace NativeGlue {
 
 // defined in KlawrGeneratedNativeWrappers.inl (included down below)
-void RegisterWrapperClasses();
 #if !defined WITH_KLAWR
 void RegisterWrapperClasses() {}
+void RegisterStructLayouts() {}
 #endif
 
 
@@ -70,8 +128,21 @@ class FRuntimePlugin : public IKlawrRuntimePlugin
 
 #if WITH_EDITOR
 	int PIEAppDomainID;
+	// a spare app domain that's ready to be handed out by AcquireAppDomain()
+	int StandbyAppDomainID;
+	// time stamp of the game scripts assembly loaded in the standby app domain
+	FDateTime StandbyAssemblyTimeStamp;
+	// true if the standby app domain couldn't be created for the current game scripts assembly
+	bool bStandbyAppDomainFailed;
+	// names of the script component types in the primary engine app domain
+	TArray<FString> ScriptComponentTypes;
+	// true if ScriptComponentTypes matches the current primary engine app domain
+	bool bScriptComponentTypesValid;
+	uint32 ScriptComponentTypesVersion;
 #endif // WITH_EDITOR
 
+	FString ScriptsAssemblyFilename;
+
 public:
 
 	FRuntimePlugin()
@@ -79,6 +150,10 @@ public:
 	{
 #if WITH_EDITOR
 		PIEAppDomainID = 0;
+		StandbyAppDomainID = 0;
+		bStandbyAppDomainFailed = false;
+		bScriptComponentTypesValid = false;
+		ScriptComponentTypesVersion = 0;
 #endif // WITH_EDITOR
 	}
 
@@ -88,39 +163,40 @@ public:
 		PIEAppDomainID = AppDomainID;
 	}
 
-	virtual bool ReloadPrimaryAppDomain() override
+	virtual bool ReloadPrimaryAppDomain(bool bPreserveScriptState) override
 	{
 		// to ensure that we don't end up without a primary engine app domain because any of the
 		// assemblies couldn't be reloaded for whatever reason we create a new app domain before
 		// getting rid of the current one
 		bool bReloaded = false;
 		int NewAppDomainID = 0;
+		// the primary app domain is only reloaded when the game scripts assembly changes, so the
+		// standby app domain (if any) has the old assembly loaded and can't be used
+		DiscardStandbyAppDomain();
 		if (CreateAppDomain(NewAppDomainID))
 		{
+			TMap<FString, FString> OldTypeSignatures;
+			GetScriptTypeSignatures(PrimaryEngineAppDomainID, OldTypeSignatures);
+
+			// the managed script component instances can't outlive the app domain they live in
+			UKlawrScriptComponent::SuspendScriptComponents(
+				PrimaryEngineAppDomainID, bPreserveScriptState
+			);
 			if (DestroyPrimaryAppDomain())
 			{
 				PrimaryEngineAppDomainID = NewAppDomainID;
 				bReloaded = true;
 
+				TMap<FString, FString> NewTypeSignatures;
+				GetScriptTypeSignatures(PrimaryEngineAppDomainID, NewTypeSignatures);
+				RecompileChangedBlueprints(OldTypeSignatures, NewTypeSignatures);
 			}
 			else
 			{
 				DestroyAppDomain(NewAppDomainID);
 			}
-			FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-			TArray<FAssetData> AssetData;
-			AssetRegistryModule.Get().GetAssetsByClass(UKlawrBlueprint::StaticClass()->GetFName(), AssetData);
-
-			for (const auto& iter : AssetData)
-			{
-				UE_LOG(LogKlawrRuntimePlugin, Log, TEXT("Recreating Graph for class %s"), *(iter.AssetName.ToString()));
-				UKlawrBlueprint* temp = CastChecked<UKlawrBlueprint>(iter.GetAsset());
-
-				FCompilerResultsLog LogResults;
-				LogResults.bLogDetailedResults = true;
-				LogResults.EventDisplayThresholdMs = 500;
-				FKismetEditorUtilities::CompileBlueprint(temp, false, false, false, &LogResults);
-			}
+			// components re-instanced by the blueprint compiler have already been recreated
+			UKlawrScriptComponent::ResumeScriptComponents();
 		}
 		else
 		{
@@ -132,16 +208,198 @@ public:
 		return bReloaded;
 	}
 
-	virtual void GetScriptComponentTypes(TArray<FString>& Types) override
+	virtual void PrepareStandbyAppDomain() override
+	{
+		const FDateTime AssemblyTimeStamp = IFileManager::Get().GetTimeStamp(*ScriptsAssemblyFilename);
+		if (AssemblyTimeStamp == StandbyAssemblyTimeStamp)
+		{
+			// either the standby app domain is ready, or it can't be created until the game 
+			// scripts assembly is rebuilt
+			if ((StandbyAppDomainID != 0) || bStandbyAppDomainFailed)
+			{
+				return;
+			}
+		}
+
+		DiscardStandbyAppDomain();
+		StandbyAssemblyTimeStamp = AssemblyTimeStamp;
+		bStandbyAppDomainFailed = !CreateAppDomain(StandbyAppDomainID);
+		if (bStandbyAppDomainFailed)
+		{
+			UE_LOG(LogKlawrRuntimePlugin, Warning, TEXT("Failed to create standby engine app domain."));
+			DestroyAppDomain(StandbyAppDomainID);
+			StandbyAppDomainID = 0;
+		}
+	}
+
+	virtual void DiscardStandbyAppDomain() override
+	{
+		if (StandbyAppDomainID != 0)
+		{
+			DestroyAppDomain(StandbyAppDomainID);
+			StandbyAppDomainID = 0;
+		}
+	}
+
+	virtual bool AcquireAppDomain(int& OutAppDomainID) override
+	{
+		if ((StandbyAppDomainID != 0) && 
+			(IFileManager::Get().GetTimeStamp(*ScriptsAssemblyFilename) == StandbyAssemblyTimeStamp))
+		{
+			OutAppDomainID = StandbyAppDomainID;
+			StandbyAppDomainID = 0;
+			return true;
+		}
+		// the standby app domain has an outdated game scripts assembly loaded
+		DiscardStandbyAppDomain();
+		return CreateAppDomain(OutAppDomainID);
+	}
+
+	/**
+	 * Get a signature for each script component type in an app domain, the signature covers 
+	 * everything the Klawr blueprint compiler reads from a type (the properties, functions, and 
+	 * their metadata), so if it doesn't change the blueprint doesn't need to be recompiled.
+	 */
+	void GetScriptTypeSignatures(int AppDomainID, TMap<FString, FString>& OutSignatures) const
+	{
+		if (AppDomainID == 0)
+		{
+			return;
+		}
+
+		IClrHost* clrHost = IClrHost::Get();
+		FCLRAssemblyInfo AssemblyInfo;
+		FJsonObjectConverter::JsonObjectStringToUStruct(
+			FString(clrHost->GetAssemblyInfo(AppDomainID)), &AssemblyInfo, 0, 0
+		);
+		for (const auto& ClassInfo : AssemblyInfo.ClassInfos)
+		{
+			FString Signature;
+			FJsonObjectConverter::UStructToJsonObjectString(
+				FCLRClassInfo::StaticStruct(), &ClassInfo, Signature, 0, 0
+			);
+			// the property flags aren't part of the assembly info
+			for (const auto& PropertyInfo : ClassInfo.PropertyInfos)
+			{
+				Signature += FString::Printf(
+					TEXT("|%s:%d%d"), *PropertyInfo.Name,
+					clrHost->GetScriptComponentPropertyIsAdvancedDisplay(
+						AppDomainID, *ClassInfo.Name, *PropertyInfo.Name
+					) ? 1 : 0,
+					clrHost->GetScriptComponentPropertyIsSaveGame(
+						AppDomainID, *ClassInfo.Name, *PropertyInfo.Name
+					) ? 1 : 0
+				);
+			}
+			OutSignatures.Add(ClassInfo.Name, Signature);
+		}
+	}
+
+	/** 
+	 * Recompile the Klawr blueprints whose script defined types were added, removed, or changed
+	 * shape, the blueprints of all other types are left alone.
+	 */
+	void RecompileChangedBlueprints(
+		const TMap<FString, FString>& OldTypeSignatures, 
+		const TMap<FString, FString>& NewTypeSignatures
+	)
 	{
-		std::vector<tstring> scriptTypes;
-		IClrHost::Get()->GetScriptComponentTypes(PrimaryEngineAppDomainID, scriptTypes);
-		Types.Reserve(scriptTypes.size());
-		for (const auto& scriptType : scriptTypes)
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		TArray<FAssetData> AssetData;
+		AssetRegistryModule.Get().GetAssetsByClass(UKlawrBlueprint::StaticClass()->GetFName(), AssetData);
+
+		TArray<UKlawrBlueprint*> ChangedBlueprints;
+		for (const auto& Asset : AssetData)
 		{
-			const TCHAR* type = *(FString(scriptType.c_str()));
-			Types.Add(FString(scriptType.c_str()));
+			// ScriptDefinedType is searchable, so the asset only needs to be loaded to find out
+			// which type it wraps if it was saved before the tag was added
+			FString TypeName;
+			const FString* TypeNameTag = Asset.TagsAndValues.Find(
+				GET_MEMBER_NAME_CHECKED(UKlawrBlueprint, ScriptDefinedType)
+			);
+			if (TypeNameTag)
+			{
+				TypeName = *TypeNameTag;
+			}
+			else
+			{
+				TypeName = CastChecked<UKlawrBlueprint>(Asset.GetAsset())->ScriptDefinedType;
+			}
+
+			const FString* OldSignature = OldTypeSignatures.Find(TypeName);
+			const FString* NewSignature = NewTypeSignatures.Find(TypeName);
+			if (!OldSignature || !NewSignature || !OldSignature->Equals(*NewSignature, ESearchCase::CaseSensitive))
+			{
+				ChangedBlueprints.Add(CastChecked<UKlawrBlueprint>(Asset.GetAsset()));
+			}
+			else if (Asset.IsAssetLoaded())
+			{
+				// the generated class still refers to the app domain that was just destroyed
+				auto Blueprint = CastChecked<UKlawrBlueprint>(Asset.GetAsset());
+				auto GeneratedClass = Cast<UKlawrBlueprintGeneratedClass>(Blueprint->GeneratedClass);
+				if (GeneratedClass)
+				{
+					GeneratedClass->appDomainId = GetObjectAppDomainID(GeneratedClass);
+				}
+			}
+		}
+
+		// garbage is only collected once after all the blueprints have been compiled, rather
+		// than after each one
+		for (auto Blueprint : ChangedBlueprints)
+		{
+			UE_LOG(LogKlawrRuntimePlugin, Log, TEXT("Recreating Graph for class %s"), *Blueprint->GetName());
+
+			FCompilerResultsLog LogResults;
+			LogResults.bLogDetailedResults = true;
+			LogResults.EventDisplayThresholdMs = 500;
+			FKismetEditorUtilities::CompileBlueprint(Blueprint, false, true, false, &LogResults);
 		}
+		if (ChangedBlueprints.Num() > 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		UE_LOG(
+			LogKlawrRuntimePlugin, Log, TEXT("Recompiled %d of %d Klawr blueprint(s)."), 
+			ChangedBlueprints.Num(), AssetData.Num()
+		);
+	}
+
+	virtual const TArray<FString>& GetScriptComponentTypes() override
+	{
+		// querying the app domain means scanning all the loaded assemblies, so only do it once 
+		// for each primary engine app domain
+		if (!bScriptComponentTypesValid)
+		{
+			std::vector<tstring> scriptTypes;
+			IClrHost::Get()->GetScriptComponentTypes(PrimaryEngineAppDomainID, scriptTypes);
+			ScriptComponentTypes.Reset(static_cast<int32>(scriptTypes.size()));
+			for (const auto& scriptType : scriptTypes)
+			{
+				ScriptComponentTypes.Emplace(scriptType.c_str());
+			}
+			ScriptComponentTypes.Sort();
+			bScriptComponentTypesValid = true;
+		}
+		return ScriptComponentTypes;
+	}
+
+	virtual uint32 GetScriptComponentTypesVersion() const override
+	{
+		return ScriptComponentTypesVersion;
+	}
+
+	void InvalidateScriptComponentTypes()
+	{
+		ScriptComponentTypes.Empty();
+		bScriptComponentTypesValid = false;
+		++ScriptComponentTypesVersion;
+	}
+
+	virtual bool WriteBindingUsage(const FString& UsageFilename) override
+	{
+		return IClrHost::Get()->WriteBindingUsage(PrimaryEngineAppDomainID, *UsageFilename);
 	}
 #endif // WITH_EDITOR
 
@@ -162,6 +420,9 @@ public:
 		if (ensure(PrimaryEngineAppDomainID == 0))
 		{
 			bCreated = CreateAppDomain(PrimaryEngineAppDomainID);
+#if WITH_EDITOR
+			InvalidateScriptComponentTypes();
+#endif // WITH_EDITOR
 
 			if (!bCreated)
 			{
@@ -181,6 +442,9 @@ public:
 		if (bDestroyed)
 		{
 			PrimaryEngineAppDomainID = 0;
+#if WITH_EDITOR
+			InvalidateScriptComponentTypes();
+#endif // WITH_EDITOR
 		}
 		else
 		{
@@ -201,7 +465,8 @@ public:
 			{
 				FNativeUtils::Object,
 				FNativeUtils::Log,
-				FNativeUtils::Array
+				FNativeUtils::Array,
+				FNativeUtils::Event
 			};
 			return clrHost->InitEngineAppDomain(outAppDomainID, nativeUtils);
 		}
@@ -216,6 +481,8 @@ public:
 			return true;
 		}
 
+		// the bindings must be removed while the managed dispatcher they call is still around
+		UKlawrEventTrampoline::DestroyAppDomainTrampoline(AppDomainID);
 		bool bDestroyed = IClrHost::Get()->DestroyEngineAppDomain(AppDomainID);
 
 #if WITH_EDITOR
@@ -243,6 +510,7 @@ public: // IModuleInterface interface
 	virtual void StartupModule() override
 	{
 		FObjectReferencer::Startup();
+		UKlawrArgArray::StartupPool();
 		FString GameAssembliesDir = FPaths::ConvertRelativePathToFull(
 			FPaths::Combine(
 				*FPaths::GameDir(), TEXT("Binaries"), FPlatformProcess::GetBinariesSubdirectory(),
@@ -250,9 +518,16 @@ public: // IModuleInterface interface
 			)
 		);
 		
+		// the game scripts are built into the shadow copied directory (see FGameProjectBuilder)
+		ScriptsAssemblyFilename = FPaths::Combine(
+			*GameAssembliesDir, TEXT("ShadowCopy"), TEXT("GameScripts.dll")
+		);
+
 		if (IClrHost::Get()->Startup(*GameAssembliesDir, TEXT("GameScripts")))
 		{
 			NativeGlue::RegisterWrapperClasses();
+			NativeGlue::RegisterStructLayouts();
+			IClrHost::Get()->SetStructLayouts(GetStructLayouts().GetData(), GetStructLayouts().Num());
 #if !WITH_EDITOR
 			// When running in the editor the primary app domain will be created when the Klawr 
 			// editor plugin starts up, which will be after the runtime plugin, this is done so that
@@ -272,6 +547,7 @@ public: // IModuleInterface interface
 		// the host will destroy all app domains on shutdown, there is no need to explicitly
 		// destroy the primary app domain
 		IClrHost::Get()->Shutdown();
+		UKlawrArgArray::ShutdownPool();
 		FObjectReferencer::Shutdown();
 	}
 
@@ -27,6 +27,16 @@
 #include "KlawrClrHost.h"
 #include "KlawrBlueprintGeneratedClass.h"
 
+#if WITH_EDITOR
+namespace
+{
+	/** State saved by UKlawrScriptComponent::SuspendScriptComponents(), keyed by component path name. */
+	TMap<FString, TArray<uint8>> SuspendedScriptStates;
+	/** Components whose managed instances were destroyed by SuspendScriptComponents(). */
+	TArray<TWeakObjectPtr<UKlawrScriptComponent>> SuspendedComponents;
+} // unnamed namespace
+#endif // WITH_EDITOR
+
 UKlawrScriptComponent::UKlawrScriptComponent(const FObjectInitializer& objectInitializer)
 	: Super(objectInitializer)
 	, Proxy(nullptr)
@@ -63,6 +73,9 @@ void UKlawrScriptComponent::CreateScriptComponentProxy()
 		else
 		{
 			check(Proxy->InstanceID != 0);
+#if WITH_EDITOR
+			RestoreSuspendedScriptState();
+#endif // WITH_EDITOR
 		}
 	}
 }
@@ -82,6 +95,92 @@ void UKlawrScriptComponent::DestroyScriptComponentProxy()
 	Proxy = nullptr;
 }
 
+#if WITH_EDITOR
+void UKlawrScriptComponent::RestoreSuspendedScriptState()
+{
+	if (SuspendedScriptStates.Num() == 0)
+	{
+		return;
+	}
+
+	// the path name is used as the key because a component that gets re-instanced while its 
+	// blueprint is recompiled is replaced by a new object with the same name and outer
+	const TArray<uint8>* State = SuspendedScriptStates.Find(GetPathName());
+	if (State)
+	{
+		bool bRestored = Klawr::IClrHost::Get()->RestoreScriptComponentState(
+			appDomainId, Proxy->InstanceID, State->GetData(), State->Num()
+		);
+		if (!bRestored)
+		{
+			UE_LOG(
+				LogKlawrRuntimePlugin, Warning, TEXT("Failed to restore the state of %s."), 
+				*GetPathName()
+			);
+		}
+	}
+}
+
+void UKlawrScriptComponent::SuspendScriptComponents(int AppDomainID, bool bSaveState)
+{
+	Klawr::IClrHost* ClrHost = Klawr::IClrHost::Get();
+	for (TObjectIterator<UKlawrScriptComponent> It; It; ++It)
+	{
+		UKlawrScriptComponent* Component = *It;
+		if (!Component->Proxy || (Component->appDomainId != AppDomainID))
+		{
+			continue;
+		}
+
+		if (bSaveState && !Component->IsPendingKill())
+		{
+			std::vector<unsigned char> State;
+			if (ClrHost->SaveScriptComponentState(AppDomainID, Component->Proxy->InstanceID, State))
+			{
+				SuspendedScriptStates.Add(
+					Component->GetPathName(), TArray<uint8>(State.data(), static_cast<int32>(State.size()))
+				);
+			}
+		}
+
+		if (Component->Proxy->OnUnregister)
+		{
+			Component->Proxy->OnUnregister();
+		}
+		Component->DestroyScriptComponentProxy();
+		SuspendedComponents.Add(Component);
+	}
+}
+
+void UKlawrScriptComponent::ResumeScriptComponents()
+{
+	for (const auto& WeakComponent : SuspendedComponents)
+	{
+		UKlawrScriptComponent* Component = WeakComponent.Get();
+		// components that were unregistered or re-instanced in the meantime will create a new 
+		// managed instance (if need be) when they're registered again
+		if (!Component || !Component->IsRegistered() || Component->Proxy)
+		{
+			continue;
+		}
+
+		// the previous values refer to the managed instance that no longer exists
+		for (auto& Tracker : Component->propertyTrackers)
+		{
+			Tracker.ResetPrevious();
+		}
+
+		Component->CreateScriptComponentProxy();
+		if (Component->Proxy && Component->Proxy->OnRegister)
+		{
+			Component->Proxy->OnRegister();
+		}
+	}
+	SuspendedComponents.Empty();
+	SuspendedScriptStates.Empty();
+}
+#endif // WITH_EDITOR
+
 void UKlawrScriptComponent::OnRegister()
 {
 	auto bpClass = UKlawrBlueprintGeneratedClass::GetBlueprintGeneratedClass(GetClass());
@@ -365,4 +464,123 @@ UObject* UKlawrScriptComponent::CallCSFunctionObject(FString functionName, UKlaw
 void UKlawrScriptComponent::CallCSFunctionVoid(FString functionName, UKlawrArgArray* args)
 {
 	IKlawrRuntimePlugin::Get().CallCSFunctionVoid(appDomainId, Proxy->InstanceID, *functionName, args);
+}
+
+namespace {
+
+/** Native arguments for a C# function called by one of the InvokeCSFunction*() thunks. */
+struct FCSFunctionCallFrame
+{
+	Klawr::VariantArg Args[UKlawrScriptComponent::MaxCSFunctionArgs];
+	// string arguments must stay alive until the C# function returns
+	FString Strings[UKlawrScriptComponent::MaxCSFunctionArgs];
+	int32 NumArgs;
+
+	FCSFunctionCallFrame() : NumArgs(0) {}
+};
+
+/** Read the next wildcard argument of an InvokeCSFunction*() thunk off the stack. */
+template <typename TProperty>
+void StepCSFunctionArg(FFrame& Stack, void* Result)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<TProperty>(Result);
+	// literals don't set MostRecentProperty, but variables and the results of other nodes do, and
+	// their type must match the one the Klawr function call node encoded in argTypes
+	check(!Stack.MostRecentProperty || Stack.MostRecentProperty->IsA<TProperty>());
+}
+
+} // unnamed namespace
+
+void UKlawrScriptComponent::InvokeCSFunction(
+	FFrame& Stack, void* Result, Klawr::ECSFunctionResultType ResultType
+)
+{
+	P_GET_PROPERTY(UStrProperty, functionName);
+	P_GET_PROPERTY(UIntProperty, argTypes);
+
+	// every wildcard argument is on the stack, but only the ones described by argTypes are used
+	FCSFunctionCallFrame Frame;
+	for (int32 ArgIndex = 0; ArgIndex < MaxCSFunctionArgs; ++ArgIndex)
+	{
+		const int32 TypeCode = (argTypes >> (ArgIndex * 4)) & 0xF;
+		if (TypeCode == 0)
+		{
+			int32 UnusedArg = 0;
+			StepCSFunctionArg<UIntProperty>(Stack, &UnusedArg);
+			continue;
+		}
+
+		Klawr::VariantArg& Arg = Frame.Args[Frame.NumArgs];
+		Arg.Type = static_cast<Klawr::VariantArgType::VariantArgType_t>(TypeCode - 1);
+		Arg.Data[0] = 0;
+		Arg.Data[1] = 0;
+		switch (Arg.Type)
+		{
+			case Klawr::VariantArgType::Int:
+				StepCSFunctionArg<UIntProperty>(Stack, Arg.Data);
+				break;
+
+			case Klawr::VariantArgType::Float:
+				StepCSFunctionArg<UFloatProperty>(Stack, Arg.Data);
+				break;
+
+			case Klawr::VariantArgType::Bool:
+			{
+				uint32 Value = 0;
+				StepCSFunctionArg<UBoolProperty>(Stack, &Value);
+				Arg.Data[0] = Value ? 1 : 0;
+				break;
+			}
+
+			case Klawr::VariantArgType::String:
+			{
+				FString& Value = Frame.Strings[Frame.NumArgs];
+				StepCSFunctionArg<UStrProperty>(Stack, &Value);
+				*(reinterpret_cast<const TCHAR**>(Arg.Data)) = *Value;
+				break;
+			}
+
+			case Klawr::VariantArgType::Object:
+				StepCSFunctionArg<UObjectPropertyBase>(Stack, Arg.Data);
+				break;
+
+			default:
+				checkf(false, TEXT("Unsupported argument type %d."), TypeCode - 1);
+				break;
+		}
+		++Frame.NumArgs;
+	}
+	P_FINISH;
+
+	Klawr::IClrHost* ClrHost = Klawr::IClrHost::Get();
+	const __int64 InstanceID = Proxy->InstanceID;
+	const TCHAR* FunctionName = *functionName;
+	Klawr::VariantArg* Args = (Frame.NumArgs > 0) ? Frame.Args : nullptr;
+	switch (ResultType)
+	{
+		case Klawr::ECSFunctionResultType::Float:
+			*static_cast<float*>(Result) = ClrHost->CallCSFunctionFloat(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+
+		case Klawr::ECSFunctionResultType::Int:
+			*static_cast<int32*>(Result) = ClrHost->CallCSFunctionInt(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+
+		case Klawr::ECSFunctionResultType::Bool:
+			*static_cast<bool*>(Result) = ClrHost->CallCSFunctionBool(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+
+		case Klawr::ECSFunctionResultType::String:
+			*static_cast<FString*>(Result) = ClrHost->CallCSFunctionString(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+
+		case Klawr::ECSFunctionResultType::Object:
+			*static_cast<UObject**>(Result) = ClrHost->CallCSFunctionObject(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+
+		case Klawr::ECSFunctionResultType::Void:
+			ClrHost->CallCSFunctionVoid(appDomainId, InstanceID, FunctionName, Args, Frame.NumArgs);
+			break;
+	}
 }
\ No newline at end of file
@@ -62,8 +62,44 @@ public:
 
 #if WITH_EDITOR
 	virtual void SetPIEAppDomainID(int AppDomainID) = 0;
-	virtual bool ReloadPrimaryAppDomain() = 0;
-	virtual void GetScriptComponentTypes(TArray<FString>& Types) = 0;
+	/**
+	 * Replace the primary engine app domain with a new one that has the latest game scripts 
+	 * assembly loaded, the managed instances of any live script components are recreated in the 
+	 * new app domain.
+	 * @param bPreserveScriptState If true the fields of the managed script component instances 
+	 *                             are carried over to the recreated instances.
+	 */
+	virtual bool ReloadPrimaryAppDomain(bool bPreserveScriptState) = 0;
+	/**
+	 * Create and initialize a spare engine app domain (unless one is already prepared) to be 
+	 * handed out by AcquireAppDomain(), this should be called while the editor is idle.
+	 * The spare only speeds up the start of PIE sessions, a reload of the primary app domain
+	 * always loads a new game scripts assembly so it can't use a spare prepared in advance.
+	 */
+	virtual void PrepareStandbyAppDomain() = 0;
+	/** Destroy the spare engine app domain created by PrepareStandbyAppDomain() (if any). */
+	virtual void DiscardStandbyAppDomain() = 0;
+	/**
+	 * Take the spare engine app domain created by PrepareStandbyAppDomain() if it has the 
+	 * current game scripts assembly loaded, otherwise create a new app domain.
+	 */
+	virtual bool AcquireAppDomain(int& OutAppDomainID) = 0;
+	/**
+	 * Get the fully qualified names of the script component types in the primary engine app 
+	 * domain (sorted by name), the names are cached until the primary engine app domain changes.
+	 */
+	virtual const TArray<FString>& GetScriptComponentTypes() = 0;
+	/** 
+	 * Get a number that changes whenever the names returned by GetScriptComponentTypes() may 
+	 * have changed, this lets callers cache anything they build from those names.
+	 */
+	virtual uint32 GetScriptComponentTypesVersion() const = 0;
+	/** 
+	 * Write the wrapper class members referenced by the game scripts assembly loaded in the 
+	 * primary engine app domain to the given file, the code generator reads this file when
+	 * TrimUnusedBindings is enabled in Klawr/Resources/Config.ini.
+	 */
+	virtual bool WriteBindingUsage(const FString& UsageFilename) = 0;
 #endif // WITH_EDITOR
 
 	virtual void SetFloat(int appDomainID, __int64 instanceID, const TCHAR* propertyName, float value) const = 0;
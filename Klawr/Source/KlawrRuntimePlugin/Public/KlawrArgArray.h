@@ -44,9 +44,22 @@ protected:
 
 public:
 
+	UKlawrArgArray(const FObjectInitializer& ObjectInitializer);
+
+	/** 
+	 * Get an empty arg array, arrays are taken from a pool where possible rather than creating a
+	 * new object for every C# function call made from a blueprint. Pooled arrays are returned to
+	 * the pool at the end of the frame, so an array must not be used beyond the frame it was
+	 * created in.
+	 */
 	UFUNCTION(BlueprintCallable, Category = ArgArray)
 	static UKlawrArgArray* Create();
 
+	/** Start returning the arrays handed out by Create() to the pool at the end of every frame. */
+	static void StartupPool();
+	/** Release all the pooled arrays so they can be garbage collected. */
+	static void ShutdownPool();
+
 	UFUNCTION(BlueprintCallable, Category = ArgArray)
 	virtual void Clear();
 
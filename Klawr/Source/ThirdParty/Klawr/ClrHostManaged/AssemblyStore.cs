@@ -0,0 +1,178 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+using System.Text;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// A content addressed store for the assemblies loaded by engine app domains.
+    /// </summary>
+    /// <remarks>
+    /// The game scripts are built into a source directory that can't be loaded from directly 
+    /// because the CLR locks any assembly file it loads, which would prevent the scripts from 
+    /// being rebuilt. Each distinct version of the source directory is copied into a 
+    /// subdirectory of the store named after a hash of its contents, so app domains that load 
+    /// the same version of the assemblies (including app domains created in previous sessions) 
+    /// share a single copy, and a copy is only made when the assemblies actually change.
+    /// Versions that are no longer loaded by any app domain are deleted by CollectGarbage().
+    /// </remarks>
+    public sealed class AssemblyStore{
+        private struct FileHash{
+            public long Length;
+            public DateTime LastWriteTimeUtc;
+            public string Hash;
+        }
+
+        // appended to the name of a version directory that is being deleted
+        private const string TrashSuffix = ".trash";
+
+        private readonly string _sourceDirectory;
+        private readonly string _storeDirectory;
+        // hashes of the files in the source directory, only recomputed when a file changes
+        private readonly Dictionary<string /*File Path*/, FileHash> _fileHashes = new Dictionary<string, FileHash>();
+        // the version loaded by each engine app domain
+        private readonly Dictionary<int /*Domain ID*/, string> _domainVersions = new Dictionary<int, string>();
+
+        /// <summary>
+        /// Construct a new store.
+        /// </summary>
+        /// <param name="sourceDirectory">Directory the assemblies are built into.</param>
+        /// <param name="storeDirectory">Directory to store copies of the assemblies in.</param>
+        public AssemblyStore(string sourceDirectory, string storeDirectory){
+            _sourceDirectory = sourceDirectory;
+            _storeDirectory = storeDirectory;
+        }
+
+        /// <summary>
+        /// Get the store subdirectory that contains the current version of the assemblies in the
+        /// source directory, the assemblies are copied into the store if this version isn't in it.
+        /// </summary>
+        /// <returns>Path of the subdirectory relative to the store directory, or null if the 
+        /// source directory is empty.</returns>
+        public string GetCurrentVersion(){
+            if (!Directory.Exists(_sourceDirectory)){
+                return null;
+            }
+            var files = Directory.GetFiles(_sourceDirectory).OrderBy(file => file, StringComparer.OrdinalIgnoreCase).ToArray();
+            if (files.Length == 0){
+                return null;
+            }
+
+            var contents = new StringBuilder();
+            foreach (var file in files){
+                contents.Append(Path.GetFileName(file).ToLowerInvariant()).Append(':').Append(GetFileHash(file)).Append(';');
+            }
+            var version = ComputeHash(Encoding.UTF8.GetBytes(contents.ToString()));
+
+            var versionDirectory = Path.Combine(_storeDirectory, version);
+            if (!Directory.Exists(versionDirectory)){
+                // copy into a temporary directory first so that a partially copied version is
+                // never mistaken for a complete one
+                var tempDirectory = versionDirectory + ".tmp";
+                if (Directory.Exists(tempDirectory)){
+                    Directory.Delete(tempDirectory, true);
+                }
+                Directory.CreateDirectory(tempDirectory);
+                foreach (var file in files){
+                    File.Copy(file, Path.Combine(tempDirectory, Path.GetFileName(file)));
+                }
+                Directory.Move(tempDirectory, versionDirectory);
+            }
+            return version;
+        }
+
+        /// <summary>
+        /// Record which version of the assemblies an engine app domain loads from the store.
+        /// </summary>
+        public void AddDomain(int domainId, string version){
+            _domainVersions[domainId] = version;
+        }
+
+        /// <summary>
+        /// Forget about an engine app domain that has been unloaded.
+        /// </summary>
+        public void RemoveDomain(int domainId){
+            _domainVersions.Remove(domainId);
+        }
+
+        /// <summary>
+        /// Delete all versions of the assemblies that aren't loaded by any engine app domain.
+        /// </summary>
+        public void CollectGarbage(){
+            if (!Directory.Exists(_storeDirectory)){
+                return;
+            }
+            var liveVersions = new HashSet<string>(_domainVersions.Values, StringComparer.OrdinalIgnoreCase);
+            foreach (var versionDirectory in Directory.GetDirectories(_storeDirectory)){
+                if (liveVersions.Contains(Path.GetFileName(versionDirectory))){
+                    continue;
+                }
+                try{
+                    var trashDirectory = versionDirectory;
+                    if (!versionDirectory.EndsWith(TrashSuffix, StringComparison.OrdinalIgnoreCase)){
+                        // Directory.Delete() would delete the files that aren't locked before 
+                        // giving up on a locked one, and GetCurrentVersion() would then hand out
+                        // the incomplete version. A directory that contains a locked file can't 
+                        // be renamed though, and once renamed it's never handed out again.
+                        trashDirectory = versionDirectory + TrashSuffix;
+                        if (Directory.Exists(trashDirectory)){
+                            Directory.Delete(trashDirectory, true);
+                        }
+                        Directory.Move(versionDirectory, trashDirectory);
+                    }
+                    Directory.Delete(trashDirectory, true);
+                } catch (IOException){
+                    // still loaded (perhaps by an app domain that hasn't finished unloading,
+                    // or by another editor instance), try again next time
+                } catch (UnauthorizedAccessException){
+                }
+            }
+        }
+
+        private string GetFileHash(string file){
+            var info = new FileInfo(file);
+            FileHash fileHash;
+            if (!_fileHashes.TryGetValue(file, out fileHash) || 
+                (fileHash.Length != info.Length) || (fileHash.LastWriteTimeUtc != info.LastWriteTimeUtc)){
+                fileHash.Length = info.Length;
+                fileHash.LastWriteTimeUtc = info.LastWriteTimeUtc;
+                fileHash.Hash = ComputeHash(File.ReadAllBytes(file));
+                _fileHashes[file] = fileHash;
+            }
+            return fileHash.Hash;
+        }
+
+        private static string ComputeHash(byte[] data){
+            using (var sha1 = SHA1.Create()){
+                // the first 8 bytes are plenty to tell the versions of a handful of files apart
+                return BitConverter.ToString(sha1.ComputeHash(data), 0, 8).Replace("-", "");
+            }
+        }
+    }
+}
@@ -0,0 +1,199 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Finds the members of the generated wrapper classes that are referenced by an assembly.
+    /// </summary>
+    /// <remarks>
+    /// The code generator can use the list of referenced members to only generate bindings for 
+    /// the wrapper class members that are actually used by the game scripts (see the 
+    /// TrimUnusedBindings setting in Klawr/Resources/Config.ini). Members are listed one per line 
+    /// as NativeClassName.MemberName, e.g. AActor.K2_GetActorLocation.
+    /// </remarks>
+    public static class BindingUsageScanner{
+        // opcodes indexed by their value, two byte opcodes all start with 0xFE
+        private static readonly OpCode[] _oneByteOpCodes = new OpCode[0x100];
+        private static readonly OpCode[] _twoByteOpCodes = new OpCode[0x100];
+
+        static BindingUsageScanner(){
+            foreach (var field in typeof(OpCodes).GetFields(BindingFlags.Public | BindingFlags.Static)){
+                var opCode = (OpCode)field.GetValue(null);
+                var value = (ushort)opCode.Value;
+                if (opCode.Size == 1){
+                    _oneByteOpCodes[value] = opCode;
+                } else{
+                    _twoByteOpCodes[value & 0xFF] = opCode;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Find all the members of the generated wrapper classes referenced by an assembly.
+        /// </summary>
+        /// <param name="assembly">Assembly to scan.</param>
+        /// <returns>Referenced members, formatted as NativeClassName.MemberName.</returns>
+        public static SortedSet<string> Scan(Assembly assembly){
+            var usedMembers = new SortedSet<string>(StringComparer.Ordinal);
+            const BindingFlags allDeclaredMembers = BindingFlags.Public | BindingFlags.NonPublic 
+                | BindingFlags.Instance | BindingFlags.Static | BindingFlags.DeclaredOnly;
+
+            foreach (var type in GetLoadableTypes(assembly)){
+                var methods = type.GetMethods(allDeclaredMembers).Cast<MethodBase>()
+                    .Concat(type.GetConstructors(allDeclaredMembers));
+                foreach (var method in methods){
+                    ScanMethod(method, usedMembers);
+                }
+            }
+            return usedMembers;
+        }
+
+        /// <summary>
+        /// Find all the members of the generated wrapper classes referenced by an assembly and 
+        /// write them to a file.
+        /// </summary>
+        /// <param name="assembly">Assembly to scan.</param>
+        /// <param name="usageFilename">File to write the referenced members to, it will be 
+        /// overwritten if it already exists.</param>
+        /// <returns>true if the file was written successfully, false otherwise</returns>
+        public static bool WriteUsageFile(Assembly assembly, string usageFilename){
+            try{
+                var usedMembers = Scan(assembly);
+                Directory.CreateDirectory(Path.GetDirectoryName(usageFilename));
+                File.WriteAllLines(usageFilename, usedMembers);
+                LogUtils.Log(String.Format(
+                    "Found {0} wrapper members referenced by {1}.", usedMembers.Count, assembly.GetName().Name
+                ));
+                return true;
+            } catch (Exception except){
+                LogUtils.LogError(except.ToString());
+                return false;
+            }
+        }
+
+        private static IEnumerable<Type> GetLoadableTypes(Assembly assembly){
+            try{
+                return assembly.GetTypes();
+            } catch (ReflectionTypeLoadException except){
+                return except.Types.Where(type => type != null);
+            }
+        }
+
+        private static void ScanMethod(MethodBase method, ISet<string> usedMembers){
+            var body = method.GetMethodBody();
+            if (body == null){
+                return;
+            }
+            var il = body.GetILAsByteArray();
+            var module = method.Module;
+            var typeArgs = method.DeclaringType.IsGenericType ? method.DeclaringType.GetGenericArguments() : null;
+            var methodArgs = method.IsGenericMethod ? method.GetGenericArguments() : null;
+
+            var offset = 0;
+            while (offset < il.Length){
+                OpCode opCode;
+                var value = il[offset++];
+                if ((value == 0xFE) && (offset < il.Length)){
+                    opCode = _twoByteOpCodes[il[offset++]];
+                } else{
+                    opCode = _oneByteOpCodes[value];
+                }
+
+                switch (opCode.OperandType){
+                    case OperandType.InlineMethod:
+                    case OperandType.InlineField:
+                    case OperandType.InlineTok:
+                        var token = BitConverter.ToInt32(il, offset);
+                        AddMember(ResolveMember(module, token, typeArgs, methodArgs), usedMembers);
+                        break;
+                }
+                offset += GetOperandSize(opCode.OperandType, il, offset);
+            }
+        }
+
+        private static MemberInfo ResolveMember(Module module, int token, Type[] typeArgs, Type[] methodArgs){
+            try{
+                return module.ResolveMember(token, typeArgs, methodArgs);
+            } catch (ArgumentException){
+                // the token refers to something that can't be resolved in this context (e.g. a 
+                // member of an open generic type), none of the wrapper classes are generic
+                return null;
+            }
+        }
+
+        private static void AddMember(MemberInfo member, ISet<string> usedMembers){
+            var declaringType = member?.DeclaringType;
+            if ((declaringType == null) 
+                || (declaringType.Assembly.GetName().Name != GlobalStrings.KlawrUnrealEngineNamespace)){
+                return;
+            }
+
+            var memberName = member.Name;
+            var method = member as MethodBase;
+            if ((method != null) && method.IsSpecialName){
+                if (method.IsConstructor){
+                    return;
+                }
+                // property accessors are bound to the getter/setter of a native property
+                if (memberName.StartsWith("get_") || memberName.StartsWith("set_")){
+                    memberName = memberName.Substring(4);
+                } else if (memberName.StartsWith("add_")){
+                    // event accessors are bound to a native multicast delegate property
+                    memberName = memberName.Substring(4);
+                } else if (memberName.StartsWith("remove_")){
+                    memberName = memberName.Substring(7);
+                }
+            }
+            usedMembers.Add(declaringType.Name + "." + memberName);
+        }
+
+        private static int GetOperandSize(OperandType operandType, byte[] il, int offset){
+            switch (operandType){
+                case OperandType.InlineNone:
+                    return 0;
+                case OperandType.ShortInlineBrTarget:
+                case OperandType.ShortInlineI:
+                case OperandType.ShortInlineVar:
+                    return 1;
+                case OperandType.InlineVar:
+                    return 2;
+                case OperandType.InlineI8:
+                case OperandType.InlineR:
+                    return 8;
+                case OperandType.InlineSwitch:
+                    // the number of targets followed by the targets
+                    return 4 + (BitConverter.ToInt32(il, offset) * 4);
+                default:
+                    return 4;
+            }
+        }
+    }
+}
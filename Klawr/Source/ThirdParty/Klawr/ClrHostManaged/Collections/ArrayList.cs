@@ -34,6 +34,11 @@ namespace Klawr.ClrHost.Managed.Collections{
     /// </summary>
     /// <typeparam name="T">Any interoperable type.</typeparam>
     public class ArrayList<T> : IList<T>, IReadOnlyList<T>, IDisposable{
+        /// <summary>
+        /// Number of elements an enumerator copies from the native array at a time.
+        /// </summary>
+        public const int EnumeratorChunkSize = 64;
+
         private bool _isDisposed = false;
         private INativeArray<T> _nativeArray;
         // tracks how many times the array has been modified, 
@@ -41,6 +46,9 @@ namespace Klawr.ClrHost.Managed.Collections{
         // enumerating it (which isn't allowed)... of course this won't do much good if
         // native code modifies the array
         private int _modificationCount;
+        // chunk buffer for enumerators, it's handed out to one enumerator at a time so that
+        // repeated enumeration of the same array doesn't allocate a new buffer every time
+        private T[] _enumeratorChunk;
 
         #region Properties
         public int Count { get { return _nativeArray.Num(); } }
@@ -77,7 +85,7 @@ namespace Klawr.ClrHost.Managed.Collections{
         }
 
         public bool Contains(T item){
-            return _nativeArray.Find(item) != -1;
+            return _nativeArray.Contains(item);
         }
 
         public void CopyTo(T[] array, int arrayIndex){
@@ -93,14 +101,11 @@ namespace Klawr.ClrHost.Managed.Collections{
                 throw new ArgumentException("array is too small!");
             }
 
-            var currentIndex = arrayIndex;
-            foreach (T item in this){
-                if (currentIndex < array.Length){
-                    array[currentIndex++] = item;
-                } else{
-                    break;
-                }
-            }
+            _nativeArray.ReadRange(0, array, arrayIndex, Count);
+        }
+
+        public Enumerator GetEnumerator(){
+            return new Enumerator(this);
         }
 
         IEnumerator<T> IEnumerable<T>.GetEnumerator(){
@@ -148,6 +153,22 @@ namespace Klawr.ClrHost.Managed.Collections{
             Dispose(true);
         }
 
+        private T[] RentEnumeratorChunk(){
+            var chunk = _enumeratorChunk;
+            if (chunk != null){
+                _enumeratorChunk = null;
+                return chunk;
+            }
+            // the shared chunk is already in use by another enumerator
+            return new T[EnumeratorChunkSize];
+        }
+
+        private void ReturnEnumeratorChunk(T[] chunk){
+            // don't keep any wrapped objects alive longer than necessary
+            Array.Clear(chunk, 0, chunk.Length);
+            _enumeratorChunk = chunk;
+        }
+
         public override string ToString(){
             var stringBuilder = new StringBuilder();
             int itemIndex = 0;
@@ -164,16 +185,31 @@ namespace Klawr.ClrHost.Managed.Collections{
         }
         #endregion
 
-        private class Enumerator : IEnumerator<T>, IEnumerator{
-            private ArrayList<T> _arrayList;
+        /// <summary>
+        /// Enumerates the elements of an ArrayList.
+        /// </summary>
+        /// <remarks>Elements are copied out of the native array in chunks of 
+        /// EnumeratorChunkSize elements, so enumerating an array takes one native call per chunk
+        /// rather than one per element. Since this is a struct, using it directly (e.g. via
+        /// foreach) doesn't allocate anything on the managed heap.</remarks>
+        public struct Enumerator : IEnumerator<T>, IEnumerator{
+            private readonly ArrayList<T> _arrayList;
+            private readonly int _modificationCount;
+            // holds the elements copied from the native array,
+            // the first element in the chunk is at _chunkStart in the native array
+            private T[] _chunk;
+            private int _chunkStart;
+            private int _chunkLength;
             private int _index;
-            private int _modificationCount;
             private T _current;
 
             internal Enumerator(ArrayList<T> arrayList){
                 _arrayList = arrayList;
-                _index = 0;
                 _modificationCount = arrayList._modificationCount;
+                _chunk = null;
+                _chunkStart = 0;
+                _chunkLength = 0;
+                _index = 0;
                 _current = default(T);
             }
 
@@ -181,15 +217,20 @@ namespace Klawr.ClrHost.Managed.Collections{
             object IEnumerator.Current { get { return _current; } }
 
             public bool MoveNext(){
-                if (_modificationCount == _arrayList._modificationCount){
-                    if (_index < _arrayList.Count){
-                        _current = _arrayList[_index++];
-                        return true;
+                if (_modificationCount != _arrayList._modificationCount){
+                    throw new InvalidOperationException("Enumerator has been invalidated!");
+                }
+                var chunkOffset = _index - _chunkStart;
+                if (chunkOffset >= _chunkLength){
+                    if (!FetchChunk()){
+                        _current = default(T);
+                        return false;
                     }
-                    _current = default(T);
-                    return false;
+                    chunkOffset = 0;
                 }
-                throw new InvalidOperationException("Enumerator has been invalidated!");
+                _current = _chunk[chunkOffset];
+                ++_index;
+                return true;
             }
 
             public void Reset(){
@@ -197,7 +238,31 @@ namespace Klawr.ClrHost.Managed.Collections{
                 throw new NotImplementedException();
             }
 
-            public void Dispose(){}
+            public void Dispose(){
+                if (_chunk != null){
+                    _arrayList.ReturnEnumeratorChunk(_chunk);
+                    _chunk = null;
+                }
+                _chunkLength = 0;
+            }
+
+            /// <summary>
+            /// Copy the next chunk of elements from the native array.
+            /// </summary>
+            /// <returns>false if there are no more elements to enumerate, true otherwise</returns>
+            private bool FetchChunk(){
+                _chunkStart = _index;
+                _chunkLength = Math.Min(_arrayList.Count - _index, EnumeratorChunkSize);
+                if (_chunkLength <= 0){
+                    _chunkLength = 0;
+                    return false;
+                }
+                if (_chunk == null){
+                    _chunk = _arrayList.RentEnumeratorChunk();
+                }
+                _arrayList._nativeArray.ReadRange(_index, _chunk, 0, _chunkLength);
+                return true;
+            }
         }
     }
 }
\ No newline at end of file
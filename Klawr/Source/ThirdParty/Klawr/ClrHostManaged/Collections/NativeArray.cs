@@ -35,6 +35,8 @@ namespace Klawr.ClrHost.Managed.Collections{
         void Add(T item);
         void Reset(int newCapacity = 0);
         int Find(T item);
+        bool Contains(T item);
+        void ReadRange(int index, T[] buffer, int bufferIndex, int count);
         void Insert(T item, int index);
         bool RemoveSingle(T item);
         void RemoveAt(int index);
@@ -81,6 +83,47 @@ namespace Klawr.ClrHost.Managed.Collections{
             ArrayUtils.Reset(NativeArrayHandle, newCapacity);
         }
 
+        public bool Contains(T item){
+            return Find(item) != -1;
+        }
+
+        /// <summary>
+        /// Copy a range of elements from the native array into a managed buffer.
+        /// </summary>
+        /// <remarks>The default implementation reads the elements one at a time, derived classes
+        /// whose elements can be read directly from native memory override this to copy the
+        /// whole range at once.</remarks>
+        /// <param name="index">Index of the first element to copy.</param>
+        /// <param name="buffer">Buffer to copy the elements into.</param>
+        /// <param name="bufferIndex">Index in the buffer at which to store the first element.</param>
+        /// <param name="count">Number of elements to copy.</param>
+        public virtual void ReadRange(int index, T[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            for (int i = 0; i < count; ++i){
+                buffer[bufferIndex + i] = GetValue(index + i);
+            }
+        }
+
+        /// <summary>
+        /// Check that a range of elements lies within both the native array and the given buffer.
+        /// </summary>
+        /// <remarks>The bulk copies done by ReadRange() and WriteRange() read and write native 
+        /// memory directly, so the range must be validated up front.</remarks>
+        protected void ValidateRange(int index, T[] buffer, int bufferIndex, int count){
+            if (buffer == null){
+                throw new ArgumentNullException(nameof(buffer));
+            }
+            if (count < 0){
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+            if ((bufferIndex < 0) || ((buffer.Length - bufferIndex) < count)){
+                throw new ArgumentOutOfRangeException(nameof(bufferIndex));
+            }
+            if ((index < 0) || ((Num() - index) < count)){
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+        }
+
         public void Insert(T item, int index){
             ArrayUtils.Insert(NativeArrayHandle, index);
             SetValue(index, item);
@@ -136,6 +179,34 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(bool item){
             return ArrayUtils.FindUInt8(NativeArrayHandle, Convert.ToByte(item));
         }
+
+        /// <summary>
+        /// Count the number of elements equal to the given item.
+        /// </summary>
+        public int Count(bool item){
+            return ArrayUtils.CountUInt8(NativeArrayHandle, Convert.ToByte(item));
+        }
+
+        /// <summary>
+        /// Find the index of the first element equal to any of the given items.
+        /// </summary>
+        /// <returns>Index of the first matching element, or -1 if there are no matches.</returns>
+        public int FindAny(params bool[] items){
+            if (items == null){
+                throw new ArgumentNullException(nameof(items));
+            }
+            return ArrayUtils.FindAnyUInt8(NativeArrayHandle, Array.ConvertAll(items, item => Convert.ToByte(item)));
+        }
+
+        public override void ReadRange(int index, bool[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count > 0){
+                var rawPtr = ArrayUtils.GetRawPtr(NativeArrayHandle, index);
+                for (int i = 0; i < count; ++i){
+                    buffer[bufferIndex + i] = Marshal.ReadByte(rawPtr, i) != 0;
+                }
+            }
+        }
     }
 
     /// <summary>
@@ -156,6 +227,33 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(byte item){
             return ArrayUtils.FindUInt8(NativeArrayHandle, item);
         }
+
+        /// <summary>
+        /// Count the number of elements equal to the given item.
+        /// </summary>
+        public int Count(byte item){
+            return ArrayUtils.CountUInt8(NativeArrayHandle, item);
+        }
+
+        /// <summary>
+        /// Find the index of the first element equal to any of the given items.
+        /// </summary>
+        /// <returns>Index of the first matching element, or -1 if there are no matches.</returns>
+        public int FindAny(params byte[] items){
+            if (items == null){
+                throw new ArgumentNullException(nameof(items));
+            }
+            return ArrayUtils.FindAnyUInt8(NativeArrayHandle, items);
+        }
+
+        public override void ReadRange(int index, byte[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count > 0){
+                Marshal.Copy(
+                    ArrayUtils.GetRawPtr(NativeArrayHandle, index), buffer, bufferIndex, count
+                );
+            }
+        }
     }
 
     /// <summary>
@@ -176,6 +274,33 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(Int16 item){
             return ArrayUtils.FindInt16(NativeArrayHandle, item);
         }
+
+        /// <summary>
+        /// Count the number of elements equal to the given item.
+        /// </summary>
+        public int Count(Int16 item){
+            return ArrayUtils.CountInt16(NativeArrayHandle, item);
+        }
+
+        /// <summary>
+        /// Find the index of the first element equal to any of the given items.
+        /// </summary>
+        /// <returns>Index of the first matching element, or -1 if there are no matches.</returns>
+        public int FindAny(params Int16[] items){
+            if (items == null){
+                throw new ArgumentNullException(nameof(items));
+            }
+            return ArrayUtils.FindAnyInt16(NativeArrayHandle, items);
+        }
+
+        public override void ReadRange(int index, Int16[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count > 0){
+                Marshal.Copy(
+                    ArrayUtils.GetRawPtr(NativeArrayHandle, index), buffer, bufferIndex, count
+                );
+            }
+        }
     }
 
     /// <summary>
@@ -196,6 +321,33 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(Int32 item){
             return ArrayUtils.FindInt32(NativeArrayHandle, item);
         }
+
+        /// <summary>
+        /// Count the number of elements equal to the given item.
+        /// </summary>
+        public int Count(Int32 item){
+            return ArrayUtils.CountInt32(NativeArrayHandle, item);
+        }
+
+        /// <summary>
+        /// Find the index of the first element equal to any of the given items.
+        /// </summary>
+        /// <returns>Index of the first matching element, or -1 if there are no matches.</returns>
+        public int FindAny(params Int32[] items){
+            if (items == null){
+                throw new ArgumentNullException(nameof(items));
+            }
+            return ArrayUtils.FindAnyInt32(NativeArrayHandle, items);
+        }
+
+        public override void ReadRange(int index, Int32[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count > 0){
+                Marshal.Copy(
+                    ArrayUtils.GetRawPtr(NativeArrayHandle, index), buffer, bufferIndex, count
+                );
+            }
+        }
     }
 
     /// <summary>
@@ -216,6 +368,33 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(Int64 item){
             return ArrayUtils.FindInt64(NativeArrayHandle, item);
         }
+
+        /// <summary>
+        /// Count the number of elements equal to the given item.
+        /// </summary>
+        public int Count(Int64 item){
+            return ArrayUtils.CountInt64(NativeArrayHandle, item);
+        }
+
+        /// <summary>
+        /// Find the index of the first element equal to any of the given items.
+        /// </summary>
+        /// <returns>Index of the first matching element, or -1 if there are no matches.</returns>
+        public int FindAny(params Int64[] items){
+            if (items == null){
+                throw new ArgumentNullException(nameof(items));
+            }
+            return ArrayUtils.FindAnyInt64(NativeArrayHandle, items);
+        }
+
+        public override void ReadRange(int index, Int64[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count > 0){
+                Marshal.Copy(
+                    ArrayUtils.GetRawPtr(NativeArrayHandle, index), buffer, bufferIndex, count
+                );
+            }
+        }
     }
 
     /// <summary>
@@ -236,6 +415,19 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(string item){
             return ArrayUtils.FindString(NativeArrayHandle, item);
         }
+
+        public override void ReadRange(int index, string[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count == 0){
+                return;
+            }
+            // the native strings are copied before anything gets a chance to modify the array
+            var nativeStrings = new IntPtr[count];
+            ArrayUtils.GetStrings(NativeArrayHandle, index, nativeStrings, count);
+            for (int i = 0; i < count; ++i){
+                buffer[bufferIndex + i] = Marshal.PtrToStringUni(nativeStrings[i]);
+            }
+        }
     }
 
     /// <summary>
@@ -256,6 +448,20 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(FScriptName item){
             return ArrayUtils.FindName(NativeArrayHandle, item);
         }
+
+        public override void ReadRange(int index, FScriptName[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count == 0){
+                return;
+            }
+            if (bufferIndex == 0){
+                ArrayUtils.GetNames(NativeArrayHandle, index, buffer, count);
+            } else{
+                var names = new FScriptName[count];
+                ArrayUtils.GetNames(NativeArrayHandle, index, names, count);
+                Array.Copy(names, 0, buffer, bufferIndex, count);
+            }
+        }
     }
 
     /// <summary>
@@ -276,5 +482,148 @@ namespace Klawr.ClrHost.Managed.Collections{
         public override int Find(T item){
             return ArrayUtils.FindObject(NativeArrayHandle, item.NativeObject);
         }
+
+        public override void ReadRange(int index, T[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if (count == 0){
+                return;
+            }
+            var nativeObjects = new IntPtr[count];
+            ArrayUtils.GetObjects(NativeArrayHandle, index, nativeObjects, count);
+            // every object now has a reference that must be released, so all of them are wrapped
+            // in handles before anything can throw
+            var handles = new UObjectHandle[count];
+            for (int i = 0; i < count; ++i){
+                handles[i] = new UObjectHandle(nativeObjects[i], true);
+            }
+            for (int i = 0; i < count; ++i){
+                buffer[bufferIndex + i] = (T)Activator.CreateInstance(typeof(T), handles[i]);
+            }
+        }
+    }
+
+    /// <summary>
+    /// A wrapper for a native UE <![CDATA[ TArray<T> ]]> that is a member of a native UObject 
+    /// derived class, where T is a USTRUCT whose managed counterpart has a sequential layout
+    /// (e.g. FVector, FTransform, or any of the generated struct wrappers).
+    /// </summary>
+    /// <remarks>Elements are read and written directly from/to the memory of the native array,
+    /// so T must be blittable and the native struct must not own any memory (the code generator
+    /// only wraps such arrays with this class). ReadRange() and WriteRange() copy a whole range of
+    /// elements at once when the native struct is plain old data, that's much faster than
+    /// accessing large arrays one element at a time.</remarks>
+    public class StructArrayProperty<T> : NativeArrayPropertyBase<T> where T : struct{
+        private static readonly int _elementSize = Marshal.SizeOf(typeof(T));
+        private static readonly bool _isBlittable = IsBlittable();
+
+        /// <exception cref="InvalidOperationException">T isn't blittable, its layout doesn't match
+        /// the native struct (see StructLayoutVerifier), or its size doesn't match the size of the
+        /// native array elements.</exception>
+        public StructArrayProperty(UObjectHandle objectHandle, ArrayHandle arrayHandle) : base(objectHandle, arrayHandle){
+            var structType = typeof(T);
+            if (!_isBlittable){
+                Dispose();
+                throw new InvalidOperationException(String.Format(
+                    "{0} isn't blittable so its elements can't be copied to/from the native array!",
+                    structType.Name
+                ));
+            }
+            if (structType.IsExplicitLayout && !StructLayoutVerifier.IsVerified(structType)){
+                // copying elements anyway would scribble over the wrong bytes of the native structs
+                Dispose();
+                throw new InvalidOperationException(String.Format(
+                    "The layout of {0} doesn't match the native struct. Regenerate the wrappers.",
+                    structType.Name
+                ));
+            }
+            var nativeElementSize = ArrayUtils.GetElementSize(arrayHandle);
+            if (nativeElementSize != _elementSize){
+                Dispose();
+                throw new InvalidOperationException(String.Format(
+                    "{0} is {1} bytes but the native array element is {2} bytes!",
+                    typeof(T).Name, _elementSize, nativeElementSize
+                ));
+            }
+        }
+
+        protected override T GetValue(int index){
+            return (T)Marshal.PtrToStructure(ArrayUtils.GetRawPtr(NativeArrayHandle, index), typeof(T));
+        }
+
+        protected override void SetValue(int index, T item){
+            Marshal.StructureToPtr(item, ArrayUtils.GetRawPtr(NativeArrayHandle, index), false);
+        }
+
+        public override int Find(T item){
+            var itemPtr = Marshal.AllocHGlobal(_elementSize);
+            try{
+                Marshal.StructureToPtr(item, itemPtr, false);
+                return ArrayUtils.Find(NativeArrayHandle, itemPtr);
+            } finally{
+                Marshal.FreeHGlobal(itemPtr);
+            }
+        }
+
+        public override void ReadRange(int index, T[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if ((count == 0) || CopyRange(index, buffer, bufferIndex, count, false)){
+                return;
+            }
+            var rawPtr = ArrayUtils.GetRawPtr(NativeArrayHandle, index);
+            for (int i = 0; i < count; ++i){
+                buffer[bufferIndex + i] = (T)Marshal.PtrToStructure(
+                    IntPtr.Add(rawPtr, i * _elementSize), typeof(T)
+                );
+            }
+        }
+
+        /// <summary>
+        /// Overwrite a range of elements in the native array with elements from a managed buffer.
+        /// </summary>
+        /// <remarks>The native array must already contain all the elements that will be 
+        /// overwritten, this method doesn't grow the array.</remarks>
+        /// <param name="index">Index of the first element to overwrite.</param>
+        /// <param name="buffer">Buffer to copy the elements from.</param>
+        /// <param name="bufferIndex">Index of the first element in the buffer to copy.</param>
+        /// <param name="count">Number of elements to copy.</param>
+        public void WriteRange(int index, T[] buffer, int bufferIndex, int count){
+            ValidateRange(index, buffer, bufferIndex, count);
+            if ((count == 0) || CopyRange(index, buffer, bufferIndex, count, true)){
+                return;
+            }
+            var rawPtr = ArrayUtils.GetRawPtr(NativeArrayHandle, index);
+            for (int i = 0; i < count; ++i){
+                Marshal.StructureToPtr(
+                    buffer[bufferIndex + i], IntPtr.Add(rawPtr, i * _elementSize), false
+                );
+            }
+        }
+
+        /// <summary>
+        /// Copy a range of elements between the native array and a pinned managed buffer.
+        /// </summary>
+        /// <returns>false if the native elements can't be bulk copied, true otherwise</returns>
+        private bool CopyRange(int index, T[] buffer, int bufferIndex, int count, bool toNative){
+            var bufferHandle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+            try{
+                var bufferPtr = IntPtr.Add(bufferHandle.AddrOfPinnedObject(), bufferIndex * _elementSize);
+                if (toNative){
+                    return ArrayUtils.CopyFromBuffer(NativeArrayHandle, index, bufferPtr, count);
+                }
+                return ArrayUtils.CopyToBuffer(NativeArrayHandle, index, bufferPtr, count);
+            } finally{
+                bufferHandle.Free();
+            }
+        }
+
+        private static bool IsBlittable(){
+            // the runtime refuses to pin arrays of non-blittable types
+            try{
+                GCHandle.Alloc(new T[1], GCHandleType.Pinned).Free();
+                return true;
+            } catch (ArgumentException){
+                return false;
+            }
+        }
     }
 }
\ No newline at end of file
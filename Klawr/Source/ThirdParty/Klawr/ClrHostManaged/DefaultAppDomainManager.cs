@@ -33,7 +33,12 @@ namespace Klawr.ClrHost.Managed{
     /// Default app domain manager.
     /// </summary>
     public sealed class DefaultAppDomainManager : AppDomainManager, IDefaultAppDomainManager{
+        // subdirectory of the engine app domain application base to store assemblies in
+        private const string AssemblyStoreDirectory = "AssemblyStore";
+
         private readonly Dictionary<DomainId, AppDomain> engineAppDomains = new Dictionary<DomainId, AppDomain>();
+        // copies of the game scripts assemblies loaded by the engine app domains
+        private AssemblyStore assemblyStore;
 
         // NOTE: the base implementation of this method does nothing, so no need to call it
         public override void InitializeNewDomain(AppDomainSetup appDomainInfo){
@@ -53,24 +58,36 @@ namespace Klawr.ClrHost.Managed{
                                   ),
                 // semi-colon delimited list of subdirectories of ApplicationBase where private 
                 // assemblies can be loaded from
-                PrivateBinPath = "Assemblies;ShadowCopy",
+                PrivateBinPath = "Assemblies",
                 // only load private assemblies from PrivateBinPath, not ApplicationBase
-                PrivateBinPathProbe = String.Empty,
-                ShadowCopyFiles = "true"
+                PrivateBinPathProbe = String.Empty
             };
-            // semi-colon delimited list of absolute paths to directories containing assemblies that
-            // should be shadow copied (directories can be outside ApplicationBase)
-            setup.ShadowCopyDirectories = Path.Combine(setup.ApplicationBase, "ShadowCopy");
-            // directory where shadow copies of assemblies should be stored 
-            // (can be outside ApplicationBase)
-            setup.CachePath = Path.Combine(setup.ApplicationBase, "Cache");
 
             int domainId = 0;
             try{
+                // the game scripts are built into the ShadowCopy directory, which must not be 
+                // locked, so they're loaded from a copy in the assembly store instead (this used
+                // to be done by the CLR shadow copying, which copied the assemblies for every
+                // app domain even if they hadn't changed)
+                if (assemblyStore == null){
+                    assemblyStore = new AssemblyStore(
+                        Path.Combine(setup.ApplicationBase, "ShadowCopy"),
+                        Path.Combine(setup.ApplicationBase, AssemblyStoreDirectory)
+                    );
+                }
+                var assembliesVersion = assemblyStore.GetCurrentVersion();
+                if (assembliesVersion != null){
+                    setup.PrivateBinPath += ";" + Path.Combine(AssemblyStoreDirectory, assembliesVersion);
+                }
+
                 // this will instantiate a new app domain manager and call InitializeNewDomain()
                 var engineAppDomain = AppDomain.CreateDomain("EngineDomain", null, setup);
                 domainId = engineAppDomain.Id;
                 engineAppDomains.Add(domainId, engineAppDomain);
+                if (assembliesVersion != null){
+                    assemblyStore.AddDomain(domainId, assembliesVersion);
+                }
+                assemblyStore.CollectGarbage();
             } catch (Exception except){
                 Console.WriteLine(except.ToString());
             }
@@ -85,6 +102,10 @@ namespace Klawr.ClrHost.Managed{
             try{
                 engineAppDomains.Remove(domainId);
                 AppDomain.Unload(appDomain);
+                if (assemblyStore != null){
+                    assemblyStore.RemoveDomain(domainId);
+                    assemblyStore.CollectGarbage();
+                }
                 return true;
             } catch (AppDomainUnloadedException){
                 // ho hum, log an error maybe?
@@ -101,6 +122,7 @@ namespace Klawr.ClrHost.Managed{
                 }
             }
             engineAppDomains.Clear();
+            // the current version of the assemblies is kept so the next session can reuse it
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,187 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Security;
+using System.Text;
+
+namespace Klawr.ClrHost.Managed.Diagnostics{
+    /// <summary>
+    /// Measures the per-call cost of the different ways generated wrappers can call native code.
+    /// </summary>
+    /// <remarks>
+    /// The native functions called are trivial C runtime functions with the same shape as the 
+    /// generated native wrappers (a pointer followed by a few arguments), so the measured time is
+    /// almost entirely the cost of the managed/native transition.
+    /// </remarks>
+    public static class InteropBenchmark{
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate IntPtr GetterFunc(IntPtr self);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void SetterAction(IntPtr self, int value, IntPtr count);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate int FourArgFunc(IntPtr self, IntPtr size, IntPtr source, IntPtr count);
+
+        [SuppressUnmanagedCodeSecurity]
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate IntPtr UncheckedGetterFunc(IntPtr self);
+
+        [SuppressUnmanagedCodeSecurity]
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void UncheckedSetterAction(IntPtr self, int value, IntPtr count);
+
+        [SuppressUnmanagedCodeSecurity]
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate int UncheckedFourArgFunc(IntPtr self, IntPtr size, IntPtr source, IntPtr count);
+
+        [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+        private static extern IntPtr LoadLibrary(string fileName);
+
+        [DllImport("kernel32.dll", CharSet = CharSet.Ansi, SetLastError = true)]
+        private static extern IntPtr GetProcAddress(IntPtr module, string procName);
+
+        /// <summary>
+        /// Run the benchmark and print the results to the UE console and log file.
+        /// </summary>
+        /// <param name="iterations">Number of calls to make with each binding.</param>
+        /// <returns>The results.</returns>
+        public static string Run(int iterations = 1000000){
+            var crt = LoadLibrary("msvcrt.dll");
+            var getterPtr = GetProcAddress(crt, "strlen");
+            var setterPtr = GetProcAddress(crt, "memset");
+            var fourArgPtr = GetProcAddress(crt, "memcpy_s");
+            if ((getterPtr == IntPtr.Zero) || (setterPtr == IntPtr.Zero) || (fourArgPtr == IntPtr.Zero)){
+                throw new InvalidOperationException("Failed to find the C runtime functions to benchmark.");
+            }
+
+            var buffer = Marshal.AllocHGlobal(16);
+            try{
+                Marshal.WriteInt64(buffer, 0);
+                var report = new StringBuilder();
+                report.AppendFormat("Interop benchmark, average cost per call over {0} calls:", iterations);
+                report.AppendLine();
+
+                report.AppendLine(Measure("getter", "marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(getterPtr, typeof(GetterFunc)) as GetterFunc));
+                report.AppendLine(Measure("getter", "unchecked marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(getterPtr, typeof(UncheckedGetterFunc)) as UncheckedGetterFunc));
+                report.AppendLine(Measure("getter", "calli stub", iterations, buffer,
+                    NativeCalli.Bind<GetterFunc>(getterPtr)));
+
+                report.AppendLine(Measure("setter", "marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(setterPtr, typeof(SetterAction)) as SetterAction));
+                report.AppendLine(Measure("setter", "unchecked marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(setterPtr, typeof(UncheckedSetterAction)) as UncheckedSetterAction));
+                report.AppendLine(Measure("setter", "calli stub", iterations, buffer,
+                    NativeCalli.Bind<SetterAction>(setterPtr)));
+
+                report.AppendLine(Measure("4-arg function", "marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(fourArgPtr, typeof(FourArgFunc)) as FourArgFunc));
+                report.AppendLine(Measure("4-arg function", "unchecked marshaling delegate", iterations, buffer,
+                    Marshal.GetDelegateForFunctionPointer(fourArgPtr, typeof(UncheckedFourArgFunc)) as UncheckedFourArgFunc));
+                report.AppendLine(Measure("4-arg function", "calli stub", iterations, buffer,
+                    NativeCalli.Bind<FourArgFunc>(fourArgPtr)));
+
+                var results = report.ToString();
+                LogUtils.Display(results);
+                return results;
+            } finally{
+                Marshal.FreeHGlobal(buffer);
+            }
+        }
+
+        /// <summary>
+        /// Measure how long it takes to run the static constructors of all the wrapper classes in 
+        /// an assembly, and how much time has been spent binding wrapper delegates to native 
+        /// functions so far, then print the results to the UE console and log file.
+        /// </summary>
+        /// <remarks>
+        /// Delegates are bound the first time they're used, so running the static constructors 
+        /// should be cheap, and the binding time should only grow with the number of distinct 
+        /// wrapper functions that have actually been called.
+        /// </remarks>
+        /// <param name="wrapperAssembly">Assembly containing generated wrapper classes.</param>
+        /// <returns>The results.</returns>
+        public static string MeasureStartup(Assembly wrapperAssembly){
+            var numTypes = 0;
+            var stopwatch = Stopwatch.StartNew();
+            foreach (var type in wrapperAssembly.GetTypes()){
+                if (!type.IsGenericTypeDefinition){
+                    RuntimeHelpers.RunClassConstructor(type.TypeHandle);
+                    ++numTypes;
+                }
+            }
+            stopwatch.Stop();
+
+            var report = new StringBuilder();
+            report.AppendFormat(
+                "Ran static constructors of {0} types in {1} in {2:F2} ms", 
+                numTypes, wrapperAssembly.GetName().Name, stopwatch.Elapsed.TotalMilliseconds
+            );
+            report.AppendLine();
+            report.AppendFormat(
+                "Bound {0} wrapper functions in {1:F2} ms", 
+                NativeFunctionBinder.NumBoundFunctions, NativeFunctionBinder.BindingTime.TotalMilliseconds
+            );
+            report.AppendLine();
+
+            var results = report.ToString();
+            LogUtils.Display(results);
+            return results;
+        }
+
+        private static string Measure(string callKind, string bindingKind, int iterations, IntPtr buffer, Delegate binding){
+            Action<int> loop;
+            var size = new IntPtr(16);
+            if (binding is GetterFunc getter){
+                loop = n => { for (int i = 0; i < n; ++i){ getter(buffer); } };
+            } else if (binding is UncheckedGetterFunc uncheckedGetter){
+                loop = n => { for (int i = 0; i < n; ++i){ uncheckedGetter(buffer); } };
+            } else if (binding is SetterAction setter){
+                loop = n => { for (int i = 0; i < n; ++i){ setter(buffer, i, IntPtr.Zero); } };
+            } else if (binding is UncheckedSetterAction uncheckedSetter){
+                loop = n => { for (int i = 0; i < n; ++i){ uncheckedSetter(buffer, i, IntPtr.Zero); } };
+            } else if (binding is FourArgFunc fourArg){
+                loop = n => { for (int i = 0; i < n; ++i){ fourArg(buffer, size, buffer, IntPtr.Zero); } };
+            } else{
+                var uncheckedFourArg = (UncheckedFourArgFunc)binding;
+                loop = n => { for (int i = 0; i < n; ++i){ uncheckedFourArg(buffer, size, buffer, IntPtr.Zero); } };
+            }
+
+            // warm up so the JIT and stub generation costs aren't included
+            loop(1000);
+            var stopwatch = Stopwatch.StartNew();
+            loop(iterations);
+            stopwatch.Stop();
+            var nanosecondsPerCall = stopwatch.Elapsed.TotalMilliseconds * 1000000.0 / iterations;
+            return String.Format("  {0,-15} {1,-30} {2,8:F1} ns", callKind, bindingKind, nanosecondsPerCall);
+        }
+    }
+}
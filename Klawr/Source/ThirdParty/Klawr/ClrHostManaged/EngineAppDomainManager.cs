@@ -76,8 +76,6 @@ namespace Klawr.ClrHost.Managed{
             public ScriptComponentMethodInfo[] Methods;
         }
 
-        // only set for the engine app domain manager
-        private Dictionary<NativClass, IntPtr[]> _nativeFunctionPointers = new Dictionary<string, IntPtr[]>();
         // all currently registered script objects
         private Dictionary<InstanceId, ScriptObjectInfo> _scriptObjects = new Dictionary<long, ScriptObjectInfo>();
         // identifier of the most recently registered ScriptObject instance
@@ -90,6 +88,8 @@ namespace Klawr.ClrHost.Managed{
         private Dictionary<long /*Instance ID*/, ScriptComponentInfo> _scriptComponents = new Dictionary<long, ScriptComponentInfo>();
         // cache of previously created script component types
         private Dictionary<string /*Full Type Name*/, ScriptComponentTypeInfo> _scriptComponentTypeCache = new Dictionary<string, ScriptComponentTypeInfo>();
+        // the generated UKlawrScriptComponent wrapper class, looked up on first use
+        private Type _scriptComponentBaseType;
 
         // NOTE: the base implementation of this method does nothing, so no need to call it
         public override void InitializeNewDomain(AppDomainSetup appDomainInfo){
@@ -97,19 +97,10 @@ namespace Klawr.ClrHost.Managed{
             InitializationFlags = AppDomainManagerInitializationOptions.RegisterWithHost;
         }
 
-        public void SetNativeFunctionPointers(string nativeClassName, long[] functionPointers){
-            // the function pointers are passed in as long to avoid pointer truncation on a 
-            // 64-bit platform when this method is called via COM, but to actually use them
-            // they need to be converted to IntPtr
-            var unboxedFunctionPointers = new IntPtr[functionPointers.Length];
-            for (var i = 0; i < functionPointers.Length; ++i){
-                unboxedFunctionPointers[i] = (IntPtr) (functionPointers[i]);
-            }
-            _nativeFunctionPointers[nativeClassName] = unboxedFunctionPointers;
-        }
-
-        public IntPtr[] GetNativeFunctionPointers(string nativeClassName){
-            return _nativeFunctionPointers[nativeClassName];
+        public void SetNativeFunctionTable(long functionTable, int numFunctions, long classIndex, int numClasses){
+            NativeFunctionTable.Initialize(
+                (IntPtr)functionTable, numFunctions, (IntPtr)classIndex, numClasses
+            );
         }
 
         public void LoadUnrealEngineWrapperAssembly(){
@@ -120,6 +111,10 @@ namespace Klawr.ClrHost.Managed{
             Assembly.Load(wrapperAssembly);
         }
 
+        public int VerifyStructLayouts(long structLayouts, int numLayouts){
+            return StructLayoutVerifier.Verify((IntPtr)structLayouts, numLayouts);
+        }
+
         public bool LoadAssembly(string assemblyName){
             var assembly = new AssemblyName{Name = assemblyName};
 
@@ -242,12 +237,13 @@ namespace Klawr.ClrHost.Managed{
                             .FirstOrDefault(t => t.FullName.Equals(typeName));
         }
 
-        public void BindUtils(ref ObjectUtilsProxy objectUtilsProxy, ref LogUtilsProxy logUtilsProxy, ref ArrayUtilsProxy arrayUtilsProxy){
+        public void BindUtils(ref ObjectUtilsProxy objectUtilsProxy, ref LogUtilsProxy logUtilsProxy, ref ArrayUtilsProxy arrayUtilsProxy, ref EventUtilsProxy eventUtilsProxy){
             new ObjectUtils(ref objectUtilsProxy);
             new LogUtils(ref logUtilsProxy);
             // redirect output to the UE console and log file (needs LogUtils)
             Console.SetOut(new UELogWriter());
             new ArrayUtils(ref arrayUtilsProxy);
+            new EventUtils(ref eventUtilsProxy);
         }
 
         public bool CreateScriptComponent(string className, IntPtr nativeComponent, ref ScriptComponentProxy proxy){
@@ -287,6 +283,42 @@ namespace Klawr.ClrHost.Managed{
             instance.Dispose();
         }
 
+        public byte[] SaveScriptComponentState(long instanceID){
+            ScriptComponentInfo componentInfo;
+            if (_scriptComponents.TryGetValue(instanceID, out componentInfo)){
+                try{
+                    return ScriptComponentState.Save(componentInfo.Instance, GetScriptComponentBaseType());
+                } catch (Exception e){
+                    LogUtils.LogError($"Failed to save the state of script component #{instanceID}: {e.Message}");
+                }
+            }
+            return null;
+        }
+
+        public bool RestoreScriptComponentState(long instanceID, byte[] state){
+            ScriptComponentInfo componentInfo;
+            if ((state != null) && _scriptComponents.TryGetValue(instanceID, out componentInfo)){
+                try{
+                    return ScriptComponentState.Restore(
+                        componentInfo.Instance, GetScriptComponentBaseType(), state
+                    ) >= 0;
+                } catch (Exception e){
+                    LogUtils.LogError($"Failed to restore the state of script component #{instanceID}: {e.Message}");
+                }
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Get the generated wrapper class all script components are derived from.
+        /// </summary>
+        private Type GetScriptComponentBaseType(){
+            if (_scriptComponentBaseType == null){
+                _scriptComponentBaseType = FindTypeByName($"{GlobalStrings.KlawrUnrealEngineNamespace}.UKlawrScriptComponent");
+            }
+            return _scriptComponentBaseType;
+        }
+
         private void RegisterScriptComponent(long instanceID, IDisposable scriptComponent, ScriptComponentProxy proxy){
             ScriptComponentInfo componentInfo;
             componentInfo.Instance = scriptComponent;
@@ -417,6 +449,16 @@ namespace Klawr.ClrHost.Managed{
                             .ToArray();
         }
 
+        public bool WriteBindingUsage(string assemblyName, string usageFilename){
+            var assembly = AppDomain.CurrentDomain.GetAssemblies()
+                                    .FirstOrDefault(a => a.GetName().Name == assemblyName);
+            if (assembly == null){
+                LogUtils.LogError($"Can't write binding usage, {assemblyName} isn't loaded.");
+                return false;
+            }
+            return BindingUsageScanner.WriteUsageFile(assembly, usageFilename);
+        }
+
         public string[] GetScriptComponentPropertyNames(string componentName)
         {
             var scriptComponentType = FindTypeByName(componentName);
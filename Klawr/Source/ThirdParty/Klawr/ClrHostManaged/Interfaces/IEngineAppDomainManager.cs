@@ -35,24 +35,35 @@ namespace Klawr.ClrHost.Interfaces{
     [Guid("CBFAB628-9E4D-4439-89FA-EF8B1D5FF966")]
     public interface IEngineAppDomainManager{
         /// <summary>
-        /// Store pointers to native functions that wrap methods of a C++ class.
+        /// Store the location of the table of native functions that wrap methods of C++ classes.
         /// </summary>
-        /// <param name="nativeClassName">Name of C++ class to store function pointers for.</param>
-        /// <param name="functionPointers">Array of pointers to native functions.</param>
-        void SetNativeFunctionPointers(string nativeClassName, long[] functionPointers);
+        /// <remarks>
+        /// The pointers are passed in as long to avoid pointer truncation on a 64-bit platform 
+        /// when this method is called via COM. The table and the class index are owned by the 
+        /// native side and must remain valid for the lifetime of the engine app domain.
+        /// </remarks>
+        /// <param name="functionTable">Pointer to an array of pointers to native functions, the
+        /// functions of each class are stored contiguously.</param>
+        /// <param name="numFunctions">Number of elements in the function table.</param>
+        /// <param name="classIndex">Pointer to an array of entries that map each C++ class name to 
+        /// the offset of its first function in the function table.</param>
+        /// <param name="numClasses">Number of elements in the class index.</param>
+        void SetNativeFunctionTable(long functionTable, int numFunctions, long classIndex, int numClasses);
 
         /// <summary>
-        /// Retrieve pointers to native functions that wrap methods of a C++ class.
+        /// Load the Klawr.UnrealEngine assembly into the engine app domain.
         /// </summary>
-        /// <param name="nativeClassName">Name of C++ class to retrieve function pointers for.</param>
-        /// <returns>Array of pointers to native functions.</returns>
-        [ComVisible(false)]
-        IntPtr[] GetNativeFunctionPointers(string nativeClassName);
+        void LoadUnrealEngineWrapperAssembly();
 
         /// <summary>
-        /// Load the Klawr.UnrealEngine assembly into the engine app domain.
+        /// Check the layouts of the generated C# structs against the native structs, this must be
+        /// called after the Klawr.UnrealEngine assembly is loaded.
         /// </summary>
-        void LoadUnrealEngineWrapperAssembly();
+        /// <param name="structLayouts">Pointer to an array of native struct field layouts, passed
+        /// as long to avoid pointer truncation on a 64-bit platform.</param>
+        /// <param name="numLayouts">Number of elements in the array.</param>
+        /// <returns>Number of structs whose layouts don't match.</returns>
+        int VerifyStructLayouts(long structLayouts, int numLayouts);
 
         /// <summary>
         /// Load the specified assembly into the engine app domain.
@@ -82,18 +93,45 @@ namespace Klawr.ClrHost.Interfaces{
         /// initialization of the engine app domain, before any native UObject instance is 
         /// passed to the managed side.
         /// </summary>
-        void BindUtils( ref ObjectUtilsProxy objectUtilsProxy, ref LogUtilsProxy logUtilsProxy, ref ArrayUtilsProxy arrayUtilsProxy);
+        void BindUtils( ref ObjectUtilsProxy objectUtilsProxy, ref LogUtilsProxy logUtilsProxy, ref ArrayUtilsProxy arrayUtilsProxy, ref EventUtilsProxy eventUtilsProxy);
 
         bool CreateScriptComponent(string className, IntPtr nativeComponent, ref ScriptComponentProxy proxy);
 
         void DestroyScriptComponent(long scriptComponentID);
 
+        /// <summary>
+        /// Save the fields of a script component instance (see ScriptComponentState), the saved
+        /// state can be restored into an instance of the same type in another engine app domain.
+        /// </summary>
+        /// <param name="scriptComponentID">The ID of the script component instance.</param>
+        /// <returns>The saved state, or null if the instance doesn't exist or couldn't be saved.</returns>
+        byte[] SaveScriptComponentState(long scriptComponentID);
+
+        /// <summary>
+        /// Restore the fields of a script component instance from a state previously returned by
+        /// SaveScriptComponentState(), fields are matched up by name and type.
+        /// </summary>
+        /// <param name="scriptComponentID">The ID of the script component instance.</param>
+        /// <param name="state">The saved state.</param>
+        /// <returns>true if the state was restored, false if the instance doesn't exist or the 
+        /// state was saved from a different type of script component</returns>
+        bool RestoreScriptComponentState(long scriptComponentID, byte[] state);
+
         /// <summary>
         /// Get the fully qualified names (including namespace) of all currently loaded managed 
         /// types derived from UKlawrScriptComponent.
         /// </summary>
         /// <returns>Script component type names.</returns>
         string[] GetScriptComponentTypes();
+
+        /// <summary>
+        /// Write the members of the generated wrapper classes that are referenced by an assembly 
+        /// loaded in the engine app domain to a file (see BindingUsageScanner).
+        /// </summary>
+        /// <param name="assemblyName">Name of a loaded assembly (without a file extension).</param>
+        /// <param name="usageFilename">File to write the referenced members to.</param>
+        /// <returns>true if the file was written successfully, false otherwise</returns>
+        bool WriteBindingUsage(string assemblyName, string usageFilename);
     
         bool GetScriptComponentPropertyIsAdvancedDisplay(string componentName, string propertyName);
 
@@ -0,0 +1,118 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Reflection.Emit;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Binds delegates to native functions through calli stubs instead of marshaling stubs.
+    /// </summary>
+    /// <remarks>
+    /// Delegates returned by Marshal.GetDelegateForFunctionPointer() go through a marshaling stub
+    /// on every call, even when none of the arguments need to be marshaled. The stubs generated
+    /// here load the arguments and the function pointer and call the native function directly, 
+    /// so they can only be used with delegate types whose parameters and return value have the
+    /// same representation in native and managed code (see IsBlittable()).
+    /// </remarks>
+    public static class NativeCalli{
+        /// <summary>
+        /// Create a delegate that calls the given native cdecl function directly.
+        /// </summary>
+        /// <typeparam name="TDelegate">Delegate type matching the signature of the native function.</typeparam>
+        /// <param name="nativeFunction">Pointer to the native function.</param>
+        /// <returns>A delegate bound to the native function.</returns>
+        public static TDelegate Bind<TDelegate>(IntPtr nativeFunction) where TDelegate : class{
+            var delegateType = typeof(TDelegate);
+            var invokeMethod = delegateType.GetMethod("Invoke");
+            if (invokeMethod == null){
+                throw new ArgumentException(delegateType.FullName + " is not a delegate type.");
+            }
+            var returnType = invokeMethod.ReturnType;
+            var parameters = invokeMethod.GetParameters();
+            var parameterTypes = new Type[parameters.Length];
+            for (int i = 0; i < parameters.Length; ++i){
+                parameterTypes[i] = parameters[i].ParameterType;
+                if (!IsBlittable(parameterTypes[i])){
+                    throw new ArgumentException(
+                        String.Format(
+                            "Parameter {0} of {1} can't be passed to native code without marshaling.",
+                            parameters[i].Name, delegateType.FullName
+                        )
+                    );
+                }
+            }
+            if ((returnType != typeof(void)) && !IsBlittable(returnType)){
+                throw new ArgumentException(
+                    "The return type of " + delegateType.FullName + " can't be returned from native code without marshaling."
+                );
+            }
+
+            // the stub is associated with this module and skips visibility checks so that it can be
+            // bound to private delegate types declared in other assemblies
+            var stub = new DynamicMethod(
+                "Calli_" + delegateType.Name, returnType, parameterTypes, 
+                typeof(NativeCalli).Module, true
+            );
+            var il = stub.GetILGenerator();
+            for (int i = 0; i < parameterTypes.Length; ++i){
+                EmitLoadArg(il, i);
+            }
+            if (IntPtr.Size == 8){
+                il.Emit(OpCodes.Ldc_I8, nativeFunction.ToInt64());
+            } else{
+                il.Emit(OpCodes.Ldc_I4, nativeFunction.ToInt32());
+            }
+            il.Emit(OpCodes.Conv_I);
+            il.EmitCalli(OpCodes.Calli, CallingConvention.Cdecl, returnType, parameterTypes);
+            il.Emit(OpCodes.Ret);
+            return stub.CreateDelegate(delegateType) as TDelegate;
+        }
+
+        /// <summary>
+        /// Check if values of the given type can be passed to or returned from a calli stub.
+        /// </summary>
+        public static bool IsBlittable(Type type){
+            // bool and char are primitives but their native size depends on how they're marshaled
+            return type.IsPrimitive && (type != typeof(bool)) && (type != typeof(char));
+        }
+
+        private static void EmitLoadArg(ILGenerator il, int index){
+            switch (index){
+                case 0: il.Emit(OpCodes.Ldarg_0); break;
+                case 1: il.Emit(OpCodes.Ldarg_1); break;
+                case 2: il.Emit(OpCodes.Ldarg_2); break;
+                case 3: il.Emit(OpCodes.Ldarg_3); break;
+                default:
+                    if (index <= Byte.MaxValue){
+                        il.Emit(OpCodes.Ldarg_S, (byte)index);
+                    } else{
+                        il.Emit(OpCodes.Ldarg, (short)index);
+                    }
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+using Klawr.ClrHost.Managed.SafeHandles;
+using System;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// The managed side of a dynamic multicast delegate property of a native object, used by the
+    /// generated wrapper classes to implement events.
+    /// </summary>
+    /// <remarks>
+    /// The native delegate is only bound while at least one handler is added, and it's bound once
+    /// regardless of the number of handlers. Handlers are kept alive until they're removed or the
+    /// event is disposed, just like handlers of any other long-lived event source.
+    /// </remarks>
+    /// <typeparam name="THandler">The delegate type of the handlers.</typeparam>
+    public sealed class NativeEvent<THandler> : INativeEventBinding, IDisposable where THandler : class{
+        /// <summary>
+        /// Unpacks the native arguments (see NativeEventArgs) and invokes the handlers.
+        /// </summary>
+        public delegate void Dispatcher(THandler handlers, IntPtr args);
+
+        private readonly UObjectHandle _sourceObject;
+        private readonly string _delegateName;
+        private readonly Dispatcher _dispatch;
+        private THandler _handlers;
+        private int _bindingID;
+
+        /// <param name="sourceObject">The native object the multicast delegate belongs to.</param>
+        /// <param name="delegateName">Name of the multicast delegate property.</param>
+        /// <param name="dispatch">Invokes the handlers with the arguments of a broadcast.</param>
+        public NativeEvent(UObjectHandle sourceObject, string delegateName, Dispatcher dispatch){
+            _sourceObject = sourceObject;
+            _delegateName = delegateName;
+            _dispatch = dispatch;
+        }
+
+        public void Add(THandler handler){
+            if (handler == null){
+                return;
+            }
+            _handlers = (THandler)(object)Delegate.Combine((Delegate)(object)_handlers, (Delegate)(object)handler);
+            if (_bindingID == 0){
+                _bindingID = EventUtils.Bind(_sourceObject, _delegateName, this);
+                if (_bindingID == 0){
+                    LogUtils.LogError("Failed to bind to native event " + _delegateName);
+                }
+            }
+        }
+
+        public void Remove(THandler handler){
+            _handlers = (THandler)(object)Delegate.Remove((Delegate)(object)_handlers, (Delegate)(object)handler);
+            if (_handlers == null){
+                Unbind();
+            }
+        }
+
+        public void Dispose(){
+            _handlers = null;
+            Unbind();
+        }
+
+        void INativeEventBinding.Invoke(IntPtr args, int numArgs){
+            var handlers = _handlers;
+            if (handlers != null){
+                _dispatch(handlers, args);
+            }
+        }
+
+        private void Unbind(){
+            if (_bindingID != 0){
+                EventUtils.Unbind(_bindingID);
+                _bindingID = 0;
+            }
+        }
+    }
+}
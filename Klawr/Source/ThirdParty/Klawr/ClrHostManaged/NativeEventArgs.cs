@@ -0,0 +1,96 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+using Klawr.ClrHost.Managed.SafeHandles;
+using System;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Reads the arguments native code passes to the handlers of a NativeEvent.
+    /// </summary>
+    /// <remarks>
+    /// The arguments are an array of native VariantArg(s) (see KlawrClrHost.h), each one is a 
+    /// 4 byte type tag followed by 8 bytes of data. Strings and structs point into the native 
+    /// delegate parameters, so they're copied before the handlers are invoked.
+    /// </remarks>
+    public static class NativeEventArgs{
+        private const int ArgSize = 12;
+        private const int DataOffset = 4;
+
+        [StructLayout(LayoutKind.Explicit)]
+        private struct IntFloat{
+            [FieldOffset(0)]
+            public int Int;
+            [FieldOffset(0)]
+            public float Float;
+        }
+
+        public static int GetInt(IntPtr args, int index){
+            return Marshal.ReadInt32(args, index * ArgSize + DataOffset);
+        }
+
+        public static float GetFloat(IntPtr args, int index){
+            return new IntFloat{Int = GetInt(args, index)}.Float;
+        }
+
+        public static bool GetBool(IntPtr args, int index){
+            return GetInt(args, index) != 0;
+        }
+
+        public static string GetString(IntPtr args, int index){
+            return Marshal.PtrToStringUni(Marshal.ReadIntPtr(args, index * ArgSize + DataOffset));
+        }
+
+        /// <summary>
+        /// Get an object argument, native code only keeps the objects it passes in alive until the
+        /// handlers return so the returned handle takes its own reference.
+        /// </summary>
+        public static UObjectHandle GetObject(IntPtr args, int index){
+            var nativeObject = Marshal.ReadIntPtr(args, index * ArgSize + DataOffset);
+            if (nativeObject != IntPtr.Zero){
+                ObjectUtils.AddObjectRef(nativeObject);
+            }
+            return new UObjectHandle(nativeObject, true);
+        }
+
+        /// <summary>
+        /// Get a copy of a struct argument.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">The generated struct doesn't match the 
+        /// native layout (see StructLayoutVerifier), so it can't be copied.</exception>
+        public static T GetStruct<T>(IntPtr args, int index) where T : struct{
+            var structType = typeof(T);
+            if (structType.IsExplicitLayout && !StructLayoutVerifier.IsVerified(structType)){
+                // copying it anyway would fill the fields with the wrong bytes, and might read past
+                // the end of the native struct
+                throw new InvalidOperationException(String.Format(
+                    "Event argument {0} can't be read because the layout of {1} doesn't match the native struct. Regenerate the wrappers.",
+                    index, structType.Name
+                ));
+            }
+            var nativeStruct = Marshal.ReadIntPtr(args, index * ArgSize + DataOffset);
+            return (T)Marshal.PtrToStructure(nativeStruct, structType);
+        }
+    }
+}
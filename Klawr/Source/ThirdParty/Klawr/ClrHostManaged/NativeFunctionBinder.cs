@@ -0,0 +1,86 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Binds the delegates of the generated wrapper classes to native wrapper functions.
+    /// </summary>
+    /// <remarks>
+    /// The generated wrapper classes bind each delegate the first time it's used, this class keeps
+    /// track of how many delegates have been bound and how long that took so the cost of binding 
+    /// can be measured (see Diagnostics.InteropBenchmark).
+    /// </remarks>
+    public static class NativeFunctionBinder{
+        private static int _numBoundFunctions = 0;
+        private static long _bindingTicks = 0;
+
+        /// <summary>
+        /// Number of delegates that have been bound so far.
+        /// </summary>
+        public static int NumBoundFunctions { get { return _numBoundFunctions; } }
+
+        /// <summary>
+        /// Total time spent binding delegates so far.
+        /// </summary>
+        public static TimeSpan BindingTime { 
+            get { return TimeSpan.FromSeconds((double)Interlocked.Read(ref _bindingTicks) / Stopwatch.Frequency); } 
+        }
+
+        /// <summary>
+        /// Bind a delegate to a native function through a marshaling stub.
+        /// </summary>
+        /// <typeparam name="TDelegate">Delegate type matching the signature of the native function.</typeparam>
+        /// <param name="nativeFunction">Pointer to the native function.</param>
+        /// <returns>A delegate bound to the native function.</returns>
+        public static TDelegate Bind<TDelegate>(IntPtr nativeFunction) where TDelegate : class{
+            var startTicks = Stopwatch.GetTimestamp();
+            var boundDelegate = Marshal.GetDelegateForFunctionPointer(nativeFunction, typeof(TDelegate)) as TDelegate;
+            RecordBinding(startTicks);
+            return boundDelegate;
+        }
+
+        /// <summary>
+        /// Bind a delegate to a native function through a calli stub (see NativeCalli).
+        /// </summary>
+        /// <typeparam name="TDelegate">Delegate type matching the signature of the native function.</typeparam>
+        /// <param name="nativeFunction">Pointer to the native function.</param>
+        /// <returns>A delegate bound to the native function.</returns>
+        public static TDelegate BindDirect<TDelegate>(IntPtr nativeFunction) where TDelegate : class{
+            var startTicks = Stopwatch.GetTimestamp();
+            var boundDelegate = NativeCalli.Bind<TDelegate>(nativeFunction);
+            RecordBinding(startTicks);
+            return boundDelegate;
+        }
+
+        private static void RecordBinding(long startTicks){
+            Interlocked.Add(ref _bindingTicks, Stopwatch.GetTimestamp() - startTicks);
+            Interlocked.Increment(ref _numBoundFunctions);
+        }
+    }
+}
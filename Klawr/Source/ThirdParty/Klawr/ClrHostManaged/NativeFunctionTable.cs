@@ -0,0 +1,115 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Provides access to the table of native wrapper functions owned by the native side of the 
+    /// CLR host.
+    /// </summary>
+    /// <remarks>
+    /// The native side passes the table to each engine app domain once during initialization, the 
+    /// table and class index are read in place so nothing is copied until a generated wrapper 
+    /// class actually needs a function pointer.
+    /// </remarks>
+    public static class NativeFunctionTable{
+        /// <summary>
+        /// Location of the wrapper functions of a single class in the table.
+        /// </summary>
+        /// <remarks>
+        /// This struct has a native counterpart (ClrHost::NativeFunctionTableEntry) defined in 
+        /// Klawr.ClrHost.Native, the size and layout of the two structures must remain identical.
+        /// </remarks>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct ClassEntry{
+            public IntPtr ClassName;
+            public int Offset;
+            public int NumFunctions;
+        }
+
+        private static IntPtr _functions;
+        private static int _numFunctions;
+        private static IntPtr _classIndex;
+        private static int _numClasses;
+        // built on first use from the native class index
+        private static Dictionary<string, int> _classOffsets;
+        private static readonly object _classOffsetsLock = new object();
+
+        /// <summary>
+        /// Store the location of the native function table, called by the engine app domain 
+        /// manager during initialization.
+        /// </summary>
+        internal static void Initialize(IntPtr functions, int numFunctions, IntPtr classIndex, int numClasses){
+            _functions = functions;
+            _numFunctions = numFunctions;
+            _classIndex = classIndex;
+            _numClasses = numClasses;
+            _classOffsets = null;
+        }
+
+        /// <summary>
+        /// Get the index of the first wrapper function of a C++ class in the table.
+        /// </summary>
+        /// <param name="nativeClassName">Name of a C++ class (including prefix, e.g. AActor).</param>
+        /// <returns>Index of the first wrapper function of the class.</returns>
+        public static int GetClassOffset(string nativeClassName){
+            var classOffsets = _classOffsets;
+            if (classOffsets == null){
+                lock (_classOffsetsLock){
+                    if (_classOffsets == null){
+                        _classOffsets = BuildClassOffsets();
+                    }
+                    classOffsets = _classOffsets;
+                }
+            }
+            return classOffsets[nativeClassName];
+        }
+
+        /// <summary>
+        /// Get a pointer to a native wrapper function.
+        /// </summary>
+        /// <param name="index">Index of the function in the table, i.e. the offset of the class
+        /// the function belongs to plus the index of the function within the class.</param>
+        /// <returns>Pointer to the native function.</returns>
+        public static IntPtr GetFunction(int index){
+            if ((index < 0) || (index >= _numFunctions)){
+                throw new ArgumentOutOfRangeException("index");
+            }
+            return Marshal.ReadIntPtr(_functions, index * IntPtr.Size);
+        }
+
+        private static Dictionary<string, int> BuildClassOffsets(){
+            var classOffsets = new Dictionary<string, int>(_numClasses);
+            var entrySize = Marshal.SizeOf(typeof(ClassEntry));
+            for (var i = 0; i < _numClasses; ++i){
+                var entry = (ClassEntry)Marshal.PtrToStructure(_classIndex + i * entrySize, typeof(ClassEntry));
+                classOffsets[Marshal.PtrToStringUni(entry.ClassName)] = entry.Offset;
+            }
+            return classOffsets;
+        }
+    }
+}
@@ -105,12 +105,66 @@ namespace Klawr.ClrHost.Managed{
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public delegate Int32 FindObjectFunc(ArrayHandle arrayHandle, UObjectHandle item);
 
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 CountUInt8Func(ArrayHandle arrayHandle, byte item);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 CountInt16Func(ArrayHandle arrayHandle, Int16 item);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 CountInt32Func(ArrayHandle arrayHandle, Int32 item);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 CountInt64Func(ArrayHandle arrayHandle, Int64 item);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 FindAnyUInt8Func(ArrayHandle arrayHandle, byte[] items, Int32 numItems);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 FindAnyInt16Func(ArrayHandle arrayHandle, Int16[] items, Int32 numItems);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 FindAnyInt32Func(ArrayHandle arrayHandle, Int32[] items, Int32 numItems);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 FindAnyInt64Func(ArrayHandle arrayHandle, Int64[] items, Int32 numItems);
+
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public delegate void InsertAction(ArrayHandle arrayHandle, Int32 index);
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public delegate void RemoveAtAction(ArrayHandle arrayHandle, Int32 index);
 
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate Int32 GetElementSizeFunc(ArrayHandle arrayHandle);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public delegate bool CopyToBufferFunc(
+            ArrayHandle arrayHandle, Int32 index, IntPtr buffer, Int32 count
+        );
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        public delegate bool CopyFromBufferFunc(
+            ArrayHandle arrayHandle, Int32 index, IntPtr buffer, Int32 count
+        );
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void GetStringsAction(
+            ArrayHandle arrayHandle, Int32 index, [Out] IntPtr[] buffer, Int32 count
+        );
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void GetNamesAction(
+            ArrayHandle arrayHandle, Int32 index, [Out] FScriptName[] buffer, Int32 count
+        );
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void GetObjectsAction(
+            ArrayHandle arrayHandle, Int32 index, [Out] IntPtr[] buffer, Int32 count
+        );
+
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public delegate void DestroyAction(IntPtr arrayHandle);
 
@@ -180,12 +234,54 @@ namespace Klawr.ClrHost.Managed{
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public FindObjectFunc FindObject;
 
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CountUInt8Func CountUInt8;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CountInt16Func CountInt16;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CountInt32Func CountInt32;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CountInt64Func CountInt64;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public FindAnyUInt8Func FindAnyUInt8;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public FindAnyInt16Func FindAnyInt16;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public FindAnyInt32Func FindAnyInt32;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public FindAnyInt64Func FindAnyInt64;
+
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public InsertAction Insert;
 
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public RemoveAtAction RemoveAt;
 
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public GetElementSizeFunc GetElementSize;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CopyToBufferFunc CopyToBuffer;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public CopyFromBufferFunc CopyFromBuffer;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public GetStringsAction GetStrings;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public GetNamesAction GetNames;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public GetObjectsAction GetObjects;
+
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public DestroyAction Destroy;
     }
@@ -0,0 +1,63 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+using Klawr.ClrHost.Managed.SafeHandles;
+using System;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Contains delegates encapsulating the native functions that bind managed handlers to the
+    /// dynamic multicast delegates (events) of native UObject instances.
+    /// </summary>
+    /// <remarks>This struct has a native counterpart by the same name defined in the
+    /// Klawr.ClrHost.Native project, and it is also exposed to native code via COM.</remarks>
+    [ComVisible(true)]
+    [Guid("1A18BC0A-80EA-4E4A-91A4-04A0C88135BD")]
+    [StructLayout(LayoutKind.Sequential)]
+    public struct EventUtilsProxy{
+        /// <summary>
+        /// Called from native code whenever a bound event is broadcast.
+        /// </summary>
+        /// <param name="bindingID">ID returned by BindEvent.</param>
+        /// <param name="args">Pointer to an array of native VariantArg(s), only valid for the 
+        /// duration of the call.</param>
+        /// <param name="numArgs">Number of elements in the args array.</param>
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void DispatchEventAction(int bindingID, IntPtr args, int numArgs);
+
+        /// <param name="appDomainID">ID of the app domain the binding belongs to.</param>
+        /// <param name="dispatch">Function pointer to a DispatchEventAction.</param>
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl, CharSet = CharSet.Unicode)]
+        public delegate int BindEventFunc(int appDomainID, UObjectHandle sourceObject, string delegateName, IntPtr dispatch);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void UnbindEventAction(int bindingID);
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public BindEventFunc BindEvent;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public UnbindEventAction UnbindEvent;
+    }
+}
@@ -47,6 +47,9 @@ namespace Klawr.ClrHost.Managed{
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public delegate void RemoveObjectRefAction(IntPtr nativeObject);
 
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public delegate void AddObjectRefAction(IntPtr nativeObject);
+
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public GetClassByNameFunc GetClassByName;
 
@@ -58,5 +61,8 @@ namespace Klawr.ClrHost.Managed{
 
         [MarshalAs(UnmanagedType.FunctionPtr)]
         public RemoveObjectRefAction RemoveObjectRef;
+
+        [MarshalAs(UnmanagedType.FunctionPtr)]
+        public AddObjectRefAction AddObjectRef;
     }
 }
\ No newline at end of file
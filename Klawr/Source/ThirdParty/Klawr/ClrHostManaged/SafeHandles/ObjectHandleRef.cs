@@ -0,0 +1,63 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+using System;
+
+namespace Klawr.ClrHost.Managed.SafeHandles{
+    /// <summary>
+    /// Keeps a UObjectHandle from being released while its raw pointer is being used.
+    /// </summary>
+    /// <remarks>
+    /// Used by the generated wrappers that pass raw UObject pointers to native code through calli 
+    /// stubs, nothing else would stop the handle being finalized or disposed during the call.
+    /// Should be declared in a using statement, it's a struct so no garbage is generated.
+    /// </remarks>
+    public struct UObjectHandleRef : IDisposable{
+        private readonly UObjectHandle _handle;
+        private bool _addedRef;
+
+        /// <summary>
+        /// The raw pointer to the native UObject, or IntPtr.Zero if the handle is null or invalid.
+        /// </summary>
+        public IntPtr Handle { get; private set; }
+
+        /// <param name="handle">Handle to add a reference to, may be null.</param>
+        /// <exception cref="ObjectDisposedException">The handle has already been released.</exception>
+        public UObjectHandleRef(UObjectHandle handle){
+            _handle = handle;
+            _addedRef = false;
+            Handle = IntPtr.Zero;
+            if ((handle != null) && !handle.IsInvalid){
+                handle.DangerousAddRef(ref _addedRef);
+                Handle = handle.DangerousGetHandle();
+            }
+        }
+
+        public void Dispose(){
+            if (_addedRef){
+                _addedRef = false;
+                _handle.DangerousRelease();
+            }
+        }
+    }
+}
@@ -0,0 +1,214 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Saves and restores the fields of script component instances so that their state survives
+    /// the engine app domain being unloaded and recreated (e.g. when game scripts are reloaded).
+    /// </summary>
+    /// <remarks>
+    /// Only the fields declared by the script classes themselves are saved (this includes the 
+    /// backing fields of auto-implemented [UPROPERTY] properties), fields marked [NonSerialized] 
+    /// are skipped. Fields are matched up by name and type when restored, so fields that were 
+    /// renamed, removed, or changed type in the meantime keep whatever value the constructor of 
+    /// the new instance gave them. References to UObject(s) are not saved because the native 
+    /// objects may have been garbage collected once the old app domain released them, property 
+    /// trackers in UKlawrScriptComponent resync any UObject properties exposed to the engine.
+    /// </remarks>
+    public static class ScriptComponentState{
+        // bump this whenever the format changes, state in an older format will be ignored
+        private const int FormatVersion = 2;
+
+        private const BindingFlags DeclaredInstanceFields = 
+            BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.DeclaredOnly;
+
+        private static Dictionary<Type, FieldInfo[]> _fieldCache = new Dictionary<Type, FieldInfo[]>();
+
+        /// <summary>
+        /// Save the fields of a script component instance.
+        /// </summary>
+        /// <param name="component">Script component instance.</param>
+        /// <param name="baseType">The fields declared by this type and its base types are not saved.</param>
+        /// <returns>The saved state of the instance.</returns>
+        public static byte[] Save(object component, Type baseType){
+            var componentType = component.GetType();
+            var fields = GetStateFields(componentType, baseType);
+            using (var stream = new MemoryStream())
+            using (var writer = new BinaryWriter(stream, Encoding.UTF8)){
+                writer.Write(FormatVersion);
+                writer.Write(componentType.FullName);
+                writer.Write(fields.Length);
+                foreach (var field in fields){
+                    var value = field.GetValue(component);
+                    var typeCode = Type.GetTypeCode(field.FieldType);
+                    writer.Write(field.Name);
+                    // a null string is stored as TypeCode.Empty so it can be told apart from ""
+                    writer.Write((byte)((value == null) ? TypeCode.Empty : typeCode));
+                    if (value != null){
+                        WriteValue(writer, typeCode, value);
+                    }
+                }
+                writer.Flush();
+                return stream.ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Restore the fields of a script component instance from a previously saved state.
+        /// </summary>
+        /// <param name="component">Script component instance.</param>
+        /// <param name="baseType">The fields declared by this type and its base types are not restored.</param>
+        /// <param name="state">State previously returned by Save().</param>
+        /// <returns>Number of fields restored, or -1 if the state doesn't belong to the same type of 
+        /// script component (or is in an unsupported format).</returns>
+        public static int Restore(object component, Type baseType, byte[] state){
+            var componentType = component.GetType();
+            var fields = GetStateFields(componentType, baseType).ToDictionary(field => field.Name);
+            int numRestored = 0;
+            using (var reader = new BinaryReader(new MemoryStream(state), Encoding.UTF8)){
+                if ((reader.ReadInt32() != FormatVersion) || (reader.ReadString() != componentType.FullName)){
+                    return -1;
+                }
+                int numFields = reader.ReadInt32();
+                for (int i = 0; i < numFields; ++i){
+                    var fieldName = reader.ReadString();
+                    var typeCode = (TypeCode)reader.ReadByte();
+                    // the value must always be read, even if it's discarded, to get to the next field
+                    var value = (typeCode != TypeCode.Empty) ? ReadValue(reader, typeCode) : null;
+                    FieldInfo field;
+                    if (fields.TryGetValue(fieldName, out field)){
+                        var fieldTypeCode = Type.GetTypeCode(field.FieldType);
+                        if (typeCode == TypeCode.Empty){
+                            if (!field.FieldType.IsValueType){
+                                field.SetValue(component, null);
+                                ++numRestored;
+                            }
+                        } else if (typeCode == fieldTypeCode){
+                            field.SetValue(
+                                component,
+                                field.FieldType.IsEnum ? Enum.ToObject(field.FieldType, value) : value
+                            );
+                            ++numRestored;
+                        }
+                    }
+                }
+            }
+            return numRestored;
+        }
+
+        /// <summary>
+        /// Get the fields of a script component type that can be saved.
+        /// </summary>
+        private static FieldInfo[] GetStateFields(Type componentType, Type baseType){
+            FieldInfo[] fields;
+            if (!_fieldCache.TryGetValue(componentType, out fields)){
+                var fieldList = new List<FieldInfo>();
+                for (var type = componentType; (type != null) && (type != baseType); type = type.BaseType){
+                    fieldList.AddRange(
+                        type.GetFields(DeclaredInstanceFields).Where(
+                            field => !field.IsNotSerialized && !field.IsInitOnly && IsSupportedType(field.FieldType)
+                        )
+                    );
+                }
+                fields = fieldList.ToArray();
+                _fieldCache.Add(componentType, fields);
+            }
+            return fields;
+        }
+
+        private static bool IsSupportedType(Type type){
+            switch (Type.GetTypeCode(type)){
+                case TypeCode.Boolean:
+                case TypeCode.Char:
+                case TypeCode.SByte:
+                case TypeCode.Byte:
+                case TypeCode.Int16:
+                case TypeCode.UInt16:
+                case TypeCode.Int32:
+                case TypeCode.UInt32:
+                case TypeCode.Int64:
+                case TypeCode.UInt64:
+                case TypeCode.Single:
+                case TypeCode.Double:
+                case TypeCode.Decimal:
+                case TypeCode.DateTime:
+                case TypeCode.String:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        private static void WriteValue(BinaryWriter writer, TypeCode typeCode, object value){
+            switch (typeCode){
+                case TypeCode.Boolean: writer.Write((bool)value); break;
+                // BinaryWriter encodes a char as UTF-8 and throws if it's a lone surrogate, which
+                // would lose the state of the whole component, so store the UTF-16 code unit
+                case TypeCode.Char: writer.Write((ushort)(char)value); break;
+                case TypeCode.SByte: writer.Write(Convert.ToSByte(value)); break;
+                case TypeCode.Byte: writer.Write(Convert.ToByte(value)); break;
+                case TypeCode.Int16: writer.Write(Convert.ToInt16(value)); break;
+                case TypeCode.UInt16: writer.Write(Convert.ToUInt16(value)); break;
+                case TypeCode.Int32: writer.Write(Convert.ToInt32(value)); break;
+                case TypeCode.UInt32: writer.Write(Convert.ToUInt32(value)); break;
+                case TypeCode.Int64: writer.Write(Convert.ToInt64(value)); break;
+                case TypeCode.UInt64: writer.Write(Convert.ToUInt64(value)); break;
+                case TypeCode.Single: writer.Write((float)value); break;
+                case TypeCode.Double: writer.Write((double)value); break;
+                case TypeCode.Decimal: writer.Write((decimal)value); break;
+                case TypeCode.DateTime: writer.Write(((DateTime)value).ToBinary()); break;
+                case TypeCode.String: writer.Write((string)value); break;
+            }
+        }
+
+        private static object ReadValue(BinaryReader reader, TypeCode typeCode){
+            switch (typeCode){
+                case TypeCode.Boolean: return reader.ReadBoolean();
+                case TypeCode.Char: return (char)reader.ReadUInt16();
+                case TypeCode.SByte: return reader.ReadSByte();
+                case TypeCode.Byte: return reader.ReadByte();
+                case TypeCode.Int16: return reader.ReadInt16();
+                case TypeCode.UInt16: return reader.ReadUInt16();
+                case TypeCode.Int32: return reader.ReadInt32();
+                case TypeCode.UInt32: return reader.ReadUInt32();
+                case TypeCode.Int64: return reader.ReadInt64();
+                case TypeCode.UInt64: return reader.ReadUInt64();
+                case TypeCode.Single: return reader.ReadSingle();
+                case TypeCode.Double: return reader.ReadDouble();
+                case TypeCode.Decimal: return reader.ReadDecimal();
+                case TypeCode.DateTime: return DateTime.FromBinary(reader.ReadInt64());
+                case TypeCode.String: return reader.ReadString();
+                default:
+                    throw new InvalidDataException($"Unsupported field type {typeCode} in saved state.");
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Checks the layouts of the generated C# structs against the layouts of the native structs
+    /// they mirror.
+    /// </summary>
+    /// <remarks>
+    /// The generated structs place each field at the offset recorded in the reflection data the 
+    /// code generator had access to, this can differ from the compiled engine (e.g. if the engine 
+    /// was modified after the wrappers were generated). Only structs that pass verification can 
+    /// be safely passed to native code by pointer without copying them field by field.
+    /// </remarks>
+    public static class StructLayoutVerifier{
+        /// <summary>
+        /// The native layout of a field of a struct.
+        /// </summary>
+        /// <remarks>
+        /// This struct has a native counterpart (NativeStructFieldLayout) defined in 
+        /// Klawr.ClrHost.Native, the size and layout of the two structures must remain identical.
+        /// </remarks>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct FieldLayout{
+            public IntPtr StructName;
+            public IntPtr FieldName;
+            public int StructSize;
+            public int FieldOffset;
+            public int FieldMask;
+        }
+
+        private const BindingFlags AllInstanceFields = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance;
+        private const BindingFlags AllStaticFields = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static;
+
+        private static HashSet<Type> _verifiedStructs = new HashSet<Type>();
+
+        /// <summary>
+        /// Check if the layout of a generated struct matches the layout of the native struct.
+        /// </summary>
+        /// <param name="structType">A generated struct type.</param>
+        /// <returns>true if the struct can be passed to native code by pointer, false otherwise</returns>
+        public static bool IsVerified(Type structType){
+            return _verifiedStructs.Contains(structType);
+        }
+
+        /// <summary>
+        /// Check the generated structs against the native layouts, any mismatches are logged.
+        /// </summary>
+        /// <param name="layouts">Pointer to an array of native field layouts, the fields of each 
+        /// struct are stored contiguously with an entry describing the struct size first.</param>
+        /// <param name="numLayouts">Number of elements in the layouts array.</param>
+        /// <returns>Number of structs that don't match their native layout.</returns>
+        internal static int Verify(IntPtr layouts, int numLayouts){
+            var wrapperAssembly = AppDomain.CurrentDomain.GetAssemblies()
+                .FirstOrDefault(assembly => assembly.GetName().Name == GlobalStrings.KlawrUnrealEngineNamespace);
+            if (wrapperAssembly == null){
+                return 0;
+            }
+
+            var verifiedStructs = new HashSet<Type>();
+            var numMismatched = 0;
+            var entrySize = Marshal.SizeOf(typeof(FieldLayout));
+            var i = 0;
+            while (i < numLayouts){
+                var structLayout = ReadLayout(layouts, entrySize, i++);
+                var structName = Marshal.PtrToStringUni(structLayout.StructName);
+                var errors = new List<string>();
+
+                var structType = wrapperAssembly.GetType(GlobalStrings.KlawrUnrealEngineNamespace + "." + structName);
+                if (structType == null){
+                    errors.Add("the C# struct doesn't exist");
+                } else if (Marshal.SizeOf(structType) != structLayout.StructSize){
+                    errors.Add(String.Format(
+                        "size is {0} but should be {1}", Marshal.SizeOf(structType), structLayout.StructSize
+                    ));
+                }
+
+                // the field entries follow the entry that describes the struct size
+                while ((i < numLayouts) && (ReadLayout(layouts, entrySize, i).FieldName != IntPtr.Zero)){
+                    var fieldLayout = ReadLayout(layouts, entrySize, i++);
+                    if (structType != null){
+                        VerifyField(structType, fieldLayout, errors);
+                    }
+                }
+
+                if (errors.Count == 0){
+                    verifiedStructs.Add(structType);
+                } else{
+                    ++numMismatched;
+                    LogUtils.LogError(String.Format(
+                        "Layout of {0} doesn't match the native struct: {1}. Regenerate the wrappers.", 
+                        structName, String.Join(", ", errors)
+                    ));
+                }
+            }
+
+            _verifiedStructs = verifiedStructs;
+            LogUtils.Log(String.Format(
+                "Verified the layouts of {0} structs, {1} didn't match.", verifiedStructs.Count, numMismatched
+            ));
+            return numMismatched;
+        }
+
+        private static FieldLayout ReadLayout(IntPtr layouts, int entrySize, int index){
+            return (FieldLayout)Marshal.PtrToStructure(layouts + index * entrySize, typeof(FieldLayout));
+        }
+
+        private static void VerifyField(Type structType, FieldLayout fieldLayout, List<string> errors){
+            var fieldName = Marshal.PtrToStringUni(fieldLayout.FieldName);
+            if (structType.GetField(fieldName, AllInstanceFields) == null){
+                errors.Add(String.Format("field {0} doesn't exist", fieldName));
+                return;
+            }
+
+            var offset = Marshal.OffsetOf(structType, fieldName).ToInt32();
+            if (offset != fieldLayout.FieldOffset){
+                errors.Add(String.Format(
+                    "{0} is at offset {1} but should be at {2}", fieldName, offset, fieldLayout.FieldOffset
+                ));
+            }
+
+            if (fieldLayout.FieldMask != 0){
+                // bitfields are accessed through a mask generated alongside the field
+                var maskField = structType.GetField(fieldName + "_Mask", AllStaticFields);
+                var mask = (maskField != null) ? Convert.ToInt32(maskField.GetRawConstantValue()) : 0;
+                if (mask != fieldLayout.FieldMask){
+                    errors.Add(String.Format(
+                        "{0} uses mask 0x{1:x2} but should use 0x{2:x2}", fieldName, mask, fieldLayout.FieldMask
+                    ));
+                }
+            }
+        }
+    }
+}
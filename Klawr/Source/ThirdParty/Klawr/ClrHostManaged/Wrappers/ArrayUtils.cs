@@ -122,6 +122,38 @@ namespace Klawr.ClrHost.Managed{
             return _proxy.FindObject(arrayHandle, item);
         }
 
+        public static Int32 CountUInt8(ArrayHandle arrayHandle, byte item){
+            return _proxy.CountUInt8(arrayHandle, item);
+        }
+
+        public static Int32 CountInt16(ArrayHandle arrayHandle, Int16 item){
+            return _proxy.CountInt16(arrayHandle, item);
+        }
+
+        public static Int32 CountInt32(ArrayHandle arrayHandle, Int32 item){
+            return _proxy.CountInt32(arrayHandle, item);
+        }
+
+        public static Int32 CountInt64(ArrayHandle arrayHandle, Int64 item){
+            return _proxy.CountInt64(arrayHandle, item);
+        }
+
+        public static Int32 FindAnyUInt8(ArrayHandle arrayHandle, byte[] items){
+            return _proxy.FindAnyUInt8(arrayHandle, items, items.Length);
+        }
+
+        public static Int32 FindAnyInt16(ArrayHandle arrayHandle, Int16[] items){
+            return _proxy.FindAnyInt16(arrayHandle, items, items.Length);
+        }
+
+        public static Int32 FindAnyInt32(ArrayHandle arrayHandle, Int32[] items){
+            return _proxy.FindAnyInt32(arrayHandle, items, items.Length);
+        }
+
+        public static Int32 FindAnyInt64(ArrayHandle arrayHandle, Int64[] items){
+            return _proxy.FindAnyInt64(arrayHandle, items, items.Length);
+        }
+
         public static void Insert(ArrayHandle arrayHandle, Int32 index){
             _proxy.Insert(arrayHandle, index);
         }
@@ -130,6 +162,38 @@ namespace Klawr.ClrHost.Managed{
             _proxy.RemoveAt(arrayHandle, index);
         }
 
+        public static Int32 GetElementSize(ArrayHandle arrayHandle){
+            return _proxy.GetElementSize(arrayHandle);
+        }
+
+        public static bool CopyToBuffer(ArrayHandle arrayHandle, Int32 index, IntPtr buffer, Int32 count){
+            return _proxy.CopyToBuffer(arrayHandle, index, buffer, count);
+        }
+
+        public static bool CopyFromBuffer(ArrayHandle arrayHandle, Int32 index, IntPtr buffer, Int32 count){
+            return _proxy.CopyFromBuffer(arrayHandle, index, buffer, count);
+        }
+
+        /// <summary>
+        /// Get pointers to the characters of a range of native strings, the pointers are only 
+        /// valid until the native array is modified.
+        /// </summary>
+        public static void GetStrings(ArrayHandle arrayHandle, Int32 index, IntPtr[] buffer, Int32 count){
+            _proxy.GetStrings(arrayHandle, index, buffer, count);
+        }
+
+        public static void GetNames(ArrayHandle arrayHandle, Int32 index, FScriptName[] buffer, Int32 count){
+            _proxy.GetNames(arrayHandle, index, buffer, count);
+        }
+
+        /// <summary>
+        /// Get a range of native object pointers, a reference is added to each non-null object so
+        /// each one must be wrapped in a UObjectHandle that owns it.
+        /// </summary>
+        public static void GetObjects(ArrayHandle arrayHandle, Int32 index, IntPtr[] buffer, Int32 count){
+            _proxy.GetObjects(arrayHandle, index, buffer, count);
+        }
+
         public static void Destroy(IntPtr arrayHandle){
             _proxy.Destroy(arrayHandle);
         }
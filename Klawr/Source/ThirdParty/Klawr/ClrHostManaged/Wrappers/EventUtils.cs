@@ -0,0 +1,94 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+using Klawr.ClrHost.Managed.SafeHandles;
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Klawr.ClrHost.Managed{
+    /// <summary>
+    /// Something native events can be dispatched to.
+    /// </summary>
+    internal interface INativeEventBinding{
+        void Invoke(IntPtr args, int numArgs);
+    }
+
+    /// <summary>
+    /// Binds managed handlers to the dynamic multicast delegates of native UObject instances.
+    /// </summary>
+    /// <remarks>
+    /// All the bindings in an app domain are routed through a single native trampoline object, 
+    /// which calls the one dispatch function below with the ID of the binding that fired. Events 
+    /// are bound and broadcast on the game thread so the bindings aren't synchronized.
+    /// </remarks>
+    internal class EventUtils{
+        private static EventUtilsProxy _proxy;
+        // native code holds on to a pointer to this delegate, so it must be kept alive
+        private static readonly EventUtilsProxy.DispatchEventAction _dispatch = Dispatch;
+        private static readonly IntPtr _dispatchFunction = Marshal.GetFunctionPointerForDelegate(_dispatch);
+        private static readonly Dictionary<int, INativeEventBinding> _bindings = new Dictionary<int, INativeEventBinding>();
+
+        internal EventUtils(ref EventUtilsProxy proxy){
+            _proxy = proxy;
+        }
+
+        /// <summary>
+        /// Bind a multicast delegate property of a native object.
+        /// </summary>
+        /// <returns>ID of the binding, or zero if the binding failed.</returns>
+        internal static int Bind(UObjectHandle sourceObject, string delegateName, INativeEventBinding binding){
+            if (_proxy.BindEvent == null){
+                return 0;
+            }
+            // the object may have been created in another app domain, but the binding (and the
+            // dispatch function it calls) belongs to this one
+            var bindingID = _proxy.BindEvent(
+                AppDomain.CurrentDomain.Id, sourceObject, delegateName, _dispatchFunction
+            );
+            if (bindingID != 0){
+                _bindings[bindingID] = binding;
+            }
+            return bindingID;
+        }
+
+        internal static void Unbind(int bindingID){
+            if (_bindings.Remove(bindingID)){
+                _proxy.UnbindEvent?.Invoke(bindingID);
+            }
+        }
+
+        private static void Dispatch(int bindingID, IntPtr args, int numArgs){
+            INativeEventBinding binding;
+            if (!_bindings.TryGetValue(bindingID, out binding)){
+                return;
+            }
+            // exceptions must not propagate into native code
+            try{
+                binding.Invoke(args, numArgs);
+            } catch (Exception except){
+                LogUtils.LogError(except.ToString());
+            }
+        }
+    }
+}
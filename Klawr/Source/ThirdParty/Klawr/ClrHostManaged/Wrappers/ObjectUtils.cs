@@ -52,5 +52,13 @@ namespace Klawr.ClrHost.Managed{
         public static void ReleaseObject(IntPtr nativeObject){
             _proxy.RemoveObjectRef?.Invoke(nativeObject);
         }
+
+        /// <summary>
+        /// Add a reference to a native UObject instance, it must be released with ReleaseObject().
+        /// </summary>
+        /// <param name="nativeObject">Pointer to a native UObject instance.</param>
+        public static void AddObjectRef(IntPtr nativeObject){
+            _proxy.AddObjectRef(nativeObject);
+        }
     }
 }
\ No newline at end of file
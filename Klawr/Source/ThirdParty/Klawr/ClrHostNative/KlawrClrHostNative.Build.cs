@@ -75,5 +75,23 @@ public class KlawrClrHostNative : ModuleRules
             Path.Combine(binariesDir, hostAssemblyPDB),
             bOverwrite
         );
+
+        // copy the script compiler server (and the compiler assemblies it depends on) if it was
+        // built, the editor falls back to building the game scripts with MSBuild without it
+        string compilerSourceDir = Path.Combine(basePath, Path.Combine("ScriptCompiler", "bin", configuration));
+        Utils.CollapseRelativeDirectories(ref compilerSourceDir);
+        if (Directory.Exists(compilerSourceDir))
+        {
+            string compilerDestDir = Path.Combine(binariesDir, "KlawrScriptCompiler");
+            Directory.CreateDirectory(compilerDestDir);
+            foreach (string sourceFilename in Directory.GetFiles(compilerSourceDir))
+            {
+                File.Copy(
+                    sourceFilename, 
+                    Path.Combine(compilerDestDir, Path.GetFileName(sourceFilename)), 
+                    bOverwrite
+                );
+            }
+        }
     }
 }
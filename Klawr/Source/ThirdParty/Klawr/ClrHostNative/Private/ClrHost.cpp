@@ -32,26 +32,6 @@
 
 namespace {
 	 
-SAFEARRAY* CreateSafeArrayOfWrapperFunctions(void** wrapperFunctions, int numFunctions)
-{
-	SAFEARRAY* safeArray = SafeArrayCreateVector(VT_I8, 0, numFunctions);
-	if (safeArray)
-	{
-		LONGLONG* safeArrayData = nullptr;
-		HRESULT hr = SafeArrayAccessData(safeArray, (void**)&safeArrayData);
-		if (SUCCEEDED(hr))
-		{
-			for (auto i = 0; i < numFunctions; ++i)
-			{
-				safeArrayData[i] = reinterpret_cast<LONGLONG>(wrapperFunctions[i]);
-			}
-			hr = SafeArrayUnaccessData(safeArray);
-			assert(SUCCEEDED(hr));
-		}
-	}
-	return safeArray;
-}
-
 /** 
  * @brief Convert a one-dimensional COM SAFEARRAY to a std::vector.
  * This only works if TSafeArrayElement can be implicitly converted to TVectorElement.
@@ -224,6 +204,11 @@ struct ProxySizeChecks
 		"ArrayUtilsProxy doesn't have the same size in native and managed code!"
 	);
 
+	static_assert(
+		sizeof(Klawr::Managed::EventUtilsProxy) == sizeof(EventUtilsProxy),
+		"EventUtilsProxy doesn't have the same size in native and managed code!"
+	);
+
 	static_assert(
 		sizeof(Klawr::Managed::ScriptComponentProxy) == sizeof(ScriptComponentProxy),
 		"ScriptComponentProxy doesn't have the same size in native and managed code!"
@@ -314,6 +299,23 @@ void __cdecl ClrHost::Shutdown()
 		_hostControl = nullptr;
 	}
 }
+
+void __cdecl ClrHost::AddClasses(const NativeClassWrappers* classes, int numClasses)
+{
+	_nativeClassIndex.reserve(_nativeClassIndex.size() + numClasses);
+	for (auto i = 0; i < numClasses; ++i)
+	{
+		const auto& classWrappers = classes[i];
+		_nativeClassIndex.push_back({
+			classWrappers.ClassName, static_cast<int>(_nativeFunctionTable.size()), 
+			classWrappers.NumFunctions
+		});
+		_nativeFunctionTable.insert(
+			_nativeFunctionTable.end(), classWrappers.WrapperFunctions, 
+			classWrappers.WrapperFunctions + classWrappers.NumFunctions
+		);
+	}
+}
 bool __cdecl ClrHost::CreateEngineAppDomain(int& outAppDomainID)
 {
 	outAppDomainID = _hostControl->GetDefaultAppDomainManager()->CreateEngineAppDomain(
@@ -329,17 +331,15 @@ bool __cdecl ClrHost::InitEngineAppDomain(int appDomainID, const NativeUtils& na
 	{
 		// pass all the native wrapper functions to the managed side of the CLR host so that they 
 		// can be hooked up to properties and methods of the generated C# wrapper classes (though 
-		// that will happen a bit later)
-		for (const auto& classWrapper : _classWrappers)
-		{
-			auto className = classWrapper.first.c_str();
-			auto& wrapperInfo = classWrapper.second;
-			auto safeArray = CreateSafeArrayOfWrapperFunctions(
-				wrapperInfo.functionPointers, wrapperInfo.numFunctions
-			);
-			HRESULT hr = appDomainManager->SetNativeFunctionPointers(className, safeArray);
-			assert(SUCCEEDED(hr));
-		}
+		// that will happen a bit later), the managed side reads the table and the class index in 
+		// place so they must remain unchanged for as long as the app domain exists
+		HRESULT hr = appDomainManager->SetNativeFunctionTable(
+			reinterpret_cast<__int64>(_nativeFunctionTable.data()), 
+			static_cast<int>(_nativeFunctionTable.size()),
+			reinterpret_cast<__int64>(_nativeClassIndex.data()), 
+			static_cast<int>(_nativeClassIndex.size())
+		);
+		assert(SUCCEEDED(hr));
 
 		// pass a few utility functions to the managed side
 		appDomainManager->BindUtils(
@@ -351,6 +351,9 @@ bool __cdecl ClrHost::InitEngineAppDomain(int appDomainID, const NativeUtils& na
 			),
 			reinterpret_cast<Klawr::Managed::ArrayUtilsProxy*>(
 				const_cast<ArrayUtilsProxy*>(&nativeUtils.Array)
+			),
+			reinterpret_cast<Klawr::Managed::EventUtilsProxy*>(
+				const_cast<EventUtilsProxy*>(&nativeUtils.Event)
 			)
 		);
 
@@ -358,6 +361,10 @@ bool __cdecl ClrHost::InitEngineAppDomain(int appDomainID, const NativeUtils& na
 		try
 		{
 			appDomainManager->LoadUnrealEngineWrapperAssembly();
+			// mismatched structs are reported by the managed side
+			appDomainManager->VerifyStructLayouts(
+				reinterpret_cast<__int64>(_structLayouts), _numStructLayouts
+			);
 			appDomainManager->LoadAssembly(_gameScriptsAssemblyName.c_str());
 		}
 		catch (_com_error& err)
@@ -431,6 +438,60 @@ void __cdecl ClrHost::DestroyScriptComponent(int appDomainID, __int64 instanceID
 	}
 }
 
+bool __cdecl ClrHost::SaveScriptComponentState(
+	int appDomainID, __int64 instanceID, std::vector<unsigned char>& state
+) const
+{
+	auto appDomainManager = _hostControl->GetEngineAppDomainManager(appDomainID);
+	if (!appDomainManager)
+	{
+		return false;
+	}
+
+	state.clear();
+	SAFEARRAY* safeArray = appDomainManager->SaveScriptComponentState(instanceID);
+	if (!safeArray)
+	{
+		return false;
+	}
+	SafeArrayToVector<unsigned char>(safeArray, state);
+	HRESULT hr = SafeArrayDestroy(safeArray);
+	assert(SUCCEEDED(hr));
+	return !state.empty();
+}
+
+bool __cdecl ClrHost::RestoreScriptComponentState(
+	int appDomainID, __int64 instanceID, const unsigned char* state, int stateSize
+) const
+{
+	auto appDomainManager = _hostControl->GetEngineAppDomainManager(appDomainID);
+	if (!appDomainManager || !state || (stateSize <= 0))
+	{
+		return false;
+	}
+
+	SAFEARRAY* safeArray = SafeArrayCreateVector(VT_UI1, 0, stateSize);
+	if (!safeArray)
+	{
+		return false;
+	}
+	void* safeArrayData = nullptr;
+	HRESULT hr = SafeArrayAccessData(safeArray, &safeArrayData);
+	if (FAILED(hr))
+	{
+		SafeArrayDestroy(safeArray);
+		return false;
+	}
+	memcpy(safeArrayData, state, stateSize);
+	hr = SafeArrayUnaccessData(safeArray);
+	assert(SUCCEEDED(hr));
+
+	bool restored = (appDomainManager->RestoreScriptComponentState(instanceID, safeArray) & 1) == 1;
+	hr = SafeArrayDestroy(safeArray);
+	assert(SUCCEEDED(hr));
+	return restored;
+}
+
 void __cdecl ClrHost::GetScriptComponentTypes(int appDomainID, std::vector<tstring>& types) const
 {
 	auto appDomainManager = _hostControl->GetEngineAppDomainManager(appDomainID);
@@ -444,6 +505,18 @@ void __cdecl ClrHost::GetScriptComponentTypes(int appDomainID, std::vector<tstri
 	}
 }
 
+bool __cdecl ClrHost::WriteBindingUsage(int appDomainID, const TCHAR* usageFilename) const
+{
+	auto appDomainManager = _hostControl->GetEngineAppDomainManager(appDomainID);
+	if (appDomainManager)
+	{
+		return (appDomainManager->WriteBindingUsage(
+			_gameScriptsAssemblyName.c_str(), usageFilename
+		) & 1) == 1;
+	}
+	return false;
+}
+
 bool __cdecl ClrHost::GetScriptComponentPropertyIsAdvancedDisplay(int appDomainID, const TCHAR* typeName, const TCHAR* propertyName) const
 {
 	auto appDomainManager = _hostControl->GetEngineAppDomainManager(appDomainID);
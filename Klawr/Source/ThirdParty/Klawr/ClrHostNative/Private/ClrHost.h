@@ -26,7 +26,7 @@
 #include "KlawrClrHostPCH.h"
 #include "KlawrClrHost.h"
 #include <comdef.h> // for _COM_SMARTPTR_TYPEDEF
-#include <map>
+#include <vector>
 #include <string>
 
 _COM_SMARTPTR_TYPEDEF(ICLRRuntimeHost, IID_ICLRRuntimeHost); // for ICLRRuntimeHostPtr
@@ -45,9 +45,12 @@ public: // IClrHost interface
 	virtual bool DestroyEngineAppDomain(int appDomainID);
 	virtual void Shutdown() override;
 
-	virtual void AddClass(const TCHAR* className, void** wrapperFunctions, int numFunctions) override
+	virtual void AddClasses(const NativeClassWrappers* classes, int numClasses) override;
+
+	virtual void SetStructLayouts(const NativeStructFieldLayout* layouts, int numLayouts) override
 	{
-		_classWrappers[className] = { wrapperFunctions, numFunctions };
+		_structLayouts = layouts;
+		_numStructLayouts = numLayouts;
 	}
 
 	virtual bool CreateScriptObject(
@@ -62,7 +65,16 @@ public: // IClrHost interface
 
 	virtual void DestroyScriptComponent(int appDomainID, __int64 instanceID) override;
 
+	virtual bool SaveScriptComponentState(
+		int appDomainID, __int64 instanceID, std::vector<unsigned char>& state
+	) const override;
+
+	virtual bool RestoreScriptComponentState(
+		int appDomainID, __int64 instanceID, const unsigned char* state, int stateSize
+	) const override;
+
 	virtual void GetScriptComponentTypes(int appDomainID, std::vector<tstring>& types) const override;
+	virtual bool WriteBindingUsage(int appDomainID, const TCHAR* usageFilename) const override;
 
 	virtual bool GetScriptComponentPropertyIsAdvancedDisplay(int appDomainID, const TCHAR* typeName, const TCHAR* propertyName) const override;
 	virtual bool GetScriptComponentPropertyIsSaveGame(int appDomainID, const TCHAR* typeName, const TCHAR* propertyName) const override;
@@ -88,19 +100,31 @@ public: // IClrHost interface
 
 	virtual const TCHAR* GetAssemblyInfo(int appDomainID) const override;
 public:
-	ClrHost() : _hostControl(nullptr) {}
+	ClrHost() : _hostControl(nullptr), _structLayouts(nullptr), _numStructLayouts(0) {}
 	void CreateSafeArrayBool(std::vector<bool>* bools, SAFEARRAY** boolsArray) const;
 	void CreateSafeArrayString(std::vector<const TCHAR*>* strings, SAFEARRAY** stringsArray) const;
 private:
 	class ClrHostControl* _hostControl;
 	ICLRRuntimeHostPtr _runtimeHost;
 
-	struct ClassWrapperInfo
+	/** 
+	 * @brief Location of the wrapper functions of a single class in the native function table.
+	 * @note This struct has a managed counterpart (NativeFunctionTable.ClassEntry) defined in 
+	 *       Klawr.ClrHost.Managed, the size and layout of the two structures must remain identical.
+	 */
+	struct NativeFunctionTableEntry
 	{
-		void** functionPointers;
+		const TCHAR* className;
+		int offset;
 		int numFunctions;
 	};
-	std::map<tstring, ClassWrapperInfo> _classWrappers;
+	// the wrapper functions of all classes, stored contiguously
+	std::vector<void*> _nativeFunctionTable;
+	// the location of each class in _nativeFunctionTable
+	std::vector<NativeFunctionTableEntry> _nativeClassIndex;
+	// the native layouts the generated C# structs are checked against
+	const NativeStructFieldLayout* _structLayouts;
+	int _numStructLayouts;
 	tstring _engineAppDomainAppBase;
 	tstring _gameScriptsAssemblyName;
 };
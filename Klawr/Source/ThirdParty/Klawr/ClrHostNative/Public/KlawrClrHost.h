@@ -46,7 +46,9 @@ namespace Klawr {
 	{
 		enum VariantArgType_t
 		{
-			Int, Float, Bool, String, Object
+			Int, Float, Bool, String, Object, 
+			/** Pointer to a struct, only valid for the duration of the call it was passed to. */
+			Struct
 		};
 	}
 
@@ -128,6 +130,36 @@ struct ScriptComponentProxy
 	TickComponentAction TickComponent;
 };
 
+/** The native wrapper functions of a scriptable C++ class. */
+struct NativeClassWrappers
+{
+	/** The name of a scriptable C++ class (including prefix, e.g. AActor). */
+	const TCHAR* ClassName;
+	/** Array of pointers to native wrapper functions for the class. */
+	void** WrapperFunctions;
+	/** Number of elements in the WrapperFunctions array. */
+	int NumFunctions;
+};
+
+/**
+ * @brief The native layout of a field of a struct that has a generated C# counterpart.
+ * @note This struct has a managed counterpart (StructLayoutVerifier.FieldLayout) defined in 
+ *       Klawr.ClrHost.Managed, the size and layout of the two structures must remain identical.
+ */
+struct NativeStructFieldLayout
+{
+	/** Name of the C# struct (including prefix, e.g. FHitResult). */
+	const TCHAR* StructName;
+	/** Name of the C# field, or null if this entry only describes the size of the struct. */
+	const TCHAR* FieldName;
+	/** Size of the native struct. */
+	int StructSize;
+	/** Offset of the field from the start of the native struct. */
+	int FieldOffset;
+	/** Mask of the bit within the field if the field is a bitfield, zero otherwise. */
+	int FieldMask;
+};
+
 /** This public interface can be used to pass native wrapper functions to the CLR host. */
 class IClrHost
 {
@@ -171,12 +203,29 @@ public:
 	virtual void Shutdown() = 0;
 
 	/** 
-	 * @brief Store native wrapper functions for the given class.
-	 * @param className The name of a scriptable C++ class (including prefix, e.g. AActor).
-	 * @param wrapperFunctions Array of pointers to native wrapper functions for the given class.
-	 * @param numFunctions Number of elements in the wrapperFunctions array.
+	 * @brief Store native wrapper functions for the given classes.
+	 *
+	 * The wrapper functions are appended to a single table that's passed to each engine app 
+	 * domain when it's initialized, so all classes must be added before the first engine app
+	 * domain is initialized.
+	 *
+	 * @param classes Array of native wrapper functions grouped by class, the class names must 
+	 *                remain valid until the CLR host is shutdown.
+	 * @param numClasses Number of elements in the classes array.
+	 */
+	virtual void AddClasses(const NativeClassWrappers* classes, int numClasses) = 0;
+
+	/**
+	 * @brief Store the native layouts of the structs that have generated C# counterparts.
+	 *
+	 * The C# structs are checked against these layouts whenever an engine app domain is 
+	 * initialized, structs that don't match are reported and must not be passed by pointer.
+	 *
+	 * @param layouts Array of field layouts, the fields of each struct must be stored 
+	 *                contiguously. The array must remain valid until the CLR host is shutdown.
+	 * @param numLayouts Number of elements in the layouts array.
 	 */
-	virtual void AddClass(const TCHAR* className, void** wrapperFunctions, int numFunctions) = 0;
+	virtual void SetStructLayouts(const NativeStructFieldLayout* layouts, int numLayouts) = 0;
 
 	virtual bool CreateScriptObject(
 		int appDomainID, const TCHAR* className, class UObject* owner, ScriptObjectInstanceInfo& info
@@ -200,6 +249,37 @@ public:
 
 	virtual void DestroyScriptComponent(int appDomainID, __int64 instanceID) = 0;
 
+	/**
+	 * @brief Save the fields of a managed UKlawrScriptComponent instance.
+	 *
+	 * The saved state can be restored into an instance of the same managed type in another engine 
+	 * app domain, this is used to preserve the state of script components when the game scripts 
+	 * are reloaded.
+	 *
+	 * @param instanceID The ID of the managed script component instance.
+	 * @param state Vector to be filled in with the saved state.
+	 * @return true if the state was saved successfully, false otherwise
+	 */
+	virtual bool SaveScriptComponentState(
+		int appDomainID, __int64 instanceID, std::vector<unsigned char>& state
+	) const = 0;
+
+	/**
+	 * @brief Restore the fields of a managed UKlawrScriptComponent instance from a state 
+	 *        previously saved by SaveScriptComponentState().
+	 *
+	 * Fields are matched up by name and type, any fields in the state that no longer exist or 
+	 * changed type are skipped.
+	 *
+	 * @param instanceID The ID of the managed script component instance.
+	 * @param state The saved state.
+	 * @param stateSize Number of bytes in the saved state.
+	 * @return true if the state was restored, false if it was saved from a different managed type
+	 */
+	virtual bool RestoreScriptComponentState(
+		int appDomainID, __int64 instanceID, const unsigned char* state, int stateSize
+	) const = 0;
+
 	/**
 	 * @brief Get the fully qualified names (including namespace) of all currently loaded managed 
 	 *        types derived from UKlawrScriptComponent.
@@ -207,6 +287,17 @@ public:
 	 */
 	virtual void GetScriptComponentTypes(int appDomainID, std::vector<tstring>& types) const = 0;
 
+	/**
+	 * @brief Write the members of the generated C# wrapper classes that are referenced by the game
+	 *        scripts assembly to a file, one NativeClassName.MemberName per line.
+	 *
+	 * The code generator can use this file to skip generating bindings that aren't used.
+	 *
+	 * @param usageFilename The file to write to, it will be overwritten if it exists.
+	 * @return true if the file was written successfully, false otherwise
+	 */
+	virtual bool WriteBindingUsage(int appDomainID, const TCHAR* usageFilename) const = 0;
+
 	virtual bool GetScriptComponentPropertyIsAdvancedDisplay(int appDomainID, const TCHAR* typeName, const TCHAR* propertyName) const = 0;
 	virtual bool GetScriptComponentPropertyIsSaveGame(int appDomainID, const TCHAR* typeName, const TCHAR* propertyName) const = 0;
 
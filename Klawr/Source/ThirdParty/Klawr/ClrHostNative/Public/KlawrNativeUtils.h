@@ -27,6 +27,8 @@ struct FScriptName;
 
 namespace Klawr {
 
+struct VariantArg;
+
 /** 
  * @brief Contains pointers to native UObject and UClass utility functions.
  *
@@ -42,6 +44,7 @@ struct ObjectUtilsProxy
 	typedef const TCHAR* (*GetClassNameFunc)(class UClass* nativeClass);
 	typedef unsigned char (*IsClassChildOfFunc)(class UClass* derivedClass, class UClass* baseClass);
 	typedef void (*RemoveObjectRefAction)(class UObject* nativeObject);
+	typedef void (*AddObjectRefAction)(class UObject* nativeObject);
 
 	/** Get a UClass instance matching the given name (excluding U/A prefix). */
 	GetClassByNameFunc GetClassByName;
@@ -51,6 +54,8 @@ struct ObjectUtilsProxy
 	IsClassChildOfFunc IsClassChildOf;
 	/** Called when a managed reference to a UObject instance is disposed. */
 	RemoveObjectRefAction RemoveObjectRef;
+	/** Called when managed code takes a new reference to a UObject instance it was passed. */
+	AddObjectRefAction AddObjectRef;
 };
 
 /** 
@@ -118,17 +123,66 @@ struct ArrayUtilsProxy
 	int32 (*FindString)(FArrayHelper* arrayHelper, const TCHAR* item);
 	int32 (*FindName)(FArrayHelper* arrayHelper, FScriptName item);
 	int32 (*FindObject)(FArrayHelper* arrayHelper, class UObject* item);
+	int32 (*CountUInt8)(FArrayHelper* arrayHelper, uint8 item);
+	int32 (*CountInt16)(FArrayHelper* arrayHelper, int16 item);
+	int32 (*CountInt32)(FArrayHelper* arrayHelper, int32 item);
+	int32 (*CountInt64)(FArrayHelper* arrayHelper, int64 item);
+	int32 (*FindAnyUInt8)(FArrayHelper* arrayHelper, const uint8* items, int32 numItems);
+	int32 (*FindAnyInt16)(FArrayHelper* arrayHelper, const int16* items, int32 numItems);
+	int32 (*FindAnyInt32)(FArrayHelper* arrayHelper, const int32* items, int32 numItems);
+	int32 (*FindAnyInt64)(FArrayHelper* arrayHelper, const int64* items, int32 numItems);
 	void (*Insert)(FArrayHelper* arrayHelper, int32 index);
 	void (*RemoveAt)(FArrayHelper* arrayHelper, int32 index);
+	int32 (*GetElementSize)(FArrayHelper* arrayHelper);
+	unsigned char (*CopyToBuffer)(FArrayHelper* arrayHelper, int32 index, void* buffer, int32 count);
+	unsigned char (*CopyFromBuffer)(FArrayHelper* arrayHelper, int32 index, const void* buffer, int32 count);
+	void (*GetStrings)(FArrayHelper* arrayHelper, int32 index, const TCHAR** buffer, int32 count);
+	void (*GetNames)(FArrayHelper* arrayHelper, int32 index, FScriptName* buffer, int32 count);
+	void (*GetObjects)(FArrayHelper* arrayHelper, int32 index, class UObject** buffer, int32 count);
 	void (*Destroy)(FArrayHelper* arrayHelper);
 };
 
+/** 
+ * @brief Contains pointers to native functions that bind managed handlers to the dynamic 
+ *        multicast delegates (events) of native UObject instances.
+ *
+ * These native functions will be called by managed code.
+ *
+ * @note This struct has a managed counterpart by the same name defined in Klawr.ClrHost.Managed,
+ *       the managed counterpart is also exposed to native code via COM under the 
+ *       Klawr::Managed namespace (but it's hidden from clients of this library).
+ */
+struct EventUtilsProxy
+{
+	/** 
+	 * Called from native code whenever a bound event is broadcast, the arguments are only valid 
+	 * for the duration of the call.
+	 */
+	typedef void (*DispatchEventAction)(int bindingID, const VariantArg* args, int numArgs);
+	typedef int (*BindEventFunc)(
+		int appDomainID, class UObject* sourceObject, const TCHAR* delegateName, 
+		DispatchEventAction dispatch
+	);
+	typedef void (*UnbindEventAction)(int bindingID);
+
+	/** 
+	 * Bind the given dispatch function to a multicast delegate property of an object, returns the
+	 * ID of the binding (passed to the dispatch function), or zero if the binding failed.
+	 * The binding belongs to the app domain identified by appDomainID (the one making the call),
+	 * which may differ from the app domain the object was created in.
+	 */
+	BindEventFunc BindEvent;
+	/** Remove a binding created by BindEvent. */
+	UnbindEventAction UnbindEvent;
+};
+
 /** Encapsulates native utility functions that are exported to managed code. */
 struct NativeUtils
 {
 	ObjectUtilsProxy Object;
 	LogUtilsProxy Log;
 	ArrayUtilsProxy Array;
+	EventUtilsProxy Event;
 };
 
 } // namespace Klawr
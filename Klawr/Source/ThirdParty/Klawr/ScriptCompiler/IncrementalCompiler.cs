@@ -0,0 +1,275 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.Text;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace Klawr.ScriptCompiler{
+    /// <summary>
+    /// Compiles a game scripts project, reusing everything that didn't change since the last build.
+    /// </summary>
+    /// <remarks>
+    /// The project file is only reloaded when it's modified, each source file is only reparsed when
+    /// its time stamp changes, and each referenced assembly is only reloaded when its time stamp 
+    /// changes. The changes are applied to the compilation from the previous build so the compiler
+    /// can reuse the declarations of the unchanged syntax trees.
+    /// </remarks>
+    internal sealed class IncrementalCompiler{
+        private sealed class CachedFile<T>{
+            public DateTime TimeStamp;
+            public T Value;
+        }
+
+        private readonly string _projectFilename;
+        private DateTime _projectTimeStamp;
+        private ScriptProject _project;
+        private CSharpParseOptions _parseOptions;
+        private Platform _platform;
+        private CSharpCompilation _compilation;
+        private readonly Dictionary<string, CachedFile<SyntaxTree>> _syntaxTrees =
+            new Dictionary<string, CachedFile<SyntaxTree>>(StringComparer.OrdinalIgnoreCase);
+        private readonly Dictionary<string, CachedFile<MetadataReference>> _references =
+            new Dictionary<string, CachedFile<MetadataReference>>(StringComparer.OrdinalIgnoreCase);
+
+        public IncrementalCompiler(string projectFilename){
+            _projectFilename = projectFilename;
+        }
+
+        /// <summary>
+        /// Load and parse the project without emitting anything, so that the first build doesn't 
+        /// have to pay for loading the compiler.
+        /// </summary>
+        public void Prepare(TextWriter output){
+            try{
+                if (File.Exists(_projectFilename) && Update(output)){
+                    _compilation.GetDeclarationDiagnostics();
+                }
+            } catch (Exception e){
+                // the next build will report the problem if it persists
+                output.WriteLine("warning: Failed to prepare " + _projectFilename + ": " + e.Message);
+            }
+        }
+
+        /// <summary>
+        /// Build the project, the assembly and pdb are only written out if the build succeeds.
+        /// </summary>
+        /// <returns>true if the build succeeded, false otherwise</returns>
+        public bool Build(TextWriter output){
+            var stopwatch = Stopwatch.StartNew();
+            int numParsed;
+            if (!Update(output, out numParsed)){
+                return false;
+            }
+
+            using (var assemblyStream = new MemoryStream())
+            using (var pdbStream = new MemoryStream()){
+                var result = _compilation.Emit(assemblyStream, pdbStream);
+                foreach (var diagnostic in result.Diagnostics){
+                    if ((diagnostic.Severity >= DiagnosticSeverity.Warning) && !diagnostic.IsSuppressed){
+                        // same format as MSBuild: file(line,column): error CS0000: message
+                        output.WriteLine(CSharpDiagnosticFormatter.Instance.Format(diagnostic, CultureInfo.InvariantCulture));
+                    }
+                }
+                if (!result.Success){
+                    return false;
+                }
+
+                var assemblyFilename = _project.OutputAssemblyFilename;
+                Directory.CreateDirectory(Path.GetDirectoryName(assemblyFilename));
+                File.WriteAllBytes(assemblyFilename, assemblyStream.ToArray());
+                File.WriteAllBytes(Path.ChangeExtension(assemblyFilename, ".pdb"), pdbStream.ToArray());
+                output.WriteLine(string.Format(
+                    "{0} -> {1} ({2} of {3} source file(s) parsed, {4} ms)",
+                    _project.AssemblyName, assemblyFilename, numParsed, _syntaxTrees.Count,
+                    stopwatch.ElapsedMilliseconds
+                ));
+            }
+            return true;
+        }
+
+        private bool Update(TextWriter output){
+            int numParsed;
+            return Update(output, out numParsed);
+        }
+
+        /// <summary>
+        /// Bring the compilation up to date with the project and the files on disk.
+        /// </summary>
+        /// <param name="numParsed">Number of source files that had to be (re)parsed.</param>
+        /// <returns>false if the compilation couldn't be updated, the errors are written to output</returns>
+        private bool Update(TextWriter output, out int numParsed){
+            numParsed = 0;
+            var projectTimeStamp = File.GetLastWriteTimeUtc(_projectFilename);
+            if ((_project == null) || (projectTimeStamp != _projectTimeStamp)){
+                var project = ScriptProject.Load(_projectFilename);
+                LanguageVersion languageVersion;
+                if (!TryParseLanguageVersion(project.LanguageVersion, out languageVersion)){
+                    output.WriteLine(string.Format(
+                        "{0}: error CS1617: Invalid option '{1}' for /langversion; must be ISO-1, ISO-2, 3, 4, 5, 6 or Default",
+                        _projectFilename, project.LanguageVersion
+                    ));
+                    return false;
+                }
+                Platform platform;
+                if (!Enum.TryParse(project.PlatformTarget, true, out platform)){
+                    output.WriteLine(string.Format(
+                        "{0}: error CS1672: Invalid option '{1}' for /platform; must be anycpu, x86, Itanium, arm, anycpu32bitpreferred or x64",
+                        _projectFilename, project.PlatformTarget
+                    ));
+                    return false;
+                }
+                _project = project;
+                _projectTimeStamp = projectTimeStamp;
+                _platform = platform;
+                var parseOptions = new CSharpParseOptions(
+                    languageVersion, DocumentationMode.None, SourceCodeKind.Regular, 
+                    _project.DefineConstants
+                );
+                if ((_parseOptions == null) || 
+                    (_parseOptions.LanguageVersion != parseOptions.LanguageVersion) ||
+                    !_parseOptions.PreprocessorSymbolNames.SequenceEqual(parseOptions.PreprocessorSymbolNames)){
+                    // the language version and the preprocessor symbols affect parsing, so 
+                    // everything has to be reparsed
+                    _syntaxTrees.Clear();
+                    _parseOptions = parseOptions;
+                }
+                // the compilation options may have changed as well
+                _compilation = null;
+            }
+
+            var references = new List<MetadataReference>();
+            foreach (var referenceFilename in _project.References){
+                if (!File.Exists(referenceFilename)){
+                    output.WriteLine(string.Format(
+                        "{0}: error CS0006: Metadata file '{1}' could not be found", 
+                        _projectFilename, referenceFilename
+                    ));
+                    return false;
+                }
+                references.Add(GetCachedFile(_references, referenceFilename, 
+                    filename => MetadataReference.CreateFromFile(filename)
+                ));
+            }
+
+            var syntaxTrees = new List<SyntaxTree>();
+            foreach (var sourceFilename in _project.SourceFiles){
+                if (!File.Exists(sourceFilename)){
+                    output.WriteLine(string.Format(
+                        "{0}: error CS2001: Source file '{1}' could not be found", 
+                        _projectFilename, sourceFilename
+                    ));
+                    return false;
+                }
+                syntaxTrees.Add(GetCachedFile(_syntaxTrees, sourceFilename, filename => {
+                    ++numParsed;
+                    return ParseSourceFile(filename);
+                }));
+            }
+            // forget the files that were removed from the project
+            foreach (var filename in _syntaxTrees.Keys.Except(_project.SourceFiles, StringComparer.OrdinalIgnoreCase).ToList()){
+                _syntaxTrees.Remove(filename);
+            }
+
+            if (_compilation == null){
+                _compilation = CSharpCompilation.Create(
+                    _project.AssemblyName, syntaxTrees, references, 
+                    new CSharpCompilationOptions(
+                        OutputKind.DynamicallyLinkedLibrary,
+                        optimizationLevel: _project.Optimize ? OptimizationLevel.Release : OptimizationLevel.Debug,
+                        allowUnsafe: _project.AllowUnsafeBlocks,
+                        platform: _platform,
+                        warningLevel: _project.WarningLevel
+                    )
+                );
+                return true;
+            }
+
+            // only the changed trees are swapped out so the rest of the compilation can be reused
+            var oldTrees = new HashSet<SyntaxTree>(_compilation.SyntaxTrees);
+            var newTrees = new HashSet<SyntaxTree>(syntaxTrees);
+            var compilation = _compilation
+                .RemoveSyntaxTrees(oldTrees.Where(tree => !newTrees.Contains(tree)))
+                .AddSyntaxTrees(syntaxTrees.Where(tree => !oldTrees.Contains(tree)));
+            if (!compilation.References.SequenceEqual(references)){
+                compilation = compilation.WithReferences(references);
+            }
+            _compilation = compilation;
+            return true;
+        }
+
+        /// <summary>
+        /// Convert the value of the LangVersion property to the version the compiler should use,
+        /// only the versions this build of the compiler supports are accepted.
+        /// </summary>
+        private static bool TryParseLanguageVersion(string langVersion, out LanguageVersion languageVersion){
+            switch (langVersion.ToLowerInvariant()){
+                case "default":
+                case "latest":
+                    languageVersion = LanguageVersion.CSharp6;
+                    return true;
+                case "iso-1":
+                    languageVersion = LanguageVersion.CSharp1;
+                    return true;
+                case "iso-2":
+                    languageVersion = LanguageVersion.CSharp2;
+                    return true;
+            }
+            int version;
+            if (int.TryParse(langVersion, NumberStyles.None, CultureInfo.InvariantCulture, out version) &&
+                Enum.TryParse("CSharp" + version, out languageVersion)){
+                return true;
+            }
+            languageVersion = LanguageVersion.CSharp6;
+            return false;
+        }
+
+        private SyntaxTree ParseSourceFile(string filename){
+            using (var stream = File.OpenRead(filename)){
+                var text = SourceText.From(stream);
+                return CSharpSyntaxTree.ParseText(text, _parseOptions, filename);
+            }
+        }
+
+        /// <summary>
+        /// Get the cached value for the given file, the value is recreated if the file was 
+        /// modified since it was cached.
+        /// </summary>
+        private static T GetCachedFile<T>(Dictionary<string, CachedFile<T>> cache, string filename, Func<string, T> create){
+            var timeStamp = File.GetLastWriteTimeUtc(filename);
+            CachedFile<T> cachedFile;
+            if (!cache.TryGetValue(filename, out cachedFile) || (cachedFile.TimeStamp != timeStamp)){
+                cachedFile = new CachedFile<T>{ TimeStamp = timeStamp, Value = create(filename) };
+                cache[filename] = cachedFile;
+            }
+            return cachedFile.Value;
+        }
+    }
+}
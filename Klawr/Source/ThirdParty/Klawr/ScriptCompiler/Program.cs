@@ -0,0 +1,82 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.IO;
+using System.Text;
+
+namespace Klawr.ScriptCompiler{
+    /// <summary>
+    /// A compiler server that keeps the C# compiler loaded (and the unchanged parts of the game
+    /// scripts project parsed) between builds.
+    /// </summary>
+    /// <remarks>
+    /// The editor starts the server with the path to the game scripts .csproj and sends it 
+    /// commands through stdin, one per line:
+    ///   build - Compile the project and write the assembly to the project's output path, the build
+    ///           output is written to stdout followed by BuildSucceeded or BuildFailed.
+    ///   exit  - Shut down the server.
+    /// The server also shuts down when stdin is closed (e.g. because the editor went away).
+    /// The command names and results must match FScriptCompilerServer in KlawrEditorPlugin.
+    /// </remarks>
+    internal static class Program{
+        internal const string BuildSucceeded = "@@KLAWR BUILD SUCCEEDED";
+        internal const string BuildFailed = "@@KLAWR BUILD FAILED";
+
+        private static int Main(string[] args){
+            if (args.Length != 1){
+                Console.Error.WriteLine("Usage: Klawr.ScriptCompiler <project.csproj>");
+                return 1;
+            }
+
+            // the editor reads the output line by line as it arrives
+            var output = new StreamWriter(Console.OpenStandardOutput(), new UTF8Encoding(false));
+            output.AutoFlush = true;
+            Console.SetOut(output);
+
+            var compiler = new IncrementalCompiler(Path.GetFullPath(args[0]));
+            // get the compiler warmed up before the first build request comes in
+            compiler.Prepare(output);
+
+            string command;
+            while ((command = Console.In.ReadLine()) != null){
+                command = command.Trim();
+                if (command == "exit"){
+                    break;
+                } else if (command == "build"){
+                    bool succeeded = false;
+                    try{
+                        succeeded = compiler.Build(output);
+                    } catch (Exception e){
+                        output.WriteLine("error: The script compiler server failed: " + e);
+                    }
+                    output.WriteLine(succeeded ? BuildSucceeded : BuildFailed);
+                } else if (command.Length > 0){
+                    output.WriteLine("warning: Unknown command " + command);
+                }
+            }
+            return 0;
+        }
+    }
+}
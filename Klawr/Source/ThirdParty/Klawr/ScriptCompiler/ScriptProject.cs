@@ -0,0 +1,191 @@
+﻿//
+// The MIT License (MIT)
+//
+// Copyright (c) 2014 Vadim Macagon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text.RegularExpressions;
+using System.Xml.Linq;
+
+namespace Klawr.ScriptCompiler{
+    /// <summary>
+    /// The build settings of a game scripts .csproj that the compiler server needs.
+    /// </summary>
+    /// <remarks>
+    /// Only the Release|x64 configuration is read since that's what the editor builds, and only 
+    /// the elements FGameProjectBuilder and the project template use are supported. Anything
+    /// fancier requires a proper MSBuild build.
+    /// </remarks>
+    internal sealed class ScriptProject{
+        private static readonly XNamespace MSBuild = "http://schemas.microsoft.com/developer/msbuild/2003";
+        private const string Configuration = "'Release|x64'";
+        private static readonly char[] Wildcards = { '*', '?' };
+
+        public string AssemblyName { get; private set; }
+        public string OutputAssemblyFilename { get; private set; }
+        public string[] DefineConstants { get; private set; }
+        public bool Optimize { get; private set; }
+        public bool AllowUnsafeBlocks { get; private set; }
+        public int WarningLevel { get; private set; }
+        /// <summary>The LangVersion property, "default" if it isn't set.</summary>
+        public string LanguageVersion { get; private set; }
+        /// <summary>The PlatformTarget property, "AnyCPU" if it isn't set.</summary>
+        public string PlatformTarget { get; private set; }
+        /// <summary>Full paths of the source files.</summary>
+        public List<string> SourceFiles { get; private set; }
+        /// <summary>Full paths of the referenced assemblies.</summary>
+        public List<string> References { get; private set; }
+
+        public static ScriptProject Load(string projectFilename){
+            var projectDir = Path.GetDirectoryName(projectFilename);
+            var root = XDocument.Load(projectFilename).Root;
+            var project = new ScriptProject();
+
+            // properties in unconditional groups apply to all configurations, later groups 
+            // override earlier ones just like they do in MSBuild
+            var properties = new Dictionary<string, string>();
+            foreach (var group in root.Elements(MSBuild + "PropertyGroup")){
+                var condition = (string)group.Attribute("Condition");
+                if ((condition != null) && !condition.Contains(Configuration)){
+                    continue;
+                }
+                foreach (var property in group.Elements()){
+                    properties[property.Name.LocalName] = property.Value.Trim();
+                }
+            }
+
+            project.AssemblyName = GetProperty(properties, "AssemblyName", Path.GetFileNameWithoutExtension(projectFilename));
+            var outputPath = GetProperty(properties, "OutputPath", "bin");
+            project.OutputAssemblyFilename = Path.GetFullPath(
+                Path.Combine(projectDir, outputPath, project.AssemblyName + ".dll")
+            );
+            project.DefineConstants = GetProperty(properties, "DefineConstants", "")
+                .Split(new[] { ';', ',' }, StringSplitOptions.RemoveEmptyEntries)
+                .Select(symbol => symbol.Trim())
+                .ToArray();
+            project.Optimize = string.Equals(GetProperty(properties, "Optimize", "false"), "true", StringComparison.OrdinalIgnoreCase);
+            project.AllowUnsafeBlocks = string.Equals(GetProperty(properties, "AllowUnsafeBlocks", "false"), "true", StringComparison.OrdinalIgnoreCase);
+            int warningLevel;
+            project.WarningLevel = int.TryParse(GetProperty(properties, "WarningLevel", "4"), out warningLevel) ? warningLevel : 4;
+            project.LanguageVersion = GetProperty(properties, "LangVersion", "default");
+            project.PlatformTarget = GetProperty(properties, "PlatformTarget", "AnyCPU");
+
+            project.SourceFiles = new List<string>();
+            var sourceFiles = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+            foreach (var item in root.Elements(MSBuild + "ItemGroup").Elements(MSBuild + "Compile")){
+                var excluded = new HashSet<string>(
+                    ExpandItemSpec(projectDir, (string)item.Attribute("Exclude")), StringComparer.OrdinalIgnoreCase
+                );
+                foreach (var sourceFile in ExpandItemSpec(projectDir, (string)item.Attribute("Include"))){
+                    if (!excluded.Contains(sourceFile) && sourceFiles.Add(sourceFile)){
+                        project.SourceFiles.Add(sourceFile);
+                    }
+                }
+            }
+
+            project.References = new List<string>();
+            project.References.Add(typeof(object).Assembly.Location); // mscorlib
+            foreach (var item in root.Elements(MSBuild + "ItemGroup").Elements(MSBuild + "Reference")){
+                var hintPath = (string)item.Element(MSBuild + "HintPath");
+                project.References.Add(
+                    (hintPath != null)
+                        ? Path.GetFullPath(Path.Combine(projectDir, hintPath))
+                        : GetFrameworkAssemblyFilename((string)item.Attribute("Include"))
+                );
+            }
+            return project;
+        }
+
+        /// <summary>
+        /// Get the full paths of the files an item Include (or Exclude) refers to.
+        /// </summary>
+        /// <remarks>
+        /// Like MSBuild the spec may contain several paths separated by semicolons, and each path
+        /// may contain the * and ? wildcards, as well as ** to match any number of directories.
+        /// Paths without wildcards are returned whether or not the file exists, so that missing
+        /// files are reported by the compiler.
+        /// </remarks>
+        private static IEnumerable<string> ExpandItemSpec(string projectDir, string itemSpec){
+            if (itemSpec == null){
+                yield break;
+            }
+            var paths = itemSpec.Split(new[] { ';' }, StringSplitOptions.RemoveEmptyEntries)
+                .Select(path => path.Trim().Replace('/', '\\'))
+                .Where(path => path.Length > 0);
+            foreach (var path in paths){
+                var wildcardIndex = path.IndexOfAny(Wildcards);
+                if (wildcardIndex < 0){
+                    yield return Path.GetFullPath(Path.Combine(projectDir, path));
+                    continue;
+                }
+                // everything before the directory containing the first wildcard is a plain path
+                var baseDirLength = path.LastIndexOf('\\', wildcardIndex) + 1;
+                var baseDir = Path.GetFullPath(Path.Combine(projectDir, path.Substring(0, baseDirLength)));
+                if (!Directory.Exists(baseDir)){
+                    continue;
+                }
+                var pattern = path.Substring(baseDirLength);
+                var matcher = new Regex(
+                    "^" + Regex.Escape(pattern)
+                        .Replace(@"\*\*\\", @"(.*\\)?")
+                        .Replace(@"\*", @"[^\\]*")
+                        .Replace(@"\?", @"[^\\]") + "$",
+                    RegexOptions.IgnoreCase
+                );
+                var searchOption = (pattern.IndexOf('\\') < 0) ? SearchOption.TopDirectoryOnly : SearchOption.AllDirectories;
+                var matches = Directory.EnumerateFiles(baseDir, "*", searchOption)
+                    .Where(filename => matcher.IsMatch(filename.Substring(baseDir.TrimEnd('\\').Length + 1)))
+                    .OrderBy(filename => filename, StringComparer.OrdinalIgnoreCase);
+                foreach (var filename in matches){
+                    yield return filename;
+                }
+            }
+        }
+
+        private static string GetProperty(Dictionary<string, string> properties, string name, string defaultValue){
+            string value;
+            return (properties.TryGetValue(name, out value) && (value.Length > 0)) ? value : defaultValue;
+        }
+
+        /// <summary>
+        /// Get the path to a framework assembly, the reference assemblies are used if they're 
+        /// installed, otherwise the assemblies of the runtime the server is running on.
+        /// </summary>
+        /// <param name="include">Assembly name, may be fully qualified.</param>
+        private static string GetFrameworkAssemblyFilename(string include){
+            var assemblyFilename = include.Split(',')[0].Trim() + ".dll";
+            var programFiles = Environment.GetFolderPath(Environment.SpecialFolder.ProgramFilesX86);
+            var referenceAssembliesDir = Path.Combine(
+                programFiles, @"Reference Assemblies\Microsoft\Framework\.NETFramework\v4.5"
+            );
+            var candidate = Path.Combine(referenceAssembliesDir, assemblyFilename);
+            if (File.Exists(candidate)){
+                return candidate;
+            }
+            return Path.Combine(RuntimeEnvironment.GetRuntimeDirectory(), assemblyFilename);
+        }
+    }
+}